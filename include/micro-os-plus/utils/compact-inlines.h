@@ -0,0 +1,127 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_COMPACT_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_COMPACT_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @details
+   * The list is walked from head to tail; each object is relocated
+   * into a new slot obtained from the arena, either with a bitwise copy
+   * or with its move constructor, then all its links nodes
+   * (the list one and the `Others`) are fixed with `relink_moved()`,
+   * so that their neighbours, in this list and in any other list,
+   * point to the new location.
+   *
+   * When the arena is exhausted, the walk stops; the list remains
+   * valid, with only the first objects relocated.
+   *
+   * To get the objects in consecutive addresses, the arena should
+   * be fresh, i.e. with no slots returned to its free list.
+   *
+   * The list statistics do not change, since the objects remain
+   * in the list.
+   */
+  template <auto... Others, class T, class N, N T::*MP, class L, class U,
+            class S, class A, class R>
+  std::size_t
+  compact (intrusive_list<T, N, MP, L, U, S>& list, A& arena, R&& release)
+  {
+    using iterator = typename intrusive_list<T, N, MP, L, U, S>::iterator;
+
+    static_assert (is_trivially_relocatable<U>::value
+                       || std::is_move_constructible<U>::value,
+                   "The objects must be move constructible, or declared "
+                   "trivially relocatable!");
+
+    std::size_t count = 0;
+    auto it = list.begin ();
+    while (it != list.end ())
+      {
+        U* old_object = &(*it);
+        U* new_object = arena.allocate ();
+        if (new_object == nullptr)
+          {
+            break;
+          }
+
+        if constexpr (is_trivially_relocatable<U>::value)
+          {
+            std::memcpy (static_cast<void*> (new_object),
+                         static_cast<const void*> (old_object), sizeof (U));
+          }
+        else
+          {
+            ::new (static_cast<void*> (new_object))
+                U (std::move (*old_object));
+          }
+
+        (new_object->*MP).relink_moved (&(old_object->*MP));
+        ((new_object->*Others).relink_moved (&(old_object->*Others)), ...);
+
+        if constexpr (!is_trivially_relocatable<U>::value)
+          {
+            // The old links are no longer referred; forget them,
+            // so that the destructor does not see them linked.
+            (old_object->*MP).initialize ();
+            ((old_object->*Others).initialize (), ...);
+            old_object->~U ();
+          }
+
+        // Continue from the new location, the old one is released.
+        it = iterator{ &(new_object->*MP) };
+        ++it;
+
+        release (old_object);
+        ++count;
+      }
+
+    return count;
+  }
+
+  // ==========================================================================
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_COMPACT_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Relocate the elements of an intrusive list into a contiguous
+ * arena, in list order, to restore the memory locality lost after
+ * long periods of insertions and removals.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_COMPACT_H_
+#define MICRO_OS_PLUS_UTILS_COMPACT_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-allocators
+   * @brief Trait to opt into relocation with a bitwise copy.
+   * @headerfile compact.h <micro-os-plus/utils/compact.h>
+   * @tparam U Type of the relocated objects.
+   *
+   * @details
+   * By default `compact()` relocates objects with their move
+   * constructor. Specialise this trait as `std::true_type` to promise
+   * that a `memcpy()` followed by `relink_moved()` on the links
+   * is a valid relocation for U, i.e. U has no pointers to itself
+   * (other than the links) and its destructor need not run for the
+   * old copy.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * template <>
+   * struct micro_os_plus::utils::is_trivially_relocatable<thread>
+   *     : std::true_type
+   * {
+   * };
+   * @endcode
+   */
+  template <class U>
+  struct is_trivially_relocatable : std::false_type
+  {
+  };
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-allocators
+   * @brief Relocate the list elements, in list order, into an arena.
+   * @headerfile compact.h <micro-os-plus/utils/compact.h>
+   * @tparam Others Pointers to the other links members of the objects,
+   *  (for the other lists they may belong to).
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam L Type of the list links node.
+   * @tparam U Type stored in the list, derived from T.
+   * @tparam S Type of the list statistics policy.
+   * @tparam A Type of the arena; it must have an `allocate()` method
+   *  returning storage for an object of type U, like `node_pool` or
+   *  `node_slab`.
+   * @tparam R Type of the callable object that releases the old storage.
+   * @param [in] list Reference to the list to compact.
+   * @param [in] arena Reference to the arena that provides the new storage.
+   * @param [in] release Callable object invoked with a pointer to the
+   *  old storage of each relocated object, to return it (for example
+   *  to the pool it came from); the old object is no longer alive.
+   * @return The number of relocated objects.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::compact<&thread::mutexes_links_> (
+   *     ready_list, new_pool, [&] (thread* t) { old_pool.deallocate (t); });
+   * @endcode
+   *
+   * @details
+   * The relocation contract:
+   * - if `is_trivially_relocatable<U>` is true, the object is copied
+   *   bitwise into the new slot and the old one is not destroyed;
+   * - otherwise U must be move constructible; the new object is
+   *   constructed with `U (std::move (old))`, the links take the
+   *   place of the old ones, and the old object is destroyed.
+   *
+   * In the second case the move constructor must not copy the links
+   * (they are neither copyable nor movable), but construct them
+   * unlinked; `compact()` links them in place of the old ones.
+   * The links are thus the only state that the move constructor
+   * does not need to carry.
+   */
+  template <auto... Others, class T, class N, N T::*MP, class L, class U,
+            class S, class A, class R>
+  std::size_t
+  compact (intrusive_list<T, N, MP, L, U, S>& list, A& arena, R&& release);
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "compact-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_COMPACT_H_
+
+// ----------------------------------------------------------------------------
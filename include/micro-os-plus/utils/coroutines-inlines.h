@@ -0,0 +1,482 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_COROUTINES_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_COROUTINES_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cpp_impl_coroutine)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  inline void
+  coroutine_waiter::resume (void)
+  {
+    handle_.resume ();
+  }
+
+  // ==========================================================================
+
+  template <class Lock>
+  async_event<Lock>::awaiter::awaiter (async_event& event) : event_{ event }
+  {
+  }
+
+  template <class Lock>
+  inline bool
+  async_event<Lock>::awaiter::await_ready (void) const
+  {
+    return event_.is_set ();
+  }
+
+  /**
+   * @details
+   * The state is checked again under the lock, since the event
+   * may have been set after `await_ready()`.
+   */
+  template <class Lock>
+  bool
+  async_event<Lock>::awaiter::await_suspend (std::coroutine_handle<> handle)
+  {
+    event_.lock_.lock ();
+    if (event_.set_.load (std::memory_order_relaxed))
+      {
+        event_.lock_.unlock ();
+        return false;
+      }
+
+    handle_ = handle;
+    event_.waiters_.link_tail (*this);
+    event_.lock_.unlock ();
+
+    return true;
+  }
+
+  template <class Lock>
+  constexpr void
+  async_event<Lock>::awaiter::await_resume (void) const
+  {
+  }
+
+  template <class Lock>
+  async_event<Lock>::async_event (bool set) : set_{ set }
+  {
+  }
+
+  template <class Lock>
+  async_event<Lock>::~async_event ()
+  {
+    assert (waiters_.empty ());
+  }
+
+  template <class Lock>
+  inline typename async_event<Lock>::awaiter
+  async_event<Lock>::operator co_await (void)
+  {
+    return awaiter{ *this };
+  }
+
+  /**
+   * @details
+   * The waiters are moved to a local list under the lock, and
+   * resumed in FIFO order after releasing it.
+   */
+  template <class Lock>
+  void
+  async_event<Lock>::set (void)
+  {
+    coroutine_wait_list ready;
+
+    lock_.lock ();
+    set_.store (true, std::memory_order_release);
+    ready.splice (ready.end (), waiters_, waiters_.begin (), waiters_.end ());
+    lock_.unlock ();
+
+    while (!ready.empty ())
+      {
+        ready.unlink_head ()->resume ();
+      }
+  }
+
+  template <class Lock>
+  void
+  async_event<Lock>::reset (void)
+  {
+    lock_.lock ();
+    set_.store (false, std::memory_order_relaxed);
+    lock_.unlock ();
+  }
+
+  template <class Lock>
+  inline bool
+  async_event<Lock>::is_set (void) const
+  {
+    return set_.load (std::memory_order_acquire);
+  }
+
+  // ==========================================================================
+
+  template <class Lock>
+  async_semaphore<Lock>::awaiter::awaiter (async_semaphore& semaphore)
+      : semaphore_{ semaphore }
+  {
+  }
+
+  template <class Lock>
+  constexpr bool
+  async_semaphore<Lock>::awaiter::await_ready (void) const
+  {
+    return false;
+  }
+
+  template <class Lock>
+  bool
+  async_semaphore<Lock>::awaiter::await_suspend (
+      std::coroutine_handle<> handle)
+  {
+    semaphore_.lock_.lock ();
+    if (semaphore_.count_ > 0)
+      {
+        --semaphore_.count_;
+        semaphore_.lock_.unlock ();
+        return false;
+      }
+
+    handle_ = handle;
+    semaphore_.waiters_.link_tail (*this);
+    semaphore_.lock_.unlock ();
+
+    return true;
+  }
+
+  template <class Lock>
+  constexpr void
+  async_semaphore<Lock>::awaiter::await_resume (void) const
+  {
+  }
+
+  template <class Lock>
+  async_semaphore<Lock>::async_semaphore (count_type count) : count_{ count }
+  {
+  }
+
+  template <class Lock>
+  async_semaphore<Lock>::~async_semaphore ()
+  {
+    assert (waiters_.empty ());
+  }
+
+  template <class Lock>
+  inline typename async_semaphore<Lock>::awaiter
+  async_semaphore<Lock>::acquire (void)
+  {
+    return awaiter{ *this };
+  }
+
+  template <class Lock>
+  bool
+  async_semaphore<Lock>::try_acquire (void)
+  {
+    bool result = false;
+
+    lock_.lock ();
+    if (count_ > 0)
+      {
+        --count_;
+        result = true;
+      }
+    lock_.unlock ();
+
+    return result;
+  }
+
+  template <class Lock>
+  void
+  async_semaphore<Lock>::release (void)
+  {
+    lock_.lock ();
+    coroutine_waiter* waiter = nullptr;
+    if (waiters_.empty ())
+      {
+        ++count_;
+      }
+    else
+      {
+        waiter = waiters_.unlink_head ();
+      }
+    lock_.unlock ();
+
+    if (waiter != nullptr)
+      {
+        waiter->resume ();
+      }
+  }
+
+  template <class Lock>
+  typename async_semaphore<Lock>::count_type
+  async_semaphore<Lock>::count (void)
+  {
+    lock_.lock ();
+    const count_type count = count_;
+    lock_.unlock ();
+
+    return count;
+  }
+
+  // ==========================================================================
+
+  template <class Lock>
+  async_mutex<Lock>::async_mutex () : semaphore_{ 1 }
+  {
+  }
+
+  template <class Lock>
+  async_mutex<Lock>::~async_mutex ()
+  {
+  }
+
+  template <class Lock>
+  inline typename async_mutex<Lock>::awaiter
+  async_mutex<Lock>::lock (void)
+  {
+    return semaphore_.acquire ();
+  }
+
+  template <class Lock>
+  inline bool
+  async_mutex<Lock>::try_lock (void)
+  {
+    return semaphore_.try_acquire ();
+  }
+
+  template <class Lock>
+  inline void
+  async_mutex<Lock>::unlock (void)
+  {
+    semaphore_.release ();
+  }
+
+  // ==========================================================================
+
+  template <class T, std::size_t Capacity, class Lock>
+  async_channel<T, Capacity, Lock>::send_awaiter::send_awaiter (
+      async_channel& channel, value_type&& value)
+      : channel_{ channel }, value_{ std::move (value) }
+  {
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  constexpr bool
+  async_channel<T, Capacity, Lock>::send_awaiter::await_ready (void) const
+  {
+    return false;
+  }
+
+  /**
+   * @details
+   * Receivers wait only while the buffer is empty, so a waiting
+   * receiver takes the value directly.
+   */
+  template <class T, std::size_t Capacity, class Lock>
+  bool
+  async_channel<T, Capacity, Lock>::send_awaiter::await_suspend (
+      std::coroutine_handle<> handle)
+  {
+    channel_.lock_.lock ();
+    if (!channel_.receivers_.empty ())
+      {
+        auto* receiver = static_cast<receive_awaiter*> (
+            channel_.receivers_.unlink_head ());
+        receiver->value_ = std::move (value_);
+        channel_.lock_.unlock ();
+        receiver->resume ();
+        return false;
+      }
+
+    if (channel_.count_ < Capacity)
+      {
+        channel_.push_ (std::move (value_));
+        channel_.lock_.unlock ();
+        return false;
+      }
+
+    handle_ = handle;
+    channel_.senders_.link_tail (*this);
+    channel_.lock_.unlock ();
+
+    return true;
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  constexpr void
+  async_channel<T, Capacity, Lock>::send_awaiter::await_resume (void) const
+  {
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  async_channel<T, Capacity, Lock>::receive_awaiter::receive_awaiter (
+      async_channel& channel)
+      : channel_{ channel }
+  {
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  constexpr bool
+  async_channel<T, Capacity, Lock>::receive_awaiter::await_ready (void) const
+  {
+    return false;
+  }
+
+  /**
+   * @details
+   * Senders wait only while the buffer is full, so after taking
+   * a value, the oldest waiting sender has room for its value.
+   */
+  template <class T, std::size_t Capacity, class Lock>
+  bool
+  async_channel<T, Capacity, Lock>::receive_awaiter::await_suspend (
+      std::coroutine_handle<> handle)
+  {
+    channel_.lock_.lock ();
+    if (channel_.count_ > 0)
+      {
+        value_ = channel_.pop_ ();
+
+        send_awaiter* sender = nullptr;
+        if (!channel_.senders_.empty ())
+          {
+            sender = static_cast<send_awaiter*> (
+                channel_.senders_.unlink_head ());
+            channel_.push_ (std::move (sender->value_));
+          }
+        channel_.lock_.unlock ();
+
+        if (sender != nullptr)
+          {
+            sender->resume ();
+          }
+        return false;
+      }
+
+    handle_ = handle;
+    channel_.receivers_.link_tail (*this);
+    channel_.lock_.unlock ();
+
+    return true;
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  inline typename async_channel<T, Capacity, Lock>::value_type
+  async_channel<T, Capacity, Lock>::receive_awaiter::await_resume (void)
+  {
+    return std::move (value_);
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  async_channel<T, Capacity, Lock>::async_channel ()
+  {
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  async_channel<T, Capacity, Lock>::~async_channel ()
+  {
+    assert (senders_.empty ());
+    assert (receivers_.empty ());
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  inline typename async_channel<T, Capacity, Lock>::send_awaiter
+  async_channel<T, Capacity, Lock>::send (value_type value)
+  {
+    return send_awaiter{ *this, std::move (value) };
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  inline typename async_channel<T, Capacity, Lock>::receive_awaiter
+  async_channel<T, Capacity, Lock>::receive (void)
+  {
+    return receive_awaiter{ *this };
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  typename async_channel<T, Capacity, Lock>::size_type
+  async_channel<T, Capacity, Lock>::size (void)
+  {
+    lock_.lock ();
+    const size_type count = count_;
+    lock_.unlock ();
+
+    return count;
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  constexpr typename async_channel<T, Capacity, Lock>::size_type
+  async_channel<T, Capacity, Lock>::capacity (void)
+  {
+    return Capacity;
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  inline void
+  async_channel<T, Capacity, Lock>::push_ (value_type&& value)
+  {
+    buffer_[(head_ + count_) % Capacity] = std::move (value);
+    ++count_;
+  }
+
+  template <class T, std::size_t Capacity, class Lock>
+  inline typename async_channel<T, Capacity, Lock>::value_type
+  async_channel<T, Capacity, Lock>::pop_ (void)
+  {
+    value_type value = std::move (buffer_[head_]);
+    head_ = (head_ + 1) % Capacity;
+    --count_;
+
+    return value;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(__cpp_impl_coroutine)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_COROUTINES_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,858 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Allocation free synchronisation primitives for C++20 coroutines.
+ *
+ * A coroutine that must wait is parked by linking its awaiter (which
+ * lives in the coroutine frame, and includes the intrusive links) to
+ * an intrusive list of waiters; the waiters are resumed in FIFO order,
+ * so no memory is allocated by the primitives.
+ *
+ * The primitives are protected by a lock policy; the default
+ * `null_lock` is enough when all coroutines run in a single thread
+ * (like an event loop), and a real lock is needed when they are
+ * awakened from other threads.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_COROUTINES_H_
+#define MICRO_OS_PLUS_UTILS_COROUTINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#if defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for the base of the awaiters, with the links
+   * used to park the suspended coroutine.
+   * @headerfile coroutines.h <micro-os-plus/utils/coroutines.h>
+   * @ingroup micro-os-plus-utils
+   */
+  class coroutine_waiter
+  {
+  public:
+    /**
+     * @brief Construct a waiter, not linked.
+     */
+    constexpr coroutine_waiter () = default;
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    coroutine_waiter (const coroutine_waiter&) = delete;
+    coroutine_waiter (coroutine_waiter&&) = delete;
+    coroutine_waiter&
+    operator= (const coroutine_waiter&)
+        = delete;
+    coroutine_waiter&
+    operator= (coroutine_waiter&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the waiter.
+     */
+    constexpr ~coroutine_waiter () = default;
+
+    /**
+     * @brief Resume the parked coroutine.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    resume (void);
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Links to the other waiters.
+     */
+    double_list_links links_;
+
+  protected:
+    /**
+     * @brief The handle of the suspended coroutine.
+     */
+    std::coroutine_handle<> handle_;
+  };
+
+  /**
+   * @brief Type of the lists of parked coroutines.
+   */
+  using coroutine_wait_list
+      = intrusive_list<coroutine_waiter, double_list_links,
+                       &coroutine_waiter::links_>;
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a manual reset event, awaitable
+   * by coroutines.
+   * @headerfile coroutines.h <micro-os-plus/utils/coroutines.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam Lock Type of the lock (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::async_event<> ready;
+   *
+   * // In a coroutine.
+   * co_await ready;
+   *
+   * // Elsewhere.
+   * ready.set ();
+   * @endcode
+   */
+  template <class Lock = null_lock>
+  class async_event
+  {
+  public:
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief The awaiter returned by `co_await`.
+     */
+    class awaiter : public coroutine_waiter
+    {
+    public:
+      /**
+       * @brief Construct an awaiter for an event.
+       * @param [in] event Reference to the event.
+       */
+      explicit awaiter (async_event& event);
+
+      /**
+       * @brief Check if the event is already set.
+       * @par Parameters
+       *  None.
+       * @retval true Do not suspend.
+       * @retval false Suspend.
+       */
+      bool
+      await_ready (void) const;
+
+      /**
+       * @brief Park the coroutine, unless the event was set meanwhile.
+       * @param [in] handle The handle of the suspended coroutine.
+       * @retval true The coroutine remains suspended.
+       * @retval false The coroutine is resumed immediately.
+       */
+      bool
+      await_suspend (std::coroutine_handle<> handle);
+
+      /**
+       * @brief Nothing to return.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      constexpr void
+      await_resume (void) const;
+
+    protected:
+      /**
+       * @brief The event.
+       */
+      async_event& event_;
+    };
+
+    /**
+     * @brief Construct an event.
+     * @param [in] set The initial state.
+     */
+    explicit async_event (bool set = false);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    async_event (const async_event&) = delete;
+    async_event (async_event&&) = delete;
+    async_event&
+    operator= (const async_event&)
+        = delete;
+    async_event&
+    operator= (async_event&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the event.
+     */
+    ~async_event ();
+
+    /**
+     * @brief Wait for the event to be set.
+     * @par Parameters
+     *  None.
+     * @return The awaiter.
+     */
+    awaiter
+    operator co_await (void);
+
+    /**
+     * @brief Set the event and resume all waiting coroutines.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    set (void);
+
+    /**
+     * @brief Reset the event.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    reset (void);
+
+    /**
+     * @brief Check if the event is set.
+     * @par Parameters
+     *  None.
+     * @retval true The event is set.
+     * @retval false The event is not set.
+     */
+    bool
+    is_set (void) const;
+
+  protected:
+    /**
+     * @brief The parked coroutines.
+     */
+    coroutine_wait_list waiters_;
+
+    /**
+     * @brief The lock protecting the list.
+     */
+    lock_type lock_;
+
+    /**
+     * @brief The state.
+     */
+    std::atomic<bool> set_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a counting semaphore, awaitable
+   * by coroutines.
+   * @headerfile coroutines.h <micro-os-plus/utils/coroutines.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam Lock Type of the lock (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::async_semaphore<> slots{ 4 };
+   *
+   * // In a coroutine.
+   * co_await slots.acquire ();
+   * // ...
+   * slots.release ();
+   * @endcode
+   *
+   * @details
+   * A release hands the unit directly to the oldest waiter,
+   * so waiters cannot be overtaken.
+   */
+  template <class Lock = null_lock>
+  class async_semaphore
+  {
+  public:
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Type of the counter.
+     */
+    using count_type = std::size_t;
+
+    /**
+     * @brief The awaiter returned by `acquire()`.
+     */
+    class awaiter : public coroutine_waiter
+    {
+    public:
+      /**
+       * @brief Construct an awaiter for a semaphore.
+       * @param [in] semaphore Reference to the semaphore.
+       */
+      explicit awaiter (async_semaphore& semaphore);
+
+      /**
+       * @brief Always suspend, the counter is checked under the lock.
+       * @par Parameters
+       *  None.
+       * @retval false Suspend.
+       */
+      constexpr bool
+      await_ready (void) const;
+
+      /**
+       * @brief Take a unit, or park the coroutine.
+       * @param [in] handle The handle of the suspended coroutine.
+       * @retval true The coroutine remains suspended.
+       * @retval false A unit was taken, the coroutine is resumed.
+       */
+      bool
+      await_suspend (std::coroutine_handle<> handle);
+
+      /**
+       * @brief Nothing to return.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      constexpr void
+      await_resume (void) const;
+
+    protected:
+      /**
+       * @brief The semaphore.
+       */
+      async_semaphore& semaphore_;
+    };
+
+    /**
+     * @brief Construct a semaphore.
+     * @param [in] count The initial number of units.
+     */
+    explicit async_semaphore (count_type count = 0);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    async_semaphore (const async_semaphore&) = delete;
+    async_semaphore (async_semaphore&&) = delete;
+    async_semaphore&
+    operator= (const async_semaphore&)
+        = delete;
+    async_semaphore&
+    operator= (async_semaphore&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the semaphore.
+     */
+    ~async_semaphore ();
+
+    /**
+     * @brief Wait for a unit.
+     * @par Parameters
+     *  None.
+     * @return The awaiter.
+     */
+    awaiter
+    acquire (void);
+
+    /**
+     * @brief Take a unit, if available, without waiting.
+     * @par Parameters
+     *  None.
+     * @retval true A unit was taken.
+     * @retval false No units available.
+     */
+    bool
+    try_acquire (void);
+
+    /**
+     * @brief Release a unit, resuming the oldest waiter, if any.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    release (void);
+
+    /**
+     * @brief Get the number of available units.
+     * @par Parameters
+     *  None.
+     * @return The counter.
+     */
+    count_type
+    count (void);
+
+  protected:
+    /**
+     * @brief The parked coroutines.
+     */
+    coroutine_wait_list waiters_;
+
+    /**
+     * @brief The lock protecting the counter and the list.
+     */
+    lock_type lock_;
+
+    /**
+     * @brief The number of available units.
+     */
+    count_type count_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a mutex, awaitable by coroutines.
+   * @headerfile coroutines.h <micro-os-plus/utils/coroutines.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam Lock Type of the lock (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::async_mutex<> mutex;
+   *
+   * // In a coroutine.
+   * co_await mutex.lock ();
+   * // ...
+   * mutex.unlock ();
+   * @endcode
+   *
+   * @details
+   * A binary semaphore; the ownership is passed to the waiters
+   * in FIFO order.
+   */
+  template <class Lock = null_lock>
+  class async_mutex
+  {
+  public:
+    /**
+     * @brief Type of the awaiter.
+     */
+    using awaiter = typename async_semaphore<Lock>::awaiter;
+
+    /**
+     * @brief Construct an unlocked mutex.
+     */
+    async_mutex ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    async_mutex (const async_mutex&) = delete;
+    async_mutex (async_mutex&&) = delete;
+    async_mutex&
+    operator= (const async_mutex&)
+        = delete;
+    async_mutex&
+    operator= (async_mutex&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the mutex.
+     */
+    ~async_mutex ();
+
+    /**
+     * @brief Wait to own the mutex.
+     * @par Parameters
+     *  None.
+     * @return The awaiter.
+     */
+    awaiter
+    lock (void);
+
+    /**
+     * @brief Own the mutex, if not locked, without waiting.
+     * @par Parameters
+     *  None.
+     * @retval true The mutex is owned.
+     * @retval false The mutex is locked.
+     */
+    bool
+    try_lock (void);
+
+    /**
+     * @brief Release the mutex, passing it to the oldest waiter, if any.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlock (void);
+
+  protected:
+    /**
+     * @brief The binary semaphore.
+     */
+    async_semaphore<Lock> semaphore_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a bounded channel, awaitable
+   * by coroutines.
+   * @headerfile coroutines.h <micro-os-plus/utils/coroutines.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of the values; must be default constructible
+   *  and movable.
+   * @tparam Capacity The number of buffered values.
+   * @tparam Lock Type of the lock (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::async_channel<int, 8> channel;
+   *
+   * // In the producer coroutine.
+   * co_await channel.send (42);
+   *
+   * // In the consumer coroutine.
+   * int value = co_await channel.receive ();
+   * @endcode
+   *
+   * @details
+   * The senders wait while the buffer is full, the receivers while
+   * it is empty. A value sent while a receiver is waiting is passed
+   * directly to it; a value received while a sender is waiting
+   * makes room for the sender value.
+   *
+   * The awaken coroutines are resumed by the coroutine (or thread)
+   * that made them ready, before it continues.
+   */
+  template <class T, std::size_t Capacity, class Lock = null_lock>
+  class async_channel
+  {
+  public:
+    static_assert (Capacity > 0, "Capacity must be positive!");
+
+    /**
+     * @brief Type of the values.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Type of the sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief The awaiter returned by `send()`.
+     */
+    class send_awaiter : public coroutine_waiter
+    {
+    public:
+      /**
+       * @brief Construct an awaiter for sending a value.
+       * @param [in] channel Reference to the channel.
+       * @param [in] value The value.
+       */
+      send_awaiter (async_channel& channel, value_type&& value);
+
+      /**
+       * @brief Always suspend, the buffer is checked under the lock.
+       * @par Parameters
+       *  None.
+       * @retval false Suspend.
+       */
+      constexpr bool
+      await_ready (void) const;
+
+      /**
+       * @brief Pass the value, or park the coroutine.
+       * @param [in] handle The handle of the suspended coroutine.
+       * @retval true The coroutine remains suspended.
+       * @retval false The value was passed, the coroutine is resumed.
+       */
+      bool
+      await_suspend (std::coroutine_handle<> handle);
+
+      /**
+       * @brief Nothing to return.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      constexpr void
+      await_resume (void) const;
+
+    protected:
+      friend class async_channel;
+
+      /**
+       * @brief The channel.
+       */
+      async_channel& channel_;
+
+      /**
+       * @brief The value to send.
+       */
+      value_type value_;
+    };
+
+    /**
+     * @brief The awaiter returned by `receive()`.
+     */
+    class receive_awaiter : public coroutine_waiter
+    {
+    public:
+      /**
+       * @brief Construct an awaiter for receiving a value.
+       * @param [in] channel Reference to the channel.
+       */
+      explicit receive_awaiter (async_channel& channel);
+
+      /**
+       * @brief Always suspend, the buffer is checked under the lock.
+       * @par Parameters
+       *  None.
+       * @retval false Suspend.
+       */
+      constexpr bool
+      await_ready (void) const;
+
+      /**
+       * @brief Take a value, or park the coroutine.
+       * @param [in] handle The handle of the suspended coroutine.
+       * @retval true The coroutine remains suspended.
+       * @retval false A value was taken, the coroutine is resumed.
+       */
+      bool
+      await_suspend (std::coroutine_handle<> handle);
+
+      /**
+       * @brief Get the received value.
+       * @par Parameters
+       *  None.
+       * @return The value.
+       */
+      value_type
+      await_resume (void);
+
+    protected:
+      friend class async_channel;
+
+      /**
+       * @brief The channel.
+       */
+      async_channel& channel_;
+
+      /**
+       * @brief The received value.
+       */
+      value_type value_{};
+    };
+
+    /**
+     * @brief Construct an empty channel.
+     */
+    async_channel ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    async_channel (const async_channel&) = delete;
+    async_channel (async_channel&&) = delete;
+    async_channel&
+    operator= (const async_channel&)
+        = delete;
+    async_channel&
+    operator= (async_channel&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the channel.
+     */
+    ~async_channel ();
+
+    /**
+     * @brief Send a value, waiting while the buffer is full.
+     * @param [in] value The value.
+     * @return The awaiter.
+     */
+    send_awaiter
+    send (value_type value);
+
+    /**
+     * @brief Receive a value, waiting while the buffer is empty.
+     * @par Parameters
+     *  None.
+     * @return The awaiter, which returns the value.
+     */
+    receive_awaiter
+    receive (void);
+
+    /**
+     * @brief Get the number of buffered values.
+     * @par Parameters
+     *  None.
+     * @return The number of values.
+     */
+    size_type
+    size (void);
+
+    /**
+     * @brief Get the maximum number of buffered values.
+     * @par Parameters
+     *  None.
+     * @return The capacity.
+     */
+    static constexpr size_type
+    capacity (void);
+
+  protected:
+    /**
+     * @brief Add a value at the end of the buffer.
+     * @param [in] value The value.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    push_ (value_type&& value);
+
+    /**
+     * @brief Remove the value at the beginning of the buffer.
+     * @par Parameters
+     *  None.
+     * @return The value.
+     */
+    value_type
+    pop_ (void);
+
+    /**
+     * @brief The parked senders, while the buffer is full.
+     */
+    coroutine_wait_list senders_;
+
+    /**
+     * @brief The parked receivers, while the buffer is empty.
+     */
+    coroutine_wait_list receivers_;
+
+    /**
+     * @brief The lock protecting the buffer and the lists.
+     */
+    lock_type lock_;
+
+    /**
+     * @brief The index of the first value.
+     */
+    size_type head_ = 0;
+
+    /**
+     * @brief The number of buffered values.
+     */
+    size_type count_ = 0;
+
+    /**
+     * @brief The buffer.
+     */
+    value_type buffer_[Capacity];
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(__cpp_impl_coroutine)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "coroutines-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_COROUTINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,261 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_INDEXED_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_INDEXED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  constexpr indexed_list_links::indexed_list_links ()
+      : parent_{ nullptr }, left_{ nullptr }, right_{ nullptr }, size_{ 0 },
+        height_{ 0 }, is_head_node_{ false }
+  {
+  }
+
+  constexpr indexed_list_links::~indexed_list_links ()
+  {
+  }
+
+  /**
+   * @details
+   * All linked nodes have a parent; the tree root has the list head
+   * as parent.
+   */
+  constexpr bool
+  indexed_list_links::linked (void) const
+  {
+    return parent_ != nullptr;
+  }
+
+  constexpr void
+  indexed_list_links::reset_ (void)
+  {
+    parent_ = nullptr;
+    left_ = nullptr;
+    right_ = nullptr;
+    size_ = 0;
+    height_ = 0;
+  }
+
+  constexpr bool
+  indexed_list_links::is_head_ (void) const
+  {
+    return is_head_node_;
+  }
+
+  constexpr indexed_list_links::size_type
+  indexed_list_links::subtree_size_ (const indexed_list_links* node)
+  {
+    return (node == nullptr) ? 0 : node->size_;
+  }
+
+  constexpr int
+  indexed_list_links::subtree_height_ (const indexed_list_links* node)
+  {
+    return (node == nullptr) ? 0 : node->height_;
+  }
+
+  // ==========================================================================
+
+  constexpr bool
+  indexed_list_base::empty (void) const
+  {
+    return head_.left_ == nullptr;
+  }
+
+  constexpr indexed_list_base::size_type
+  indexed_list_base::size (void) const
+  {
+    return (head_.left_ == nullptr) ? 0 : head_.left_->size_;
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, class U>
+  indexed_list<T, N, MP, U>::indexed_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  indexed_list<T, N, MP, U>::~indexed_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  typename indexed_list<T, N, MP, U>::pointer
+  indexed_list<T, N, MP, U>::nth (size_type index) const
+  {
+    indexed_list_links* node = nth_node_ (index);
+    if (node == nullptr)
+      {
+        return nullptr;
+      }
+    return get_pointer (node);
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  typename indexed_list<T, N, MP, U>::size_type
+  indexed_list<T, N, MP, U>::rank (const_reference element)
+  {
+    return get_node (element)->index ();
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  void
+  indexed_list<T, N, MP, U>::insert_at (size_type index, reference element)
+  {
+    insert_node_at_ (index, get_node (element));
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  void
+  indexed_list<T, N, MP, U>::link_tail (reference element)
+  {
+    insert_node_at_ (size (), get_node (element));
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  void
+  indexed_list<T, N, MP, U>::link_head (reference element)
+  {
+    insert_node_at_ (0, get_node (element));
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  void
+  indexed_list<T, N, MP, U>::erase (reference element)
+  {
+    get_node (element)->unlink ();
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  typename indexed_list<T, N, MP, U>::pointer
+  indexed_list<T, N, MP, U>::erase_at (size_type index)
+  {
+    indexed_list_links* node = nth_node_ (index);
+    if (node == nullptr)
+      {
+        return nullptr;
+      }
+    node->unlink ();
+    return get_pointer (node);
+  }
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#endif
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::iterator
+  indexed_list<T, N, MP, U>::begin () const
+  {
+    return iterator{ reinterpret_cast<iterator_pointer> (first_node_ ()) };
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::iterator
+  indexed_list<T, N, MP, U>::end () const
+  {
+    return iterator{ reinterpret_cast<iterator_pointer> (
+        const_cast<indexed_list_links*> (&head_)) };
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::const_iterator
+  indexed_list<T, N, MP, U>::cbegin () const
+  {
+    return const_iterator{ begin () };
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::const_iterator
+  indexed_list<T, N, MP, U>::cend () const
+  {
+    return const_iterator{ end () };
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::reverse_iterator
+  indexed_list<T, N, MP, U>::rbegin () const
+  {
+    return reverse_iterator{ end () };
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::reverse_iterator
+  indexed_list<T, N, MP, U>::rend () const
+  {
+    return reverse_iterator{ begin () };
+  }
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::iterator_pointer
+  indexed_list<T, N, MP, U>::get_node (const_reference element)
+  {
+    return const_cast<iterator_pointer> (&(element.*MP));
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename indexed_list<T, N, MP, U>::pointer
+  indexed_list<T, N, MP, U>::get_pointer (indexed_list_links* node)
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<std::ptrdiff_t> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    // Compute the address of the object which includes the
+    // intrusive node, by adjusting down the node address.
+    return reinterpret_cast<pointer> (
+        reinterpret_cast<std::ptrdiff_t> (static_cast<N*> (node)) - offset);
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_INDEXED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
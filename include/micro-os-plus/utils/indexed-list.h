@@ -0,0 +1,642 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Indexed intrusive sequences.
+ *
+ * The elements are kept in a sequence, like in an intrusive list, but
+ * the links nodes form a balanced (AVL) binary tree ordered by
+ * position, with each node storing the size of its subtree. This
+ * allows to find the element at a given position, to compute the
+ * position of an element, and to insert at a given position, all in
+ * O(log n), while iterating in order is still possible with the usual
+ * intrusive list iterators.
+ *
+ * The tree algorithms do not depend on the element type, so they are
+ * implemented once, in `src/indexed-list.cpp`.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_INDEXED_LIST_H_
+#define MICRO_OS_PLUS_UTILS_INDEXED_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for the links node of an indexed list
+   * (parent, children and subtree size).
+   * @headerfile indexed-list.h <micro-os-plus/utils/indexed-list.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The node is part of a balanced binary tree ordered by position;
+   * the in-order traversal of the tree gives the sequence.
+   *
+   * An unlinked node has all pointers `nullptr`. The root of the
+   * tree is the left child of the list head, thus all linked nodes
+   * have a parent.
+   */
+  class indexed_list_links
+  {
+  public:
+    /**
+     * @brief Type of sizes and positions.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of the subtree height.
+     */
+    using height_type = std::uint8_t;
+
+    /**
+     * @brief Construct an unlinked node.
+     */
+    constexpr indexed_list_links ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    indexed_list_links (const indexed_list_links&) = delete;
+    indexed_list_links (indexed_list_links&&) = delete;
+    indexed_list_links&
+    operator= (const indexed_list_links&)
+        = delete;
+    indexed_list_links&
+    operator= (indexed_list_links&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the node.
+     */
+    constexpr ~indexed_list_links ();
+
+    /**
+     * @brief Check if the node is linked into a list.
+     * @par Parameters
+     *  None.
+     * @retval true The node is linked.
+     * @retval false The node is not linked.
+     */
+    constexpr bool
+    linked (void) const;
+
+    /**
+     * @brief Remove the node from the list, and rebalance the tree.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink (void);
+
+    /**
+     * @brief Get the position of the node in its list.
+     * @par Parameters
+     *  None.
+     * @return The number of nodes before this one.
+     */
+    size_type
+    index (void) const;
+
+    /**
+     * @brief Get the next node in the sequence.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the next node, or to the list head
+     *  after the last node.
+     */
+    indexed_list_links*
+    next (void) const;
+
+    /**
+     * @brief Get the previous node in the sequence.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the previous node; for the list head,
+     *  the last node.
+     */
+    indexed_list_links*
+    previous (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    friend class indexed_list_base;
+
+    /**
+     * @brief Clear all pointers.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    reset_ (void);
+
+    /**
+     * @brief Check if the node is a list head.
+     * @par Parameters
+     *  None.
+     * @retval true The node is a list head.
+     * @retval false The node is an element node.
+     */
+    constexpr bool
+    is_head_ (void) const;
+
+    /**
+     * @brief Get the size of a subtree.
+     * @param [in] node Pointer to the subtree root, may be `nullptr`.
+     * @return The number of nodes in the subtree.
+     */
+    static constexpr size_type
+    subtree_size_ (const indexed_list_links* node);
+
+    /**
+     * @brief Get the height of a subtree.
+     * @param [in] node Pointer to the subtree root, may be `nullptr`.
+     * @return The height of the subtree.
+     */
+    static constexpr int
+    subtree_height_ (const indexed_list_links* node);
+
+    /**
+     * @brief Recompute the size and height of a node from its children.
+     * @param [in] node Pointer to the node.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    update_ (indexed_list_links* node);
+
+    /**
+     * @brief Replace a child of a node.
+     * @param [in] parent Pointer to the parent node (may be the head).
+     * @param [in] old_child Pointer to the current child.
+     * @param [in] new_child Pointer to the new child, may be `nullptr`.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    replace_child_ (indexed_list_links* parent, indexed_list_links* old_child,
+                    indexed_list_links* new_child);
+
+    /**
+     * @brief Rotate a subtree to the left.
+     * @param [in] node Pointer to the subtree root.
+     * @return Pointer to the new subtree root.
+     */
+    static indexed_list_links*
+    rotate_left_ (indexed_list_links* node);
+
+    /**
+     * @brief Rotate a subtree to the right.
+     * @param [in] node Pointer to the subtree root.
+     * @return Pointer to the new subtree root.
+     */
+    static indexed_list_links*
+    rotate_right_ (indexed_list_links* node);
+
+    /**
+     * @brief Update the sizes and restore the balance, from a node
+     * up to the root.
+     * @param [in] node Pointer to the first node to update.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    rebalance_ (indexed_list_links* node);
+
+    /**
+     * @brief Pointer to the parent node (the list head for the root).
+     */
+    indexed_list_links* parent_;
+
+    /**
+     * @brief Pointer to the left child (the root, for the list head).
+     */
+    indexed_list_links* left_;
+
+    /**
+     * @brief Pointer to the right child.
+     */
+    indexed_list_links* right_;
+
+    /**
+     * @brief Number of nodes in the subtree rooted at this node.
+     */
+    size_type size_;
+
+    /**
+     * @brief Height of the subtree rooted at this node.
+     */
+    height_type height_;
+
+    /**
+     * @brief True for the list head.
+     */
+    bool is_head_node_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class with the type independent part of the indexed lists.
+   * @headerfile indexed-list.h <micro-os-plus/utils/indexed-list.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The list keeps a head node, whose left child is the tree root;
+   * the head is also the end position of the iterators.
+   */
+  class indexed_list_base
+  {
+  public:
+    /**
+     * @brief Type of sizes and positions.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct an empty list.
+     */
+    indexed_list_base ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    indexed_list_base (const indexed_list_base&) = delete;
+    indexed_list_base (indexed_list_base&&) = delete;
+    indexed_list_base&
+    operator= (const indexed_list_base&)
+        = delete;
+    indexed_list_base&
+    operator= (indexed_list_base&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~indexed_list_base ();
+
+    /**
+     * @brief Check if the list is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The list has no nodes.
+     * @retval false The list has at least one node.
+     */
+    constexpr bool
+    empty (void) const;
+
+    /**
+     * @brief Get the number of nodes in the list.
+     * @par Parameters
+     *  None.
+     * @return The number of nodes, in O(1).
+     */
+    constexpr size_type
+    size (void) const;
+
+    /**
+     * @brief Clear the list.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * Only the list head is reset; like for the other lists,
+     * the nodes keep their old pointers.
+     */
+    void
+    clear (void);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Get the node at a position.
+     * @param [in] index The position.
+     * @return Pointer to the node, or `nullptr` if the index
+     *  is not less than the size.
+     */
+    indexed_list_links*
+    nth_node_ (size_type index) const;
+
+    /**
+     * @brief Insert a node at a position.
+     * @param [in] index The position; must not be greater
+     *  than the size.
+     * @param [in] node Pointer to an unlinked node.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    insert_node_at_ (size_type index, indexed_list_links* node);
+
+    /**
+     * @brief Get the first node.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the first node, or to the head if the
+     *  list is empty.
+     */
+    indexed_list_links*
+    first_node_ (void) const;
+
+    /**
+     * @brief The list head; the left child is the tree root.
+     */
+    indexed_list_links head_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for an indexed intrusive sequence.
+   * @headerfile indexed-list.h <micro-os-plus/utils/indexed-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node (`indexed_list_links`).
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam U Type stored in the list, derived from T.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * using ready_queue = utils::indexed_list<
+   *   thread, utils::indexed_list_links, &thread::ready_links_>;
+   * @endcode
+   *
+   * @details
+   * Similar to `intrusive_list`, but in addition to the O(1)
+   * operations at the ends (which here are O(log n)), it
+   * supports, in O(log n):
+   * - `nth()`, to get the element at a position;
+   * - `rank()`, to get the position of an element;
+   * - `insert_at()`, to insert an element at a position;
+   * - `erase()`, to unlink an element.
+   *
+   * The iterators are the intrusive list iterators (bidirectional),
+   * each increment costs amortised O(1).
+   */
+  template <class T, class N, N T::*MP, class U = T>
+  class indexed_list : public indexed_list_base
+  {
+  public:
+    static_assert (std::is_base_of<indexed_list_links, N>::value == true,
+                   "N must be derived from indexed_list_links!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = U;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of constant reference to an element.
+     */
+    using const_reference = const value_type&;
+
+    /**
+     * @brief Type of iterator over the values.
+     */
+    using iterator = intrusive_list_iterator<T, N, MP, U>;
+
+    /**
+     * @brief Type of constant iterator over the values.
+     */
+    using const_iterator = intrusive_list_iterator<T, N, MP, const U>;
+
+    /**
+     * @brief Type of reverse iterator over the values.
+     */
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /**
+     * @brief Type of constant reverse iterator over the values.
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Type of reference to the iterator internal pointer.
+     */
+    using iterator_pointer = N*;
+
+    /**
+     * @brief Construct an empty indexed list.
+     */
+    indexed_list ();
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~indexed_list ();
+
+    /**
+     * @brief Get the element at a position.
+     * @param [in] index The position.
+     * @return Pointer to the element, or `nullptr` if the index
+     *  is not less than the size.
+     */
+    pointer
+    nth (size_type index) const;
+
+    /**
+     * @brief Get the position of an element.
+     * @param [in] element Reference to a linked element.
+     * @return The number of elements before it.
+     */
+    static size_type
+    rank (const_reference element);
+
+    /**
+     * @brief Insert an element at a position.
+     * @param [in] index The position; must not be greater
+     *  than the size.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    insert_at (size_type index, reference element);
+
+    /**
+     * @brief Add an element to the tail of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_tail (reference element);
+
+    /**
+     * @brief Add an element to the head of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_head (reference element);
+
+    /**
+     * @brief Unlink an element from the list.
+     * @param [in] element Reference to a linked element.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    erase (reference element);
+
+    /**
+     * @brief Unlink the element at a position.
+     * @param [in] index The position.
+     * @return Pointer to the unlinked element, or `nullptr` if
+     *  the index is not less than the size.
+     */
+    pointer
+    erase_at (size_type index);
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Iterator begin.
+     * @return An iterator positioned at the first element.
+     */
+    iterator
+    begin () const;
+
+    /**
+     * @brief Iterator end.
+     * @return An iterator positioned after the last element.
+     */
+    iterator
+    end () const;
+
+    /**
+     * @brief Constant iterator begin.
+     * @return A constant iterator positioned at the first element.
+     */
+    const_iterator
+    cbegin () const;
+
+    /**
+     * @brief Constant iterator end.
+     * @return A constant iterator positioned after the last element.
+     */
+    const_iterator
+    cend () const;
+
+    /**
+     * @brief Reverse iterator begin.
+     * @return A reverse iterator positioned at the last element.
+     */
+    reverse_iterator
+    rbegin () const;
+
+    /**
+     * @brief Reverse iterator end.
+     * @return A reverse iterator positioned before the first element.
+     */
+    reverse_iterator
+    rend () const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Get the address of the intrusive node of an element.
+     * @param [in] element Reference to an element.
+     * @return A pointer to the node.
+     */
+    static iterator_pointer
+    get_node (const_reference element);
+
+    /**
+     * @brief Get the element that includes a node.
+     * @param [in] node Pointer to the intrusive node.
+     * @return A pointer to the element.
+     */
+    static pointer
+    get_pointer (indexed_list_links* node);
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "indexed-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_INDEXED_LIST_H_
+
+// ----------------------------------------------------------------------------
@@ -100,6 +100,33 @@ namespace micro_os_plus::utils
     return previous_;
   }
 
+  constexpr void
+  double_list_links_base::next (double_list_links_base* node)
+  {
+    next_ = node;
+  }
+
+  constexpr void
+  double_list_links_base::previous (double_list_links_base* node)
+  {
+    previous_ = node;
+  }
+
+  inline double_list_links_base*
+  double_list_links_base::next (std::memory_order order) const
+  {
+    return std::atomic_ref<double_list_links_base*>{
+      const_cast<double_list_links_base*&> (next_)
+    }.load (order);
+  }
+
+  inline void
+  double_list_links_base::next (double_list_links_base* node,
+                                std::memory_order order)
+  {
+    std::atomic_ref<double_list_links_base*>{ next_ }.store (node, order);
+  }
+
 #pragma GCC diagnostic pop
 
   // ==========================================================================
@@ -161,6 +188,133 @@ namespace micro_os_plus::utils
 
   // ==========================================================================
 
+  constexpr generation_double_list_links::generation_double_list_links ()
+      : head_{ nullptr }, generation_{ 0 }
+  {
+    double_list_links_base::initialize ();
+  }
+
+  constexpr generation_double_list_links::~generation_double_list_links ()
+  {
+    set_head_ (nullptr);
+  }
+
+  /**
+   * @details
+   * Set both pointers to point to this node and forget the list.
+   */
+  constexpr void
+  generation_double_list_links::initialize (void)
+  {
+    double_list_links_base::initialize ();
+    set_head_ (nullptr);
+  }
+
+  /**
+   * @details
+   * In debug builds, the reference to the old list head is
+   * released and the new one is counted; the list head itself
+   * is not counted.
+   */
+  constexpr void
+  generation_double_list_links::set_head_ (generation_double_list_links* head)
+  {
+#if !defined(NDEBUG)
+    if (head_ != nullptr && head_ != this)
+      {
+        --static_cast<generation_double_list_head*> (head_)->references_;
+      }
+    if (head != nullptr && head != this)
+      {
+        ++static_cast<generation_double_list_head*> (head)->references_;
+      }
+#endif
+    head_ = head;
+  }
+
+  constexpr generation_double_list_links::generation_type
+  generation_double_list_links::generation (void) const
+  {
+    return generation_;
+  }
+
+  // ==========================================================================
+
+  constexpr generation_double_list_head::generation_double_list_head ()
+      : references_{ 0 }
+  {
+    head_ = this;
+  }
+
+  /**
+   * @details
+   * In debug builds, check that no node still refers this list head.
+   */
+  constexpr generation_double_list_head::~generation_double_list_head ()
+  {
+    assert (references_ == 0);
+  }
+
+  /**
+   * @details
+   * Set both pointers to point to this node, and increment the
+   * generation; the nodes stamped with older generations become stale.
+   *
+   * @note
+   * The counter wraps around after 2^32 (or 2^64) clears; a node
+   * not touched during all this time would be considered
+   * linked again.
+   */
+  constexpr void
+  generation_double_list_head::initialize (void)
+  {
+    double_list_links_base::initialize ();
+    head_ = this;
+    ++generation_;
+  }
+
+  // ==========================================================================
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+
+  /**
+   * @details
+   * On hosted platforms the counter is thread local, and the
+   * fast path is a plain increment of a per-thread variable.
+   *
+   * Otherwise the shared counter is updated with a relaxed load
+   * and store, not with a read-modify-write; concurrent operations
+   * on different lists may lose some counts, which only delays
+   * the next check.
+   */
+  inline void
+  list_integrity::sample (const double_list_links_base* node)
+  {
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+    if (++operations_ < sampling)
+      {
+        return;
+      }
+
+    operations_ = 0;
+#else
+    const std::uint32_t count
+        = operations_.load (std::memory_order_relaxed) + 1;
+    if (count < sampling)
+      {
+        operations_.store (count, std::memory_order_relaxed);
+        return;
+      }
+
+    operations_.store (0, std::memory_order_relaxed);
+#endif
+    check (node);
+  }
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+
+  // ==========================================================================
+
   template <class T, class N, class U>
   constexpr double_list_iterator<T, N, U>::double_list_iterator () : node_{}
   {
@@ -184,6 +338,20 @@ namespace micro_os_plus::utils
     }
 #endif
 
+  /**
+   * @details
+   * Allows passing a plain iterator where a constant one is expected,
+   * like `std::list` does.
+   */
+  template <class T, class N, class U>
+  template <class V>
+    requires std::is_same<const V, U>::value
+  constexpr double_list_iterator<T, N, U>::double_list_iterator (
+      const double_list_iterator<T, N, V>& other)
+      : node_{ other.get_iterator_pointer () }
+  {
+  }
+
   template <class T, class N, class U>
   constexpr typename double_list_iterator<T, N, U>::pointer
   double_list_iterator<T, N, U>::operator->() const
@@ -211,7 +379,7 @@ namespace micro_os_plus::utils
   double_list_iterator<T, N, U>::operator++ (int)
   {
     const auto tmp = *this;
-    node_ = static_cast<iterator_pointer> (node_->next);
+    node_ = static_cast<iterator_pointer> (node_->next ());
     return tmp;
   }
 
@@ -219,7 +387,7 @@ namespace micro_os_plus::utils
   constexpr double_list_iterator<T, N, U>&
   double_list_iterator<T, N, U>::operator-- ()
   {
-    node_ = static_cast<iterator_pointer> (node_->previous);
+    node_ = static_cast<iterator_pointer> (node_->previous ());
     return *this;
   }
 
@@ -228,7 +396,7 @@ namespace micro_os_plus::utils
   double_list_iterator<T, N, U>::operator-- (int)
   {
     const auto tmp = *this;
-    node_ = static_cast<iterator_pointer> (node_->previous);
+    node_ = static_cast<iterator_pointer> (node_->previous ());
     return tmp;
   }
 
@@ -248,6 +416,13 @@ namespace micro_os_plus::utils
     return node_ != other.node_;
   }
 
+  template <class T, class N, class U>
+  constexpr typename double_list_iterator<T, N, U>::pointer
+  double_list_iterator<T, N, U>::get_pointer () const
+  {
+    return static_cast<pointer> (node_);
+  }
+
   template <class T, class N, class U>
   constexpr typename double_list_iterator<T, N, U>::iterator_pointer
   double_list_iterator<T, N, U>::get_iterator_pointer () const
@@ -257,6 +432,91 @@ namespace micro_os_plus::utils
 
   // ==========================================================================
 
+  template <class I>
+  constexpr safe_list_iterator<I>::safe_list_iterator ()
+      : current_{}, next_{}, end_{}
+  {
+  }
+
+  template <class I>
+  constexpr safe_list_iterator<I>::safe_list_iterator (iterator_type current,
+                                                       iterator_type end)
+      : end_{ end }
+  {
+    advance_to_ (current);
+  }
+
+  template <class I>
+  constexpr typename safe_list_iterator<I>::reference
+  safe_list_iterator<I>::operator* () const
+  {
+    return *current_;
+  }
+
+  template <class I>
+  constexpr typename safe_list_iterator<I>::pointer
+  safe_list_iterator<I>::operator->() const
+  {
+    return current_.operator->();
+  }
+
+  template <class I>
+  constexpr safe_list_iterator<I>&
+  safe_list_iterator<I>::operator++ ()
+  {
+    advance_to_ (next_);
+    return *this;
+  }
+
+  template <class I>
+  constexpr safe_list_iterator<I>
+  safe_list_iterator<I>::operator++ (int)
+  {
+    const auto tmp = *this;
+    advance_to_ (next_);
+    return tmp;
+  }
+
+  template <class I>
+  constexpr bool
+  safe_list_iterator<I>::operator== (const safe_list_iterator& other) const
+  {
+    return current_ == other.current_;
+  }
+
+  template <class I>
+  constexpr bool
+  safe_list_iterator<I>::operator!= (const safe_list_iterator& other) const
+  {
+    return current_ != other.current_;
+  }
+
+  template <class I>
+  constexpr typename safe_list_iterator<I>::iterator_type
+  safe_list_iterator<I>::base (void) const
+  {
+    return current_;
+  }
+
+  /**
+   * @details
+   * The successor is read while the current node is still linked;
+   * at the end, the successor is the end itself.
+   */
+  template <class I>
+  constexpr void
+  safe_list_iterator<I>::advance_to_ (iterator_type current)
+  {
+    current_ = current;
+    next_ = current;
+    if (current != end_)
+      {
+        ++next_;
+      }
+  }
+
+  // ==========================================================================
+
   /**
    * @details
    * For non-statically allocated lists, the initial list status is
@@ -264,8 +524,8 @@ namespace micro_os_plus::utils
    *
    * Statically allocated remain _uninitialised_.
    */
-  template <class T, class L>
-  double_list<T, L>::double_list ()
+  template <class T, class L, class S>
+  double_list<T, L, S>::double_list () : S{ is_statically_allocated::value }
   {
 #if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
     trace::printf ("%s() @%p \n", __func__, this);
@@ -292,8 +552,8 @@ namespace micro_os_plus::utils
    * In debug mode, the code warns if the list is not empty
    * when destroyed.
    */
-  template <class T, class L>
-  constexpr double_list<T, L>::~double_list ()
+  template <class T, class L, class S>
+  constexpr double_list<T, L, S>::~double_list ()
   {
 #if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
     trace::printf ("%s() @%p \n", __func__, this);
@@ -317,9 +577,9 @@ namespace micro_os_plus::utils
    * Only statically allocated nodes in the initial state are
    * _uninitialized_.
    */
-  template <class T, class L>
+  template <class T, class L, class S>
   bool
-  double_list<T, L>::uninitialized (void) const
+  double_list<T, L, S>::uninitialized (void) const
   {
     if constexpr (is_statically_allocated::value)
       {
@@ -344,9 +604,9 @@ namespace micro_os_plus::utils
    * Must be manually called for statically allocated list before
    * inserting elements, or any other operations.
    */
-  template <class T, class L>
+  template <class T, class L, class S>
   void
-  double_list<T, L>::initialize_once (void)
+  double_list<T, L, S>::initialize_once (void)
   {
     if constexpr (is_statically_allocated::value)
       {
@@ -354,10 +614,25 @@ namespace micro_os_plus::utils
       }
   }
 
-  template <class T, class L>
+  /**
+   * @details
+   * Statically allocated lists which are not yet initialised are
+   * also empty; the check may run concurrently with
+   * `initialize_once()`.
+   */
+  template <class T, class L, class S>
   bool
-  double_list<T, L>::empty (void) const
+  double_list<T, L, S>::empty (void) const
   {
+    if constexpr (is_statically_allocated::value)
+      {
+        // Possibly still being initialised by `initialize_once()`.
+        if (links_.uninitialized ())
+          {
+            return true;
+          }
+      }
+
     // If the links node is not linked, the list is empty.
     return !links_.linked ();
   }
@@ -366,33 +641,36 @@ namespace micro_os_plus::utils
    * @details
    * Initialise the mandatory node with links to itself.
    */
-  template <class T, class L>
+  template <class T, class L, class S>
   void
-  double_list<T, L>::clear (void)
+  double_list<T, L, S>::clear (void)
   {
-#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::clear, &links_, nullptr);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
     trace::printf ("%s() @%p\n", __func__, this);
 #endif
     links_.initialize ();
+    this->on_clear_ ();
   }
 
-  template <class T, class L>
-  constexpr typename double_list<T, L>::pointer
-  double_list<T, L>::head (void) const
+  template <class T, class L, class S>
+  constexpr typename double_list<T, L, S>::pointer
+  double_list<T, L, S>::head (void) const
   {
     return reinterpret_cast<pointer> (links_.next ());
   }
 
-  template <class T, class L>
-  constexpr typename double_list<T, L>::pointer
-  double_list<T, L>::tail (void) const
+  template <class T, class L, class S>
+  constexpr typename double_list<T, L, S>::pointer
+  double_list<T, L, S>::tail (void) const
   {
     return reinterpret_cast<pointer> (links_.previous ());
   }
 
-  template <class T, class L>
+  template <class T, class L, class S>
   void
-  double_list<T, L>::link_tail (reference node)
+  double_list<T, L, S>::link_tail (reference node)
   {
     if constexpr (is_statically_allocated::value)
       {
@@ -401,11 +679,12 @@ namespace micro_os_plus::utils
 
     // Add new node at the end of the list.
     tail ()->link_next (&node);
+    this->on_link_ (&node);
   }
 
-  template <class T, class L>
+  template <class T, class L, class S>
   void
-  double_list<T, L>::link_head (reference node)
+  double_list<T, L, S>::link_head (reference node)
   {
     if constexpr (is_statically_allocated::value)
       {
@@ -414,121 +693,998 @@ namespace micro_os_plus::utils
 
     // Add the new node at the head of the list.
     head ()->link_previous (&node);
+    this->on_link_ (&node);
   }
 
-  template <class T, class L>
-  typename double_list<T, L>::iterator
-  double_list<T, L>::begin () const
+  /**
+   * @details
+   * For statically allocated lists, the list is also initialised,
+   * if needed, so registrars need no separate initialisation.
+   *
+   * The operation is serialised with the other concurrent
+   * operations by a global spin lock; the list must not be
+   * changed concurrently by other means, except by
+   * `initialize_once()`, which may run concurrently.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::link_tail_concurrent (reference node)
   {
     if constexpr (is_statically_allocated::value)
       {
-        assert (!links_.uninitialized ());
+        // Takes the lock only if the list is not yet initialised.
+        links_.initialize_once ();
+
+        concurrent_links_guard guard;
+
+        // The head **next** is also read by `initialize_once()`,
+        // without the lock, thus it is stored atomically.
+        links_.link_previous_concurrent (&node);
+        this->on_link_ (&node);
       }
+    else
+      {
+        concurrent_links_guard guard;
 
-    return iterator{ static_cast<iterator_pointer> (links_.next ()) };
+        link_tail (node);
+      }
   }
 
-  template <class T, class L>
-  typename double_list<T, L>::iterator
-  double_list<T, L>::end () const
+  /**
+   * @details
+   * The nodes are chained among themselves, and the chain is
+   * linked to the list tail at the end, with only one update
+   * of the list links.
+   */
+  template <class T, class L, class S>
+  template <class I>
+  void
+  double_list<T, L, S>::link_tail_range (I first, I last)
   {
-    // The assert would probably be redundant, since it was
-    // already tested in `begin()`.
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
 
-    return iterator{ reinterpret_cast<iterator_pointer> (
-        const_cast<links_type*> (&links_)) };
+    link_range_after_ (links_.previous (), first, last,
+                       [] (reference node) -> double_list_links_base* {
+                         return &node;
+                       });
   }
 
-  // ==========================================================================
-
-  template <class T, class N, N T::*MP, class U>
-  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator ()
-      : node_{}
+  template <class T, class L, class S>
+  template <class R>
+  void
+  double_list<T, L, S>::link_tail_range (R&& range)
   {
+    link_tail_range (std::begin (range), std::end (range));
   }
 
-  template <class T, class N, N T::*MP, class U>
-  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator (
-      N* const node)
-      : node_{ node }
+  /**
+   * @details
+   * The nodes are chained among themselves, and the chain is
+   * linked to the list head at the end, with only one update
+   * of the list links. The first node in the range becomes
+   * the list head.
+   */
+  template <class T, class L, class S>
+  template <class I>
+  void
+  double_list<T, L, S>::link_head_range (I first, I last)
   {
-  }
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
 
-  template <class T, class N, N T::*MP, class U>
-  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator (
-      reference element)
-      : node_{ &(element.*MP) }
-  {
-    static_assert (std::is_convertible<U, T>::value == true,
-                   "U must be implicitly convertible to T!");
+    link_range_after_ (&links_, first, last,
+                       [] (reference node) -> double_list_links_base* {
+                         return &node;
+                       });
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline typename intrusive_list_iterator<T, N, MP, U>::pointer
-  intrusive_list_iterator<T, N, MP, U>::operator->() const
+  template <class T, class L, class S>
+  template <class R>
+  void
+  double_list<T, L, S>::link_head_range (R&& range)
   {
-    return get_pointer ();
+    link_head_range (std::begin (range), std::end (range));
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline typename intrusive_list_iterator<T, N, MP, U>::reference
-  intrusive_list_iterator<T, N, MP, U>::operator* () const
+  /**
+   * @details
+   * This is the same as `node.unlink()`, but it also updates
+   * the list statistics; nodes which are not linked are not counted.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::unlink (reference node)
   {
-    return *get_pointer ();
+    if (node.linked ())
+      {
+        this->on_unlink_ (&node);
+      }
+    node.unlink ();
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline intrusive_list_iterator<T, N, MP, U>&
-  intrusive_list_iterator<T, N, MP, U>::operator++ ()
+  template <class T, class L, class S>
+  template <class P>
+  std::size_t
+  double_list<T, L, S>::remove_if (P&& pred)
   {
-    node_ = static_cast<iterator_pointer> (node_->next ());
-    return *this;
+    return remove_if (std::forward<P> (pred), [] (reference) {});
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline intrusive_list_iterator<T, N, MP, U>
-  intrusive_list_iterator<T, N, MP, U>::operator++ (int)
+  /**
+   * @details
+   * The list is traversed once; the links of the kept nodes are
+   * updated once for each run of removed nodes, not once for
+   * each removed node.
+   */
+  template <class T, class L, class S>
+  template <class P, class D>
+  std::size_t
+  double_list<T, L, S>::remove_if (P&& pred, D&& disposer)
   {
-    const auto tmp = *this;
-    node_ = static_cast<iterator_pointer> (node_->next ());
-    return tmp;
+    return remove_nodes_if_ (
+        [&pred] (iterator_pointer, iterator_pointer node) -> bool {
+          return pred (*node);
+        },
+        [&disposer] (iterator_pointer node) { disposer (*node); });
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline intrusive_list_iterator<T, N, MP, U>&
-  intrusive_list_iterator<T, N, MP, U>::operator-- ()
+  template <class T, class L, class S>
+  template <class E>
+  std::size_t
+  double_list<T, L, S>::unique (E&& eq)
   {
-    node_ = static_cast<iterator_pointer> (node_->previous ());
-    return *this;
+    return unique (std::forward<E> (eq), [] (reference) {});
   }
 
-  template <class T, class N, N T::*MP, class U>
-  intrusive_list_iterator<T, N, MP, U>
-  intrusive_list_iterator<T, N, MP, U>::operator-- (int)
+  template <class T, class L, class S>
+  template <class E, class D>
+  std::size_t
+  double_list<T, L, S>::unique (E&& eq, D&& disposer)
   {
-    const auto tmp = *this;
-    node_ = static_cast<iterator_pointer> (node_->previous ());
-    return tmp;
+    return remove_nodes_if_ (
+        [&eq] (iterator_pointer kept, iterator_pointer node) -> bool {
+          return kept != nullptr && eq (*kept, *node);
+        },
+        [&disposer] (iterator_pointer node) { disposer (*node); });
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline bool
-  intrusive_list_iterator<T, N, MP, U>::operator== (
-      const intrusive_list_iterator& other) const
+  /**
+   * @details
+   * Runs of consecutive matching nodes are moved with a single
+   * splice; the relative order is preserved in both lists.
+   */
+  template <class T, class L, class S>
+  template <class P>
+  std::size_t
+  double_list<T, L, S>::partition (P&& pred, double_list& out)
   {
-    return node_ == other.node_;
+    return partition_nodes_ (
+        [&pred] (iterator_pointer node) -> bool { return pred (*node); },
+        out);
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline bool
-  intrusive_list_iterator<T, N, MP, U>::operator!= (
-      const intrusive_list_iterator& other) const
+  /**
+   * @details
+   * Since the nodes are spliced, the partition is always stable;
+   * this is the same as `partition()`.
+   */
+  template <class T, class L, class S>
+  template <class P>
+  std::size_t
+  double_list<T, L, S>::stable_partition (P&& pred, double_list& out)
   {
-    return node_ != other.node_;
+    return partition (std::forward<P> (pred), out);
   }
 
-  template <class T, class N, N T::*MP, class U>
-  inline typename intrusive_list_iterator<T, N, MP, U>::pointer
+  /**
+   * @details
+   * The **next** and **previous** pointers of each node, including
+   * the list head, are swapped; this is O(n), with two stores
+   * per node.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::reverse (void)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::reverse, &links_, nullptr);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
+
+    double_list_links_base* const head_node = &links_;
+    double_list_links_base* node = head_node;
+    do
+      {
+        double_list_links_base* next = node->next ();
+        node->next (node->previous ());
+        node->previous (next);
+        node = next;
+      }
+    while (node != head_node);
+  }
+
+  /**
+   * @details
+   * The range is detached and linked before the position with six
+   * pointer stores, regardless of its length. For generation lists,
+   * the nodes are moved one by one, to be stamped with the
+   * destination list generation.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::splice (iterator position, double_list& other,
+                                iterator first, iterator last)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::splice, &links_,
+                         &other.links_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+        assert (!other.links_.uninitialized ());
+      }
+
+    if (&other != this)
+      {
+        other.stats_unlink_range_ (first.get_iterator_pointer (),
+                                   last.get_iterator_pointer ());
+        stats_link_range_ (first.get_iterator_pointer (),
+                           last.get_iterator_pointer ());
+      }
+
+    splice_nodes_ (position.get_iterator_pointer (),
+                   first.get_iterator_pointer (),
+                   last.get_iterator_pointer ());
+  }
+
+  /**
+   * @details
+   * The nodes are detached and linked to the tail of the destination
+   * with six pointer stores, regardless of their number; only the
+   * first and the last nodes are rewired. For generation lists, the
+   * nodes are moved one by one, to be stamped with the destination
+   * list generation.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::take_all (double_list& out)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::take_all, &links_,
+                         &out.links_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+        assert (!out.links_.uninitialized ());
+      }
+    assert (&out != this);
+
+    stats_unlink_range_ (links_.next (), &links_);
+    out.stats_link_range_ (links_.next (), &links_);
+
+    splice_nodes_ (&out.links_, links_.next (), &links_);
+  }
+
+  /**
+   * @details
+   * The lock is held only for the few pointer stores, instead of
+   * for a loop of `unlink_head()` calls.
+   *
+   * With statistics, this list counts the unlinked nodes from
+   * its length, without walking them (thus their residency is not
+   * recorded), and the destination list walks the new nodes
+   * after the lock is released.
+   */
+  template <class T, class L, class S>
+  template <class Lock>
+  void
+  double_list<T, L, S>::take_all (double_list& out, Lock& lock)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::take_all, &links_,
+                         &out.links_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!out.links_.uninitialized ());
+      }
+    assert (&out != this);
+
+    // The destination is not shared, thus its tail is stable.
+    double_list_links_base* tail = out.links_.previous ();
+
+    lock.lock ();
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
+    this->on_unlink_all_ ();
+    splice_nodes_ (&out.links_, links_.next (), &links_);
+    lock.unlock ();
+
+    out.stats_link_range_ (tail->next (), &out.links_);
+  }
+
+  /**
+   * @details
+   * The nodes of the other list are appended to this list, then the
+   * original nodes are moved to the other list; both moves take
+   * constant time (except for generation lists).
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::exchange (double_list& other)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::exchange, &links_,
+                         &other.links_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+        assert (!other.links_.uninitialized ());
+      }
+
+    if (&other == this)
+      {
+        return;
+      }
+
+    // The first node of the other list, or the end of this list.
+    double_list_links_base* boundary
+        = other.empty () ? &links_ : other.links_.next ();
+
+    stats_unlink_range_ (links_.next (), &links_);
+    other.stats_unlink_range_ (other.links_.next (), &other.links_);
+
+    splice_nodes_ (&links_, other.links_.next (), &other.links_);
+    splice_nodes_ (&other.links_, links_.next (), boundary);
+
+    stats_link_range_ (links_.next (), &links_);
+    other.stats_link_range_ (other.links_.next (), &other.links_);
+  }
+
+  /**
+   * @details
+   * The pointer stores take constant time, but with statistics
+   * the nodes of both lists are walked with the lock held, to
+   * count them; the nodes of the other list must be counted by
+   * this list before any other thread can unlink them.
+   */
+  template <class T, class L, class S>
+  template <class Lock>
+  void
+  double_list<T, L, S>::exchange (double_list& other, Lock& lock)
+  {
+    lock.lock ();
+    exchange (other);
+    lock.unlock ();
+  }
+
+  /**
+   * @details
+   * The list is walked from the head, and each node must point
+   * back to the previous one; the walk must end at the list links,
+   * which must point back to the last node.
+   *
+   * The walk always ends: a corruption that closes a cycle
+   * not passing through the list links is detected when the walk
+   * reaches a node for the second time, since the node points
+   * back to its first predecessor.
+   *
+   * Uninitialised statically allocated lists are valid and empty.
+   */
+  template <class T, class L, class S>
+  bool
+  double_list<T, L, S>::validate (void) const
+  {
+    std::size_t size;
+    return validate_ (size);
+  }
+
+  template <class T, class L, class S>
+  bool
+  double_list<T, L, S>::validate (std::size_t expected_size) const
+  {
+    std::size_t size;
+    return validate_ (size) && size == expected_size;
+  }
+
+  template <class T, class L, class S>
+  template <class F>
+  void
+  double_list<T, L, S>::for_each_safe (F&& function)
+  {
+    for (auto it = safe_begin (), last = safe_end (); it != last; ++it)
+      {
+        function (*it);
+      }
+  }
+
+  /**
+   * @details
+   * The nodes are unlinked one by one, so the list is consistent
+   * when the function is called; the function may, for example,
+   * link the node into another list.
+   */
+  template <class T, class L, class S>
+  template <class P, class F>
+  std::size_t
+  double_list<T, L, S>::drain_if (P&& pred, F&& function)
+  {
+    std::size_t count = 0;
+    for (auto it = safe_begin (), last = safe_end (); it != last; ++it)
+      {
+        reference element = *it;
+        if (pred (element))
+          {
+            this->on_unlink_ (&element);
+            element.unlink ();
+            function (element);
+            ++count;
+          }
+      }
+    return count;
+  }
+
+  /**
+   * @details
+   * The range elements may be either references or pointers
+   * to elements; `to_node` converts them to links nodes.
+   *
+   * Each node is linked to the previous one in the range,
+   * with sequential stores; the neighbours of the insertion point
+   * are read once at the beginning and written once at the end.
+   *
+   * For lists with generation-stamped nodes, the nodes are linked
+   * one by one, to also stamp them.
+   */
+  template <class T, class L, class S>
+  template <class I, class F>
+  void
+  double_list<T, L, S>::link_range_after_ (double_list_links_base* after,
+                                           I first, I last, F&& to_node)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::link_range, &links_, after);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p after %p\n", __func__, this, after);
+#endif
+    auto node_of = [&to_node] (auto&& element) -> double_list_links_base* {
+      if constexpr (std::is_pointer<typename std::remove_cv<
+                        typename std::remove_reference<decltype (
+                            element)>::type>::type>::value)
+        {
+          return to_node (*element);
+        }
+      else
+        {
+          return to_node (element);
+        }
+    };
+
+    if constexpr (std::is_base_of<generation_double_list_links, L>::value)
+      {
+        for (; first != last; ++first)
+          {
+            double_list_links_base* node = node_of (*first);
+            static_cast<generation_double_list_links*> (after)->link_next (
+                static_cast<generation_double_list_links*> (node));
+            this->on_link_ (static_cast<iterator_pointer> (node));
+            after = node;
+          }
+      }
+    else
+      {
+        if (first == last)
+          {
+            return;
+          }
+
+        double_list_links_base* before = after->next ();
+
+        double_list_links_base* head_node = node_of (*first);
+        head_node->previous (after);
+        this->on_link_ (static_cast<iterator_pointer> (head_node));
+
+        double_list_links_base* previous = head_node;
+        for (++first; first != last; ++first)
+          {
+            double_list_links_base* node = node_of (*first);
+            node->previous (previous);
+            previous->next (node);
+            this->on_link_ (static_cast<iterator_pointer> (node));
+            previous = node;
+          }
+
+        // Publish the chain.
+        previous->next (before);
+        before->previous (previous);
+        after->next (head_node);
+      }
+  }
+
+  /**
+   * @details
+   * While the list is traversed, the removed nodes are detached
+   * and initialised, but the kept nodes are relinked only when
+   * the next kept node (or the end of the list) is reached.
+   *
+   * For lists with generation-stamped nodes, the nodes are
+   * unlinked one by one.
+   */
+  template <class T, class L, class S>
+  template <class P, class D>
+  std::size_t
+  double_list<T, L, S>::remove_nodes_if_ (P&& pred, D&& disposer)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::remove_if, &links_, nullptr);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
+
+    std::size_t count = 0;
+    double_list_links_base* const head_node = &links_;
+    double_list_links_base* kept = head_node;
+
+    double_list_links_base* node = links_.next ();
+    while (node != head_node)
+      {
+        double_list_links_base* next = node->next ();
+        auto element = static_cast<iterator_pointer> (node);
+
+        if (pred ((kept == head_node)
+                      ? nullptr
+                      : static_cast<iterator_pointer> (kept),
+                  element))
+          {
+            if constexpr (std::is_base_of<generation_double_list_links,
+                                          L>::value)
+              {
+                element->unlink ();
+              }
+            else
+              {
+                node->initialize ();
+              }
+            this->on_unlink_ (element);
+            disposer (element);
+            ++count;
+          }
+        else
+          {
+            if constexpr (!std::is_base_of<generation_double_list_links,
+                                           L>::value)
+              {
+                if (kept->next () != node)
+                  {
+                    // Skip over the run of removed nodes.
+                    kept->next (node);
+                    node->previous (kept);
+                  }
+              }
+            kept = node;
+          }
+        node = next;
+      }
+
+    if constexpr (!std::is_base_of<generation_double_list_links, L>::value)
+      {
+        if (kept->next () != head_node)
+          {
+            kept->next (head_node);
+            head_node->previous (kept);
+          }
+      }
+
+    return count;
+  }
+
+  /**
+   * @details
+   * Each run of consecutive matching nodes is detached from this
+   * list and linked to the tail of the destination list, with
+   * six stores per run.
+   *
+   * For lists with generation-stamped nodes, the nodes are moved
+   * one by one, to also stamp them.
+   */
+  template <class T, class L, class S>
+  template <class P>
+  std::size_t
+  double_list<T, L, S>::partition_nodes_ (P&& pred, double_list& out)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::partition, &links_,
+                         &out.links_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p\n", __func__, this);
+#endif
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+        assert (!out.links_.uninitialized ());
+      }
+
+    assert (&out != this);
+
+    std::size_t count = 0;
+    double_list_links_base* const head_node = &links_;
+
+    double_list_links_base* node = links_.next ();
+    while (node != head_node)
+      {
+        if (!pred (static_cast<iterator_pointer> (node)))
+          {
+            node = node->next ();
+            continue;
+          }
+
+        if constexpr (std::is_base_of<generation_double_list_links,
+                                      L>::value)
+          {
+            double_list_links_base* next = node->next ();
+            auto element = static_cast<iterator_pointer> (node);
+            this->on_unlink_ (element);
+            element->unlink ();
+            out.link_tail (*element);
+            ++count;
+            node = next;
+          }
+        else
+          {
+            double_list_links_base* first = node;
+            double_list_links_base* last;
+            do
+              {
+                last = node;
+                this->on_unlink_ (static_cast<iterator_pointer> (last));
+                out.on_link_ (static_cast<iterator_pointer> (last));
+                node = node->next ();
+                ++count;
+              }
+            while (node != head_node
+                   && pred (static_cast<iterator_pointer> (node)));
+
+            // Detach the run.
+            double_list_links_base* before = first->previous ();
+            before->next (node);
+            node->previous (before);
+
+            // Link the run to the destination tail.
+            double_list_links_base* out_tail = out.links_.previous ();
+            out_tail->next (first);
+            first->previous (out_tail);
+            last->next (&out.links_);
+            out.links_.previous (last);
+          }
+      }
+
+    return count;
+  }
+
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::splice_nodes_ (double_list_links_base* position,
+                                       double_list_links_base* first,
+                                       double_list_links_base* last)
+  {
+    if (first == last)
+      {
+        return;
+      }
+
+    if constexpr (std::is_base_of<generation_double_list_links, L>::value)
+      {
+        double_list_links_base* node = first;
+        while (node != last)
+          {
+            double_list_links_base* next = node->next ();
+            auto element = static_cast<iterator_pointer> (node);
+            element->unlink ();
+            static_cast<generation_double_list_links*> (
+                position->previous ())
+                ->link_next (element);
+            node = next;
+          }
+      }
+    else
+      {
+        double_list_links_base* before_first = first->previous ();
+        double_list_links_base* last_node = last->previous ();
+
+        // Detach the range.
+        before_first->next (last);
+        last->previous (before_first);
+
+        // Link the range before the position.
+        double_list_links_base* before = position->previous ();
+        before->next (first);
+        first->previous (before);
+        last_node->next (position);
+        position->previous (last_node);
+      }
+  }
+
+  /**
+   * @details
+   * The range is walked only if the statistics are enabled.
+   */
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::stats_link_range_ (
+      [[maybe_unused]] double_list_links_base* first,
+      [[maybe_unused]] double_list_links_base* last)
+  {
+    if constexpr (S::enabled)
+      {
+        for (double_list_links_base* node = first; node != last;
+             node = node->next ())
+          {
+            this->on_link_ (static_cast<iterator_pointer> (node));
+          }
+      }
+  }
+
+  template <class T, class L, class S>
+  bool
+  double_list<T, L, S>::validate_ (std::size_t& size) const
+  {
+    size = 0;
+    if constexpr (is_statically_allocated::value)
+      {
+        if (links_.uninitialized ())
+          {
+            return true;
+          }
+      }
+
+    const double_list_links_base* const head_node = &links_;
+    const double_list_links_base* previous = head_node;
+    const double_list_links_base* node = links_.next ();
+    while (node != head_node)
+      {
+        if (node == nullptr || node->previous () != previous)
+          {
+            return false;
+          }
+        previous = node;
+        node = node->next ();
+        ++size;
+      }
+
+    return links_.previous () == previous;
+  }
+
+  template <class T, class L, class S>
+  void
+  double_list<T, L, S>::stats_unlink_range_ (
+      [[maybe_unused]] double_list_links_base* first,
+      [[maybe_unused]] double_list_links_base* last)
+  {
+    if constexpr (S::enabled)
+      {
+        for (double_list_links_base* node = first; node != last;
+             node = node->next ())
+          {
+            this->on_unlink_ (static_cast<iterator_pointer> (node));
+          }
+      }
+  }
+
+  template <class T, class L, class S>
+  typename double_list<T, L, S>::iterator
+  double_list<T, L, S>::begin () const
+  {
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!links_.uninitialized ());
+      }
+
+    this->on_iterate_ ();
+    return iterator{ static_cast<iterator_pointer> (links_.next ()) };
+  }
+
+  template <class T, class L, class S>
+  typename double_list<T, L, S>::iterator
+  double_list<T, L, S>::end () const
+  {
+    // The assert would probably be redundant, since it was
+    // already tested in `begin()`.
+
+    return iterator{ reinterpret_cast<iterator_pointer> (
+        const_cast<links_type*> (&links_)) };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::const_iterator
+  double_list<T, L, S>::cbegin () const
+  {
+    return const_iterator{ begin () };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::const_iterator
+  double_list<T, L, S>::cend () const
+  {
+    return const_iterator{ end () };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::reverse_iterator
+  double_list<T, L, S>::rbegin () const
+  {
+    this->on_iterate_ ();
+    return reverse_iterator{ end () };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::reverse_iterator
+  double_list<T, L, S>::rend () const
+  {
+    // Not `begin()`, the iteration is counted by `rbegin()`.
+    return reverse_iterator{ iterator{ static_cast<iterator_pointer> (
+        links_.next ()) } };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::const_reverse_iterator
+  double_list<T, L, S>::crbegin () const
+  {
+    this->on_iterate_ ();
+    return const_reverse_iterator{ cend () };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::const_reverse_iterator
+  double_list<T, L, S>::crend () const
+  {
+    return const_reverse_iterator{ const_iterator{ rend ().base () } };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::safe_iterator
+  double_list<T, L, S>::safe_begin () const
+  {
+    return safe_iterator{ begin (), end () };
+  }
+
+  template <class T, class L, class S>
+  inline typename double_list<T, L, S>::safe_iterator
+  double_list<T, L, S>::safe_end () const
+  {
+    return safe_iterator{ end (), end () };
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, class U>
+  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator ()
+      : node_{}
+  {
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator (
+      N* const node)
+      : node_{ node }
+  {
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator (
+      reference element)
+      : node_{ const_cast<N*> (&(element.*MP)) }
+  {
+    static_assert (std::is_convertible<U*, const T*>::value == true,
+                   "U must be implicitly convertible to T!");
+  }
+
+  /**
+   * @details
+   * Allows passing a plain iterator where a constant one is expected,
+   * like `std::list` does.
+   */
+  template <class T, class N, N T::*MP, class U>
+  template <class V>
+    requires std::is_same<const V, U>::value
+  constexpr intrusive_list_iterator<T, N, MP, U>::intrusive_list_iterator (
+      const intrusive_list_iterator<T, N, MP, V>& other)
+      : node_{ other.get_iterator_pointer () }
+  {
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename intrusive_list_iterator<T, N, MP, U>::pointer
+  intrusive_list_iterator<T, N, MP, U>::operator->() const
+  {
+    return get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename intrusive_list_iterator<T, N, MP, U>::reference
+  intrusive_list_iterator<T, N, MP, U>::operator* () const
+  {
+    return *get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline intrusive_list_iterator<T, N, MP, U>&
+  intrusive_list_iterator<T, N, MP, U>::operator++ ()
+  {
+    node_ = static_cast<iterator_pointer> (node_->next ());
+    return *this;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline intrusive_list_iterator<T, N, MP, U>
+  intrusive_list_iterator<T, N, MP, U>::operator++ (int)
+  {
+    const auto tmp = *this;
+    node_ = static_cast<iterator_pointer> (node_->next ());
+    return tmp;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline intrusive_list_iterator<T, N, MP, U>&
+  intrusive_list_iterator<T, N, MP, U>::operator-- ()
+  {
+    node_ = static_cast<iterator_pointer> (node_->previous ());
+    return *this;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  intrusive_list_iterator<T, N, MP, U>
+  intrusive_list_iterator<T, N, MP, U>::operator-- (int)
+  {
+    const auto tmp = *this;
+    node_ = static_cast<iterator_pointer> (node_->previous ());
+    return tmp;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline bool
+  intrusive_list_iterator<T, N, MP, U>::operator== (
+      const intrusive_list_iterator& other) const
+  {
+    return node_ == other.node_;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline bool
+  intrusive_list_iterator<T, N, MP, U>::operator!= (
+      const intrusive_list_iterator& other) const
+  {
+    return node_ != other.node_;
+  }
+
+  template <class T, class N, N T::*MP, class U>
+  inline typename intrusive_list_iterator<T, N, MP, U>::pointer
   intrusive_list_iterator<T, N, MP, U>::get_pointer (void) const
   {
     // static_assert(std::is_convertible<U, T>::value == true, "U must be
@@ -554,13 +1710,13 @@ namespace micro_os_plus::utils
 
   // ==========================================================================
 
-  template <class T, class N, N T::*MP, class L, class U>
-  constexpr intrusive_list<T, N, MP, L, U>::intrusive_list ()
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  constexpr intrusive_list<T, N, MP, L, U, S>::intrusive_list ()
   {
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
-  constexpr intrusive_list<T, N, MP, L, U>::~intrusive_list ()
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  constexpr intrusive_list<T, N, MP, L, U, S>::~intrusive_list ()
   {
   }
 
@@ -577,23 +1733,23 @@ namespace micro_os_plus::utils
    * Must be manually called for statically allocated list before
    * inserting elements, or any other operations.
    */
-  template <class T, class N, N T::*MP, class L, class U>
+  template <class T, class N, N T::*MP, class L, class U, class S>
   void
-  intrusive_list<T, N, MP, L, U>::initialize_once (void)
+  intrusive_list<T, N, MP, L, U, S>::initialize_once (void)
   {
-    return double_list<N, L>::initialize_once ();
+    return double_list<N, L, S>::initialize_once ();
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
+  template <class T, class N, N T::*MP, class L, class U, class S>
   constexpr bool
-  intrusive_list<T, N, MP, L, U>::empty (void) const
+  intrusive_list<T, N, MP, L, U, S>::empty (void) const
   {
-    return double_list<N, L>::empty ();
+    return double_list<N, L, S>::empty ();
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
+  template <class T, class N, N T::*MP, class L, class U, class S>
   void
-  intrusive_list<T, N, MP, L, U>::link_tail (U& node)
+  intrusive_list<T, N, MP, L, U, S>::link_tail (U& node)
   {
     // The assert(links_.initialised()) is checked by the L class.
 
@@ -602,15 +1758,17 @@ namespace micro_os_plus::utils
     const auto offset = reinterpret_cast<difference_type> (
         &(static_cast<T*> (nullptr)->*MP));
 
+    N* const links = reinterpret_cast<N*> (
+        reinterpret_cast<difference_type> (&node) + offset);
+
     // Add thread intrusive node at the end of the list.
-    (const_cast<N*> (double_list<N, L>::tail ()))
-        ->link_next (reinterpret_cast<N*> (
-            reinterpret_cast<difference_type> (&node) + offset));
+    (const_cast<N*> (double_list<N, L, S>::tail ()))->link_next (links);
+    this->on_link_ (links);
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
+  template <class T, class N, N T::*MP, class L, class U, class S>
   void
-  intrusive_list<T, N, MP, L, U>::link_head (U& node)
+  intrusive_list<T, N, MP, L, U, S>::link_head (U& node)
   {
     // The assert(links_.initialised()) is checked by the L class.
 
@@ -619,10 +1777,118 @@ namespace micro_os_plus::utils
     const auto offset = reinterpret_cast<difference_type> (
         &(static_cast<T*> (nullptr)->*MP));
 
+    N* const links = reinterpret_cast<N*> (
+        reinterpret_cast<difference_type> (&node) + offset);
+
     // Add thread intrusive node at the end of the list.
-    (const_cast<N*> (double_list<N, L>::head ()))
-        ->link_previous (reinterpret_cast<N*> (
-            reinterpret_cast<difference_type> (&node) + offset));
+    (const_cast<N*> (double_list<N, L, S>::head ()))->link_previous (links);
+    this->on_link_ (links);
+  }
+
+  /**
+   * @details
+   * For statically allocated lists, the list is also initialised,
+   * if needed, so registrars need no separate initialisation.
+   *
+   * The operation is serialised with the other concurrent
+   * operations by a global spin lock; the list must not be
+   * changed concurrently by other means, except by
+   * `initialize_once()`, which may run concurrently.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  void
+  intrusive_list<T, N, MP, L, U, S>::link_tail_concurrent (reference node)
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<difference_type> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    N* const links = reinterpret_cast<N*> (
+        reinterpret_cast<difference_type> (&node) + offset);
+
+    double_list<N, L, S>::link_tail_concurrent (*links);
+  }
+
+  /**
+   * @details
+   * The nodes are chained among themselves, and the chain is
+   * linked to the list tail at the end, with only one update
+   * of the list links.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class I>
+  void
+  intrusive_list<T, N, MP, L, U, S>::link_tail_range (I first, I last)
+  {
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!this->uninitialized ());
+      }
+
+    double_list<N, L, S>::link_range_after_ (
+        double_list<N, L, S>::links_.previous (), first, last,
+        [] (reference element) -> double_list_links_base* {
+          return get_node (element);
+        });
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class R>
+  void
+  intrusive_list<T, N, MP, L, U, S>::link_tail_range (R&& range)
+  {
+    link_tail_range (std::begin (range), std::end (range));
+  }
+
+  /**
+   * @details
+   * The nodes are chained among themselves, and the chain is
+   * linked to the list head at the end, with only one update
+   * of the list links. The first element in the range becomes
+   * the list head.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class I>
+  void
+  intrusive_list<T, N, MP, L, U, S>::link_head_range (I first, I last)
+  {
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!this->uninitialized ());
+      }
+
+    double_list<N, L, S>::link_range_after_ (
+        &(double_list<N, L, S>::links_), first, last,
+        [] (reference element) -> double_list_links_base* {
+          return get_node (element);
+        });
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class R>
+  void
+  intrusive_list<T, N, MP, L, U, S>::link_head_range (R&& range)
+  {
+    link_head_range (std::begin (range), std::end (range));
+  }
+
+  /**
+   * @details
+   * This is the same as unlinking the intrusive node of the
+   * element, but it also updates the list statistics; nodes
+   * which are not linked are not counted.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  void
+  intrusive_list<T, N, MP, L, U, S>::unlink (reference node)
+  {
+    iterator_pointer links = get_node (node);
+    if (links->linked ())
+      {
+        this->on_unlink_ (links);
+      }
+    links->unlink ();
   }
 
 #if defined(__GNUC__)
@@ -630,35 +1896,96 @@ namespace micro_os_plus::utils
 #pragma GCC diagnostic ignored "-Waggregate-return"
 #endif
 
-  template <class T, class N, N T::*MP, class L, class U>
-  inline typename intrusive_list<T, N, MP, L, U>::iterator
-  intrusive_list<T, N, MP, L, U>::begin () const
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::iterator
+  intrusive_list<T, N, MP, L, U, S>::begin () const
   {
     // The assert(links_.initialised()) is checked by the L class.
 
+    this->on_iterate_ ();
     return iterator{ static_cast<iterator_pointer> (
-        double_list<N, L>::links_.next ()) };
+        double_list<N, L, S>::links_.next ()) };
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
-  inline typename intrusive_list<T, N, MP, L, U>::iterator
-  intrusive_list<T, N, MP, L, U>::end () const
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::iterator
+  intrusive_list<T, N, MP, L, U, S>::end () const
   {
     // The assert would probably be redundant, since it was
     // already tested in `begin()`.
 
-    using head_type_ = typename double_list<N, L>::links_type;
+    using head_type_ = typename double_list<N, L, S>::links_type;
     return iterator{ reinterpret_cast<iterator_pointer> (
-        const_cast<head_type_*> (double_list<N, L>::links_pointer ())) };
+        const_cast<head_type_*> (double_list<N, L, S>::links_pointer ())) };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::const_iterator
+  intrusive_list<T, N, MP, L, U, S>::cbegin () const
+  {
+    return const_iterator{ begin () };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::const_iterator
+  intrusive_list<T, N, MP, L, U, S>::cend () const
+  {
+    return const_iterator{ end () };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::reverse_iterator
+  intrusive_list<T, N, MP, L, U, S>::rbegin () const
+  {
+    this->on_iterate_ ();
+    return reverse_iterator{ end () };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::reverse_iterator
+  intrusive_list<T, N, MP, L, U, S>::rend () const
+  {
+    // Not `begin()`, the iteration is counted by `rbegin()`.
+    return reverse_iterator{ iterator{ static_cast<iterator_pointer> (
+        double_list<N, L, S>::links_.next ()) } };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::const_reverse_iterator
+  intrusive_list<T, N, MP, L, U, S>::crbegin () const
+  {
+    this->on_iterate_ ();
+    return const_reverse_iterator{ cend () };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::const_reverse_iterator
+  intrusive_list<T, N, MP, L, U, S>::crend () const
+  {
+    return const_reverse_iterator{ const_iterator{ rend ().base () } };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::safe_iterator
+  intrusive_list<T, N, MP, L, U, S>::safe_begin () const
+  {
+    return safe_iterator{ begin (), end () };
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::safe_iterator
+  intrusive_list<T, N, MP, L, U, S>::safe_end () const
+  {
+    return safe_iterator{ end (), end () };
   }
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
 
-  template <class T, class N, N T::*MP, class L, class U>
-  inline typename intrusive_list<T, N, MP, L, U>::pointer
-  intrusive_list<T, N, MP, L, U>::get_pointer (iterator_pointer node) const
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::pointer
+  intrusive_list<T, N, MP, L, U, S>::get_pointer (iterator_pointer node) const
   {
     // static_assert(std::is_convertible<U, T>::value == true, "U must be
     // implicitly convertible to T!");
@@ -674,29 +2001,225 @@ namespace micro_os_plus::utils
                                       - offset);
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
-  typename intrusive_list<T, N, MP, L, U>::pointer
-  intrusive_list<T, N, MP, L, U>::unlink_head (void)
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline typename intrusive_list<T, N, MP, L, U, S>::iterator_pointer
+  intrusive_list<T, N, MP, L, U, S>::get_node (reference element)
+  {
+    return &(element.*MP);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  typename intrusive_list<T, N, MP, L, U, S>::pointer
+  intrusive_list<T, N, MP, L, U, S>::unlink_head (void)
   {
     // No assert here, treat empty link unlinks as nop.
 
     // The first element in the list.
     iterator_pointer it
-        = static_cast<iterator_pointer> (double_list<N, L>::links_.next ());
+        = static_cast<iterator_pointer> (double_list<N, L, S>::links_.next ());
+    if constexpr (S::enabled)
+      {
+        if (!empty ())
+          {
+            this->on_unlink_ (it);
+          }
+      }
     it->unlink ();
 
     return get_pointer (it);
   }
 
-  template <class T, class N, N T::*MP, class L, class U>
-  typename intrusive_list<T, N, MP, L, U>::pointer
-  intrusive_list<T, N, MP, L, U>::unlink_tail (void)
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class P>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::remove_if (P&& pred)
+  {
+    return remove_if (std::forward<P> (pred), [] (reference) {});
+  }
+
+  /**
+   * @details
+   * The list is traversed once; the links of the kept elements are
+   * updated once for each run of removed elements, not once for
+   * each removed element.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class P, class D>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::remove_if (P&& pred, D&& disposer)
+  {
+    return double_list<N, L, S>::remove_nodes_if_ (
+        [this, &pred] (iterator_pointer, iterator_pointer node) -> bool {
+          return pred (*get_pointer (node));
+        },
+        [this, &disposer] (iterator_pointer node) {
+          disposer (*get_pointer (node));
+        });
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class E>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::unique (E&& eq)
+  {
+    return unique (std::forward<E> (eq), [] (reference) {});
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class E, class D>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::unique (E&& eq, D&& disposer)
+  {
+    return double_list<N, L, S>::remove_nodes_if_ (
+        [this, &eq] (iterator_pointer kept, iterator_pointer node) -> bool {
+          return kept != nullptr
+                 && eq (*get_pointer (kept), *get_pointer (node));
+        },
+        [this, &disposer] (iterator_pointer node) {
+          disposer (*get_pointer (node));
+        });
+  }
+
+  /**
+   * @details
+   * Runs of consecutive matching elements are moved with a single
+   * splice; the relative order is preserved in both lists.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class P>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::partition (P&& pred, intrusive_list& out)
+  {
+    return double_list<N, L, S>::partition_nodes_ (
+        [this, &pred] (iterator_pointer node) -> bool {
+          return pred (*get_pointer (node));
+        },
+        out);
+  }
+
+  /**
+   * @details
+   * Since the elements are spliced, the partition is always stable;
+   * this is the same as `partition()`.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class P>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::stable_partition (P&& pred,
+                                                       intrusive_list& out)
+  {
+    return partition (std::forward<P> (pred), out);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  void
+  intrusive_list<T, N, MP, L, U, S>::splice (iterator position,
+                                             intrusive_list& other,
+                                             iterator first, iterator last)
+  {
+    if constexpr (is_statically_allocated::value)
+      {
+        assert (!this->uninitialized ());
+        assert (!other.uninitialized ());
+      }
+
+    if (&other != this)
+      {
+        other.stats_unlink_range_ (first.get_iterator_pointer (),
+                                   last.get_iterator_pointer ());
+        this->stats_link_range_ (first.get_iterator_pointer (),
+                                 last.get_iterator_pointer ());
+      }
+
+    double_list<N, L, S>::splice_nodes_ (position.get_iterator_pointer (),
+                                         first.get_iterator_pointer (),
+                                         last.get_iterator_pointer ());
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline void
+  intrusive_list<T, N, MP, L, U, S>::take_all (intrusive_list& out)
+  {
+    double_list<N, L, S>::take_all (out);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class Lock>
+  inline void
+  intrusive_list<T, N, MP, L, U, S>::take_all (intrusive_list& out, Lock& lock)
+  {
+    double_list<N, L, S>::take_all (out, lock);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  inline void
+  intrusive_list<T, N, MP, L, U, S>::exchange (intrusive_list& other)
+  {
+    double_list<N, L, S>::exchange (other);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class Lock>
+  inline void
+  intrusive_list<T, N, MP, L, U, S>::exchange (intrusive_list& other,
+                                               Lock& lock)
+  {
+    double_list<N, L, S>::exchange (other, lock);
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class F>
+  void
+  intrusive_list<T, N, MP, L, U, S>::for_each_safe (F&& function)
+  {
+    for (auto it = safe_begin (), last = safe_end (); it != last; ++it)
+      {
+        function (*it);
+      }
+  }
+
+  /**
+   * @details
+   * The elements are unlinked one by one, so the list is consistent
+   * when the function is called; the function may, for example,
+   * link the element into another list.
+   */
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  template <class P, class F>
+  std::size_t
+  intrusive_list<T, N, MP, L, U, S>::drain_if (P&& pred, F&& function)
+  {
+    std::size_t count = 0;
+    for (auto it = safe_begin (), last = safe_end (); it != last; ++it)
+      {
+        reference element = *it;
+        if (pred (element))
+          {
+            this->on_unlink_ (get_node (element));
+            get_node (element)->unlink ();
+            function (element);
+            ++count;
+          }
+      }
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, class L, class U, class S>
+  typename intrusive_list<T, N, MP, L, U, S>::pointer
+  intrusive_list<T, N, MP, L, U, S>::unlink_tail (void)
   {
     // No assert here, treat empty link unlinks as nop.
 
     // The last element in the list.
     iterator_pointer it = static_cast<iterator_pointer> (
-        double_list<N, L>::links_.previous ());
+        double_list<N, L, S>::links_.previous ());
+    if constexpr (S::enabled)
+      {
+        if (!empty ())
+          {
+            this->on_unlink_ (it);
+          }
+      }
     it->unlink ();
 
     return get_pointer (it);
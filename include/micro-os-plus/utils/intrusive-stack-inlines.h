@@ -0,0 +1,419 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP>
+  constexpr intrusive_chain_iterator<T, N, MP>::intrusive_chain_iterator ()
+      : node_{}
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr intrusive_chain_iterator<T, N, MP>::intrusive_chain_iterator (
+      double_list_links_base* node)
+      : node_{ node }
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain_iterator<T, N, MP>::pointer
+  intrusive_chain_iterator<T, N, MP>::operator->() const
+  {
+    return get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain_iterator<T, N, MP>::reference
+  intrusive_chain_iterator<T, N, MP>::operator* () const
+  {
+    return *get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  inline intrusive_chain_iterator<T, N, MP>&
+  intrusive_chain_iterator<T, N, MP>::operator++ ()
+  {
+    node_ = node_->next ();
+    return *this;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline intrusive_chain_iterator<T, N, MP>
+  intrusive_chain_iterator<T, N, MP>::operator++ (int)
+  {
+    const auto tmp = *this;
+    node_ = node_->next ();
+    return tmp;
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr bool
+  intrusive_chain_iterator<T, N, MP>::operator== (
+      const intrusive_chain_iterator& other) const
+  {
+    return node_ == other.node_;
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr bool
+  intrusive_chain_iterator<T, N, MP>::operator!= (
+      const intrusive_chain_iterator& other) const
+  {
+    return node_ != other.node_;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain_iterator<T, N, MP>::pointer
+  intrusive_chain_iterator<T, N, MP>::get_pointer (void) const
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<std::ptrdiff_t> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    // Compute the address of the object which includes the
+    // intrusive node, by adjusting down the node address.
+    return reinterpret_cast<pointer> (
+        reinterpret_cast<std::ptrdiff_t> (static_cast<N*> (node_)) - offset);
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP>
+  constexpr intrusive_chain<T, N, MP>::intrusive_chain (
+      double_list_links_base* first)
+      : first_{ first }
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr bool
+  intrusive_chain<T, N, MP>::empty (void) const
+  {
+    return first_ == nullptr;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain<T, N, MP>::pointer
+  intrusive_chain<T, N, MP>::front (void) const
+  {
+    if (first_ == nullptr)
+      {
+        return nullptr;
+      }
+    return begin ().get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain<T, N, MP>::iterator
+  intrusive_chain<T, N, MP>::begin () const
+  {
+    return iterator{ first_ };
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_chain<T, N, MP>::iterator
+  intrusive_chain<T, N, MP>::end () const
+  {
+    return iterator{ nullptr };
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP>
+  constexpr intrusive_stack<T, N, MP>::intrusive_stack ()
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr intrusive_stack<T, N, MP>::~intrusive_stack ()
+  {
+  }
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER)
+
+  template <class T, class N, N T::*MP>
+  inline double_list_links_base*
+  intrusive_stack<T, N, MP>::top_ (head_type head)
+  {
+    return reinterpret_cast<double_list_links_base*> (head & pointer_mask);
+  }
+
+  /**
+   * @details
+   * The tag is incremented modulo 2^16, in the upper bits.
+   *
+   * A pointer with any of the upper bits set (a tagged pointer, or
+   * an address beyond 48 bits) cannot be packed without corrupting
+   * the stack, so it aborts the program, also in release builds.
+   */
+  template <class T, class N, N T::*MP>
+  inline typename intrusive_stack<T, N, MP>::head_type
+  intrusive_stack<T, N, MP>::make_head_ (double_list_links_base* top,
+                                         head_type head, head_type increment)
+  {
+    const auto pointer = reinterpret_cast<head_type> (top);
+    if ((pointer & ~pointer_mask) != 0)
+      {
+        std::abort ();
+      }
+
+    return ((head & ~pointer_mask) + (increment << pointer_bits)) | pointer;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline bool
+  intrusive_stack<T, N, MP>::empty (void) const
+  {
+    return top_ (head_.load (std::memory_order_acquire)) == nullptr;
+  }
+
+  /**
+   * @details
+   * A push cannot suffer from ABA, so the tag is not changed.
+   */
+  template <class T, class N, N T::*MP>
+  void
+  intrusive_stack<T, N, MP>::push (reference element)
+  {
+    double_list_links_base* node = &(element.*MP);
+
+    head_type head = head_.load (std::memory_order_relaxed);
+    do
+      {
+        node->next (top_ (head), std::memory_order_relaxed);
+      }
+    while (!head_.compare_exchange_weak (head, make_head_ (node, head, 0),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+  }
+
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::pointer
+  intrusive_stack<T, N, MP>::pop (void)
+  {
+    head_type head = head_.load (std::memory_order_acquire);
+    while (top_ (head) != nullptr)
+      {
+        double_list_links_base* next
+            = top_ (head)->next (std::memory_order_relaxed);
+        if (head_.compare_exchange_weak (head, make_head_ (next, head, 1),
+                                         std::memory_order_acquire,
+                                         std::memory_order_acquire))
+          {
+            return intrusive_chain_iterator<T, N, MP>{ top_ (head) }
+                .get_pointer ();
+          }
+      }
+
+    return nullptr;
+  }
+
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::chain
+  intrusive_stack<T, N, MP>::pop_all (void)
+  {
+    head_type head = head_.load (std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak (head, make_head_ (nullptr, head, 1),
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed))
+      {
+        // Retry.
+      }
+
+    return chain{ top_ (head) };
+  }
+
+#elif defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_EXCLUSIVE_MONITOR)
+
+  template <class T, class N, N T::*MP>
+  inline bool
+  intrusive_stack<T, N, MP>::empty (void) const
+  {
+    return std::atomic_ref<double_list_links_base*>{
+      const_cast<double_list_links_base*&> (head_)
+    }.load (std::memory_order_acquire)
+           == nullptr;
+  }
+
+  template <class T, class N, N T::*MP>
+  void
+  intrusive_stack<T, N, MP>::push (reference element)
+  {
+    double_list_links_base* node = &(element.*MP);
+
+    std::atomic_ref<double_list_links_base*> head{ head_ };
+    double_list_links_base* top = head.load (std::memory_order_relaxed);
+    do
+      {
+        node->next (top, std::memory_order_relaxed);
+      }
+    while (!head.compare_exchange_weak (top, node, std::memory_order_release,
+                                        std::memory_order_relaxed));
+  }
+
+  /**
+   * @details
+   * The successor is read between the exclusive load and the
+   * exclusive store of the head; the store fails if the head was
+   * written in between, or if an exception occurred.
+   */
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::pointer
+  intrusive_stack<T, N, MP>::pop (void)
+  {
+    double_list_links_base* top;
+    std::uint32_t failed;
+    do
+      {
+        __asm__ volatile("ldrex %0, [%1]"
+                         : "=r"(top)
+                         : "r"(&head_)
+                         : "memory");
+        if (top == nullptr)
+          {
+            __asm__ volatile("clrex" : : : "memory");
+            return nullptr;
+          }
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        double_list_links_base* next = top->next (std::memory_order_relaxed);
+        __asm__ volatile("strex %0, %2, [%1]"
+                         : "=&r"(failed)
+                         : "r"(&head_), "r"(next)
+                         : "memory");
+      }
+    while (failed != 0);
+
+    return intrusive_chain_iterator<T, N, MP>{ top }.get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::chain
+  intrusive_stack<T, N, MP>::pop_all (void)
+  {
+    return chain{ std::atomic_ref<double_list_links_base*>{ head_ }.exchange (
+        nullptr, std::memory_order_acquire) };
+  }
+
+#else
+
+  template <class T, class N, N T::*MP>
+  inline bool
+  intrusive_stack<T, N, MP>::empty (void) const
+  {
+    return head_.load (std::memory_order_acquire).top == nullptr;
+  }
+
+  /**
+   * @details
+   * A push cannot suffer from ABA, so the tag is not changed.
+   */
+  template <class T, class N, N T::*MP>
+  void
+  intrusive_stack<T, N, MP>::push (reference element)
+  {
+    double_list_links_base* node = &(element.*MP);
+
+    head_type head = head_.load (std::memory_order_relaxed);
+    do
+      {
+        node->next (head.top, std::memory_order_relaxed);
+      }
+    while (!head_.compare_exchange_weak (head, head_type{ node, head.tag },
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+  }
+
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::pointer
+  intrusive_stack<T, N, MP>::pop (void)
+  {
+    head_type head = head_.load (std::memory_order_acquire);
+    while (head.top != nullptr)
+      {
+        double_list_links_base* next
+            = head.top->next (std::memory_order_relaxed);
+        if (head_.compare_exchange_weak (head,
+                                         head_type{ next, head.tag + 1 },
+                                         std::memory_order_acquire,
+                                         std::memory_order_acquire))
+          {
+            return intrusive_chain_iterator<T, N, MP>{ head.top }
+                .get_pointer ();
+          }
+      }
+
+    return nullptr;
+  }
+
+  template <class T, class N, N T::*MP>
+  typename intrusive_stack<T, N, MP>::chain
+  intrusive_stack<T, N, MP>::pop_all (void)
+  {
+    head_type head = head_.load (std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak (head,
+                                         head_type{ nullptr, head.tag + 1 },
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed))
+      {
+        // Retry.
+      }
+
+    return chain{ head.top };
+  }
+
+#endif
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,500 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Lock-free intrusive LIFO stacks (Treiber stacks).
+ *
+ * The elements are chained via the **next** pointer of the same
+ * intrusive links member used by the lists, so an element can be
+ * moved between stacks and lists without allocations.
+ *
+ * The classic problem of these stacks is ABA: a thread reads the top
+ * element and its successor, and, before its compare-and-swap, other
+ * threads pop the top, pop the successor and push the top back; the
+ * compare-and-swap succeeds and installs a stale successor. The head
+ * is protected in one of three ways:
+ *
+ * - `MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER`, the default on
+ *   x86-64: the user space addresses fit in 48 bits (Linux maps
+ *   higher addresses with 5-level paging only on request), so a
+ *   16-bit tag, incremented by each pop, is packed in the upper
+ *   bits of the head, and a single-word compare-and-swap is used;
+ *   a pointer that does not fit aborts the program, also in
+ *   release builds;
+ * - `MICRO_OS_PLUS_UTILS_LISTS_STACK_DOUBLE_WIDTH_CAS`, the default
+ *   on 32-bit cores with a 64-bit compare-and-swap (like ARMv7-A):
+ *   the head is a pointer/tag pair updated with a double-width
+ *   compare-and-swap, which must be lock-free (this is checked at
+ *   compile time, so libatomic is never used);
+ * - `MICRO_OS_PLUS_UTILS_LISTS_STACK_EXCLUSIVE_MONITOR`, for ARMv7-M
+ *   and ARMv8-M Mainline: `pop()` uses `ldrex/strex`; the exclusive
+ *   store fails if the head was written in between (or on any
+ *   exception), so no tag is needed.
+ *
+ * On the other cores (like AArch64 and RISC-V, where a double-width
+ * compare-and-swap needs libatomic, and the pointers may have more
+ * than 48 significant bits) no method is selected by default, and
+ * the stack is not available. The exclusive monitor method is not
+ * a default either, until it is built on the M-profile platforms;
+ * it can be selected explicitly.
+ *
+ * When a method is selected,
+ * `MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK` is defined.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_H_
+#define MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER) \
+    && !defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_EXCLUSIVE_MONITOR) \
+    && !defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_DOUBLE_WIDTH_CAS)
+#if defined(__x86_64__)
+#define MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER
+#elif defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8) && __SIZEOF_POINTER__ == 4
+#define MICRO_OS_PLUS_UTILS_LISTS_STACK_DOUBLE_WIDTH_CAS
+#endif
+#endif
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER) \
+    || defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_EXCLUSIVE_MONITOR) \
+    || defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_DOUBLE_WIDTH_CAS)
+#define MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK
+#endif
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a forward iterator over a chain
+   * of elements popped from a stack.
+   * @headerfile intrusive-stack.h <micro-os-plus/utils/intrusive-stack.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node.
+   * @tparam MP Name of the intrusive node member in object T.
+   *
+   * @details
+   * The chain is terminated by a null **next** pointer.
+   */
+  template <class T, class N, N T::*MP>
+  class intrusive_chain_iterator
+  {
+  public:
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of pointer difference.
+     */
+    using difference_type = ptrdiff_t;
+
+    /**
+     * @brief Category of iterator.
+     */
+    using iterator_category = std::forward_iterator_tag;
+
+    // ------------------------------------------------------------------------
+    constexpr intrusive_chain_iterator ();
+
+    constexpr explicit intrusive_chain_iterator (double_list_links_base* node);
+
+    /**
+     * @cond ignore
+     */
+
+    pointer
+    operator->() const;
+
+    reference
+    operator* () const;
+
+    intrusive_chain_iterator&
+    operator++ ();
+
+    intrusive_chain_iterator
+    operator++ (int);
+
+    constexpr bool
+    operator== (const intrusive_chain_iterator& other) const;
+
+    constexpr bool
+    operator!= (const intrusive_chain_iterator& other) const;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Get the object node from the intrusive node.
+     * @par Parameters
+     *  None.
+     * @return Pointer to object.
+     */
+    pointer
+    get_pointer (void) const;
+
+  protected:
+    /**
+     * @brief Pointer to intrusive node.
+     */
+    double_list_links_base* node_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a chain of elements popped from a stack.
+   * @headerfile intrusive-stack.h <micro-os-plus/utils/intrusive-stack.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node.
+   * @tparam MP Name of the intrusive node member in object T.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * free_list.link_tail_range (cache.pop_all ());
+   * @endcode
+   *
+   * @details
+   * A range, owned by the caller, that can be passed directly to the
+   * `link_tail_range()` and `link_head_range()` list functions, which
+   * link the whole chain with a single update of the list head.
+   */
+  template <class T, class N, N T::*MP>
+  class intrusive_chain
+  {
+  public:
+    /**
+     * @brief Type of iterator over the values.
+     */
+    using iterator = intrusive_chain_iterator<T, N, MP>;
+
+    /**
+     * @brief Type of pointer to object.
+     */
+    using pointer = typename iterator::pointer;
+
+    /**
+     * @brief Construct a chain.
+     * @param [in] first Pointer to the first node, or `nullptr`.
+     */
+    constexpr explicit intrusive_chain (double_list_links_base* first
+                                        = nullptr);
+
+    /**
+     * @brief Check if the chain is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The chain has no elements.
+     * @retval false The chain has at least one element.
+     */
+    constexpr bool
+    empty (void) const;
+
+    /**
+     * @brief Get the first element.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the first element, or `nullptr`.
+     */
+    pointer
+    front (void) const;
+
+    /**
+     * @brief Iterator begin.
+     * @return An iterator positioned at the first element.
+     */
+    iterator
+    begin () const;
+
+    /**
+     * @brief Iterator end.
+     * @return An iterator positioned after the last element.
+     */
+    iterator
+    end () const;
+
+  protected:
+    /**
+     * @brief Pointer to the first node.
+     */
+    double_list_links_base* first_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a lock-free intrusive LIFO stack.
+   * @headerfile intrusive-stack.h <micro-os-plus/utils/intrusive-stack.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::intrusive_stack<buffer, utils::double_list_links,
+   *     &buffer::links_> cache;
+   *
+   * cache.push (*b);
+   * buffer* p = cache.pop ();
+   * @endcode
+   *
+   * @details
+   * All functions can be called concurrently, from any thread.
+   *
+   * Only the **next** pointer of the links is used; while in the
+   * stack, the elements are not linked in any list.
+   *
+   * As for all Treiber stacks, `pop()` may read the links of an
+   * element just popped by another thread, so the elements must
+   * remain accessible while the stack is in use (like in object
+   * caches); if they are freed, use a reclamation scheme.
+   */
+  template <class T, class N, N T::*MP>
+  class intrusive_stack
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the chain returned by `pop_all()`.
+     */
+    using chain = intrusive_chain<T, N, MP>;
+
+    /**
+     * @brief Construct an empty stack.
+     */
+    constexpr intrusive_stack ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    intrusive_stack (const intrusive_stack&) = delete;
+    intrusive_stack (intrusive_stack&&) = delete;
+    intrusive_stack&
+    operator= (const intrusive_stack&)
+        = delete;
+    intrusive_stack&
+    operator= (intrusive_stack&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the stack.
+     */
+    constexpr ~intrusive_stack ();
+
+    /**
+     * @brief Check if the stack is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The stack has no elements.
+     * @retval false The stack has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Push an element on the stack.
+     * @param [in] element Reference to an element not in the stack.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    push (reference element);
+
+    /**
+     * @brief Pop the top element.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the element, or `nullptr` if the stack
+     *  was empty.
+     */
+    pointer
+    pop (void);
+
+    /**
+     * @brief Pop all elements, in O(1).
+     * @par Parameters
+     *  None.
+     * @return The chain of elements, from the top down.
+     */
+    chain
+    pop_all (void);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_TAGGED_POINTER)
+
+    /**
+     * @brief Type of the head, the top pointer and the tag.
+     */
+    using head_type = std::uintptr_t;
+
+    /**
+     * @brief The number of bits of the pointers.
+     */
+    static constexpr unsigned int pointer_bits = 48;
+
+    /**
+     * @brief Mask of the pointer bits.
+     */
+    static constexpr head_type pointer_mask
+        = (static_cast<head_type> (1) << pointer_bits) - 1;
+
+    /**
+     * @brief Get the top pointer from the head.
+     * @param [in] head The head.
+     * @return Pointer to the top node.
+     */
+    static double_list_links_base*
+    top_ (head_type head);
+
+    /**
+     * @brief Pack the top pointer and the tag of a head in a new head.
+     * @param [in] top Pointer to the top node.
+     * @param [in] head The head with the tag.
+     * @param [in] increment The value added to the tag.
+     * @return The new head.
+     */
+    static head_type
+    make_head_ (double_list_links_base* top, head_type head,
+                head_type increment);
+
+    /**
+     * @brief The head.
+     */
+    std::atomic<head_type> head_{ 0 };
+
+#elif defined(MICRO_OS_PLUS_UTILS_LISTS_STACK_EXCLUSIVE_MONITOR)
+
+    /**
+     * @brief The top node; accessed with exclusive loads and stores.
+     */
+    double_list_links_base* head_ = nullptr;
+
+#else
+
+    /**
+     * @brief Type of the head, the top pointer and the tag.
+     */
+    struct head_type
+    {
+      double_list_links_base* top;
+      std::uintptr_t tag;
+    };
+
+    static_assert (std::atomic<head_type>::is_always_lock_free,
+                   "The double-width compare-and-swap must be lock-free!");
+
+    /**
+     * @brief The head.
+     */
+    std::atomic<head_type> head_{ head_type{ nullptr, 0 } };
+
+#endif
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "intrusive-stack-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_INTRUSIVE_STACK_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,306 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_LIST_STATS_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_LIST_STATS_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  constexpr timestamped_double_list_links::timestamped_double_list_links ()
+  {
+  }
+
+  constexpr timestamped_double_list_links::~timestamped_double_list_links ()
+  {
+  }
+
+  constexpr timestamped_double_list_links::timestamp_type
+  timestamped_double_list_links::linked_at (void) const
+  {
+    return linked_at_;
+  }
+
+  constexpr void
+  timestamped_double_list_links::linked_at (timestamp_type timestamp)
+  {
+    linked_at_ = timestamp;
+  }
+
+  // ==========================================================================
+
+  inline list_stats::counter_type
+  list_stats::links (void) const
+  {
+    return load_ (links_count_);
+  }
+
+  inline list_stats::counter_type
+  list_stats::unlinks (void) const
+  {
+    return load_ (unlinks_count_);
+  }
+
+  inline list_stats::counter_type
+  list_stats::iterations (void) const
+  {
+    return load_ (iterations_count_);
+  }
+
+  inline list_stats::counter_type
+  list_stats::length (void) const
+  {
+    return load_ (length_);
+  }
+
+  inline list_stats::counter_type
+  list_stats::max_length (void) const
+  {
+    return load_ (max_length_);
+  }
+
+  inline const char*
+  list_stats::name (void) const
+  {
+    return name_;
+  }
+
+  inline void
+  list_stats::name (const char* name)
+  {
+    name_ = name;
+  }
+
+  /**
+   * @details
+   * The registry is walked with its lock held, which blocks only
+   * the construction and the destruction of other lists with
+   * statistics, not the list operations; the function must not
+   * construct or destroy lists with statistics itself.
+   */
+  template <class F>
+  void
+  list_stats::for_each (F&& function)
+  {
+    registry_guard guard;
+
+    if (registry_.uninitialized ())
+      {
+        return;
+      }
+
+    for (const list_stats& stats : registry_)
+      {
+        function (stats);
+      }
+  }
+
+  template <class N>
+  inline void
+  list_stats::on_link_ (N*)
+  {
+    increment_ (links_count_);
+    const counter_type length = increment_ (length_);
+    if (length > load_ (max_length_))
+      {
+        store_ (max_length_, length);
+      }
+  }
+
+  /**
+   * @details
+   * The length does not go below zero, even if the counters were
+   * reset or cleared while nodes were still linked.
+   */
+  template <class N>
+  inline void
+  list_stats::on_unlink_ (N*)
+  {
+    increment_ (unlinks_count_);
+    const counter_type length = load_ (length_);
+    if (length > 0)
+      {
+        store_ (length_, length - 1);
+      }
+  }
+
+  inline void
+  list_stats::on_unlink_all_ (void)
+  {
+    store_ (unlinks_count_, load_ (unlinks_count_) + load_ (length_));
+    store_ (length_, 0);
+  }
+
+  inline void
+  list_stats::on_iterate_ (void) const
+  {
+    increment_ (iterations_count_);
+  }
+
+  inline void
+  list_stats::on_clear_ (void)
+  {
+    store_ (length_, 0);
+  }
+
+  inline list_stats::counter_type
+  list_stats::load_ (const counter_type& counter)
+  {
+    // The counters are only written via atomic references, and
+    // the load does not modify them.
+    return std::atomic_ref<counter_type>{ const_cast<counter_type&> (
+                                              counter) }
+        .load (std::memory_order_relaxed);
+  }
+
+  inline void
+  list_stats::store_ (counter_type& counter, counter_type value)
+  {
+    std::atomic_ref<counter_type>{ counter }.store (
+        value, std::memory_order_relaxed);
+  }
+
+  inline list_stats::counter_type
+  list_stats::increment_ (counter_type& counter)
+  {
+    const counter_type value = load_ (counter) + 1;
+    store_ (counter, value);
+    return value;
+  }
+
+  // ==========================================================================
+
+  template <class C, std::size_t B>
+  list_residency_stats<C, B>::list_residency_stats (
+      bool statically_allocated)
+      : list_stats{ statically_allocated }
+  {
+    if (!statically_allocated)
+      {
+        for (auto& counter : residency_)
+          {
+            store_ (counter, 0);
+          }
+      }
+  }
+
+  template <class C, std::size_t B>
+  list_residency_stats<C, B>::~list_residency_stats ()
+  {
+  }
+
+  template <class C, std::size_t B>
+  list_stats::counter_type
+  list_residency_stats<C, B>::residency (std::size_t bucket) const
+  {
+    assert (bucket < B);
+    return load_ (residency_[bucket]);
+  }
+
+  template <class C, std::size_t B>
+  void
+  list_residency_stats<C, B>::reset (void)
+  {
+    list_stats::reset ();
+    for (auto& counter : residency_)
+      {
+        store_ (counter, 0);
+      }
+  }
+
+  template <class C, std::size_t B>
+  template <class N>
+  void
+  list_residency_stats<C, B>::on_link_ (N* node)
+  {
+    static_assert (
+        std::is_base_of<timestamped_double_list_links, N>::value == true,
+        "N must be derived from timestamped_double_list_links!");
+
+    list_stats::on_link_ (node);
+    node->linked_at (now_ ());
+  }
+
+  /**
+   * @details
+   * The bucket is the number of significant bits of the residency,
+   * so the histogram covers the whole clock range with a few
+   * counters, and the index is computed with a single instruction
+   * on most cores.
+   */
+  template <class C, std::size_t B>
+  template <class N>
+  void
+  list_residency_stats<C, B>::on_unlink_ (N* node)
+  {
+    static_assert (
+        std::is_base_of<timestamped_double_list_links, N>::value == true,
+        "N must be derived from timestamped_double_list_links!");
+
+    list_stats::on_unlink_ (node);
+
+    using timestamp_type = timestamped_double_list_links::timestamp_type;
+    const timestamp_type ticks = now_ () - node->linked_at ();
+
+    // The number of significant bits.
+    constexpr int digits = std::numeric_limits<timestamp_type>::digits;
+    std::size_t bucket
+        = static_cast<std::size_t> (digits - std::countl_zero (ticks));
+    if (bucket >= B)
+      {
+        bucket = B - 1;
+      }
+    increment_ (residency_[bucket]);
+  }
+
+  template <class C, std::size_t B>
+  inline timestamped_double_list_links::timestamp_type
+  list_residency_stats<C, B>::now_ (void)
+  {
+    return static_cast<timestamped_double_list_links::timestamp_type> (
+        C::now ().time_since_epoch ().count ());
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_LIST_STATS_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,622 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Statistics policies for the lists.
+ *
+ * Used as the last template parameter of `double_list` and
+ * `intrusive_list`, these classes count the operations, track the
+ * list length and, optionally, the time the nodes stay in the list.
+ *
+ * All instrumented lists are registered in a global registry,
+ * which can be enumerated to export the statistics.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_LIST_STATS_H_
+#define MICRO_OS_PLUS_UTILS_LIST_STATS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class for list nodes that remember when they were linked.
+   * @headerfile list-stats.h <micro-os-plus/utils/list-stats.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The timestamp is set by the `list_residency_stats` policy when
+   * the node is linked, and used when it is unlinked, to compute
+   * the time it stayed in the list.
+   */
+  class timestamped_double_list_links : public double_list_links
+  {
+  public:
+    /**
+     * @brief Type of the timestamps, in clock ticks.
+     */
+    using timestamp_type = std::uint64_t;
+
+    /**
+     * @brief Construct a list node (initialise the pointers).
+     */
+    constexpr timestamped_double_list_links ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    timestamped_double_list_links (const timestamped_double_list_links&)
+        = delete;
+    timestamped_double_list_links (timestamped_double_list_links&&) = delete;
+    timestamped_double_list_links&
+    operator= (const timestamped_double_list_links&)
+        = delete;
+    timestamped_double_list_links&
+    operator= (timestamped_double_list_links&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the node.
+     */
+    constexpr ~timestamped_double_list_links ();
+
+    /**
+     * @brief Get the moment when the node was linked.
+     * @par Parameters
+     *  None.
+     * @return The timestamp, in clock ticks.
+     */
+    constexpr timestamp_type
+    linked_at (void) const;
+
+    /**
+     * @brief Set the moment when the node was linked.
+     * @param [in] timestamp The timestamp, in clock ticks.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    linked_at (timestamp_type timestamp);
+
+  protected:
+    /**
+     * @brief The moment when the node was linked.
+     */
+    timestamp_type linked_at_ = 0;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A statistics policy with counters and the list length.
+   * @headerfile list-stats.h <micro-os-plus/utils/list-stats.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * using ready_list = utils::intrusive_list<
+   *     thread, utils::double_list_links, &thread::ready_links_,
+   *     utils::double_list_links, thread, utils::list_stats>;
+   *
+   * ready_list ready;
+   * ready.stats ().name ("ready");
+   *
+   * utils::list_stats::for_each ([] (const utils::list_stats& s) {
+   *   printf ("%s %zu %zu\n", s.name (), s.length (), s.max_length ());
+   * });
+   * @endcode
+   *
+   * @details
+   * The counters are updated by the list methods, with the same
+   * protection as the list; they are atomic only to allow other
+   * threads to read them while the list is in use, and are updated
+   * with relaxed loads and stores, not with read-modify-write
+   * instructions, so the overhead is a few memory accesses per
+   * operation.
+   *
+   * Each object registers itself when constructed, and unregisters
+   * when destroyed; the registry has its own lock, separate from
+   * the global lock of the concurrent list operations.
+   *
+   * For statically allocated lists, the constructor does not write
+   * the counters, which start as zero in the **bss** section, so
+   * the operations done by other static constructors before it
+   * are also counted.
+   */
+  class list_stats
+  {
+  public:
+    /**
+     * @brief Tell the lists that statistics are collected.
+     */
+    static constexpr bool enabled = true;
+
+    /**
+     * @brief Type of the counters.
+     */
+    using counter_type = std::size_t;
+
+    /**
+     * @brief Construct the statistics and register them.
+     * @param [in] statically_allocated True if the list is
+     *  statically allocated and the counters must be preserved.
+     */
+    explicit list_stats (bool statically_allocated);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    list_stats (const list_stats&) = delete;
+    list_stats (list_stats&&) = delete;
+    list_stats&
+    operator= (const list_stats&)
+        = delete;
+    list_stats&
+    operator= (list_stats&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Unregister and destruct the statistics.
+     */
+    ~list_stats ();
+
+    /**
+     * @brief Get the number of linked nodes.
+     * @par Parameters
+     *  None.
+     * @return The number of nodes linked since the last reset.
+     */
+    counter_type
+    links (void) const;
+
+    /**
+     * @brief Get the number of unlinked nodes.
+     * @par Parameters
+     *  None.
+     * @return The number of nodes unlinked since the last reset.
+     */
+    counter_type
+    unlinks (void) const;
+
+    /**
+     * @brief Get the number of iterations.
+     * @par Parameters
+     *  None.
+     * @return The number of iterations started since the last reset.
+     */
+    counter_type
+    iterations (void) const;
+
+    /**
+     * @brief Get the current length of the list.
+     * @par Parameters
+     *  None.
+     * @return The number of nodes in the list.
+     */
+    counter_type
+    length (void) const;
+
+    /**
+     * @brief Get the maximum length of the list.
+     * @par Parameters
+     *  None.
+     * @return The maximum number of nodes since the last reset.
+     */
+    counter_type
+    max_length (void) const;
+
+    /**
+     * @brief Get the name used to identify the list.
+     * @par Parameters
+     *  None.
+     * @return A pointer to a string, or `nullptr`.
+     */
+    const char*
+    name (void) const;
+
+    /**
+     * @brief Set the name used to identify the list.
+     * @param [in] name Pointer to a string with static storage.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    name (const char* name);
+
+    /**
+     * @brief Clear the counters.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * The maximum length restarts from the current length.
+     */
+    void
+    reset (void);
+
+    /**
+     * @brief Call a function for each registered statistics object.
+     * @tparam F Type of the function.
+     * @param [in] function Callable object called with a constant
+     *  reference to each `list_stats` object.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class F>
+    static void
+    for_each (F&& function);
+
+  protected:
+    /**
+     * @brief A scoped lock for the registry.
+     *
+     * @details
+     * On cores without atomic compare-and-swap it does nothing, and
+     * the registry must be used from critical sections.
+     */
+    class registry_guard
+    {
+    public:
+      /**
+       * @brief Acquire the registry lock.
+       */
+      registry_guard ();
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      registry_guard (const registry_guard&) = delete;
+      registry_guard (registry_guard&&) = delete;
+      registry_guard&
+      operator= (const registry_guard&)
+          = delete;
+      registry_guard&
+      operator= (registry_guard&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Release the registry lock.
+       */
+      ~registry_guard ();
+    };
+
+    /**
+     * @brief Count a linked node.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    void
+    on_link_ (N*);
+
+    /**
+     * @brief Count an unlinked node.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    void
+    on_unlink_ (N*);
+
+    /**
+     * @brief Count all nodes as unlinked, from the length.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    on_unlink_all_ (void);
+
+    /**
+     * @brief Count an iteration.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    on_iterate_ (void) const;
+
+    /**
+     * @brief Set the length to zero.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    on_clear_ (void);
+
+    /**
+     * @brief Read a counter.
+     * @param [in] counter Reference to the counter.
+     * @return The counter value.
+     */
+    static counter_type
+    load_ (const counter_type& counter);
+
+    /**
+     * @brief Write a counter.
+     * @param [in] counter Reference to the counter.
+     * @param [in] value The new value.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    store_ (counter_type& counter, counter_type value);
+
+    /**
+     * @brief Increment a counter, without read-modify-write.
+     * @param [in] counter Reference to the counter.
+     * @return The new value.
+     */
+    static counter_type
+    increment_ (counter_type& counter);
+
+    /**
+     * @brief The links in the registry.
+     */
+    double_list_links registry_links_;
+
+    /**
+     * @brief Type of the registry of all statistics objects.
+     */
+    using registry_type
+        = intrusive_list<list_stats, double_list_links,
+                         &list_stats::registry_links_,
+                         static_double_list_links>;
+
+    /**
+     * @brief The registry, statically allocated.
+     */
+    static registry_type registry_;
+
+    // The members below are intentionally not initialised here;
+    // for statically allocated lists they are already zero, and
+    // may have been updated by other static constructors.
+    // They are accessed via `std::atomic_ref`.
+
+    /**
+     * @brief The name of the list.
+     */
+    const char* name_;
+
+    /**
+     * @brief The number of linked nodes.
+     */
+    counter_type links_count_;
+
+    /**
+     * @brief The number of unlinked nodes.
+     */
+    counter_type unlinks_count_;
+
+    /**
+     * @brief The number of iterations.
+     */
+    mutable counter_type iterations_count_;
+
+    /**
+     * @brief The current length.
+     */
+    counter_type length_;
+
+    /**
+     * @brief The maximum length.
+     */
+    counter_type max_length_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A statistics policy that also measures how long the
+   * nodes stay in the list.
+   * @headerfile list-stats.h <micro-os-plus/utils/list-stats.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam C Type of the clock; it must have a static `now()`
+   *  returning a `std::chrono::time_point`.
+   * @tparam B Number of histogram buckets.
+   *
+   * @details
+   * When a node is linked, the clock is read and the timestamp is
+   * stored in the node, which must be derived from
+   * `timestamped_double_list_links`; when the node is unlinked, the
+   * time spent in the list is added to a histogram with logarithmic
+   * buckets: bucket 0 counts nodes unlinked in the same clock tick,
+   * and bucket `b` those which stayed between 2<sup>b-1</sup> and
+   * 2<sup>b</sup>-1 ticks; the last bucket also counts the longer
+   * residencies.
+   *
+   * Nodes moved to another list (by `splice()`, `take_all()`,
+   * `exchange()` or `partition()`) count as unlinked from this list,
+   * except those taken by `take_all()` with a lock, which keeps the
+   * lock only for constant time. Nodes abandoned by `clear()` are
+   * not counted.
+   *
+   * On embedded platforms, use a clock based on a cycle counter.
+   */
+  template <class C = std::chrono::steady_clock, std::size_t B = 32>
+  class list_residency_stats : public list_stats
+  {
+  public:
+    static_assert (B > 0, "At least one bucket is needed!");
+
+    /**
+     * @brief Type of the clock.
+     */
+    using clock_type = C;
+
+    /**
+     * @brief The number of histogram buckets.
+     */
+    static constexpr std::size_t buckets = B;
+
+    /**
+     * @brief Construct the statistics and register them.
+     * @param [in] statically_allocated True if the list is
+     *  statically allocated and the counters must be preserved.
+     */
+    explicit list_residency_stats (bool statically_allocated);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    list_residency_stats (const list_residency_stats&) = delete;
+    list_residency_stats (list_residency_stats&&) = delete;
+    list_residency_stats&
+    operator= (const list_residency_stats&)
+        = delete;
+    list_residency_stats&
+    operator= (list_residency_stats&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the statistics.
+     */
+    ~list_residency_stats ();
+
+    /**
+     * @brief Get the number of nodes in a histogram bucket.
+     * @param [in] bucket The bucket index, less than `buckets`.
+     * @return The number of nodes unlinked after a residency
+     *  in the bucket range.
+     */
+    counter_type
+    residency (std::size_t bucket) const;
+
+    /**
+     * @brief Clear the counters and the histogram.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    reset (void);
+
+  protected:
+    /**
+     * @brief Count a linked node and store the timestamp.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    void
+    on_link_ (N* node);
+
+    /**
+     * @brief Count an unlinked node and its residency.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    void
+    on_unlink_ (N* node);
+
+    /**
+     * @brief Read the clock.
+     * @par Parameters
+     *  None.
+     * @return The current time, in clock ticks.
+     */
+    static timestamped_double_list_links::timestamp_type
+    now_ (void);
+
+    /**
+     * @brief The histogram, not initialised here, like the counters.
+     */
+    counter_type residency_[B];
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "list-stats-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_LIST_STATS_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,444 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Binary recorder for the list operations.
+ *
+ * When `MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY` is defined, the hooks
+ * in the list hot paths (link, unlink, clear, and the bulk
+ * operations) store compact binary
+ * records in lock-free ring buffers, one per thread, instead of
+ * formatting the messages with `trace::printf()`; this changes the
+ * timing much less, so the tracing can be used to chase ordering
+ * problems.
+ *
+ * The rings are dumped in a binary format, to be decoded offline
+ * with `scripts/list-trace-decode.py`.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_LIST_TRACER_H_
+#define MICRO_OS_PLUS_UTILS_LIST_TRACER_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+
+// The number of ring buffers; the threads are assigned to them in
+// the order of their first record. Without an operating system
+// with threads, a single ring is used.
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_TRACE_RINGS)
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#define MICRO_OS_PLUS_UTILS_LISTS_TRACE_RINGS (8)
+#else
+#define MICRO_OS_PLUS_UTILS_LISTS_TRACE_RINGS (1)
+#endif
+#endif // !defined(MICRO_OS_PLUS_UTILS_LISTS_TRACE_RINGS)
+
+// The number of records in each ring; must be a power of 2.
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_TRACE_RING_SIZE)
+#define MICRO_OS_PLUS_UTILS_LISTS_TRACE_RING_SIZE (256)
+#endif // !defined(MICRO_OS_PLUS_UTILS_LISTS_TRACE_RING_SIZE)
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class with the binary recorder of the list operations.
+   * @headerfile list-tracer.h <micro-os-plus/utils/list-tracer.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * // After the interesting events, with the threads quiescent.
+   * FILE* f = fopen ("lists.trace", "wb");
+   * utils::list_tracer::dump ([&] (const void* data, std::size_t size) {
+   *   fwrite (data, 1, size, f);
+   * });
+   * fclose (f);
+   * @endcode
+   *
+   * @details
+   * The rings are statically allocated, and overwrite the oldest
+   * records when full (like a flight recorder). Writing a record
+   * takes one atomic increment and a few relaxed stores.
+   *
+   * The dump does not stop the writers. Each record has a sequence
+   * word, cleared before the fields are written and set with a
+   * release store after them; the dump checks it before and after
+   * copying the fields, and records being written or overwritten
+   * during the dump are replaced by records with operation 0.
+   *
+   * The bulk operations (like `splice()` or `reverse()`) are recorded
+   * with a single record, with the list links as the node and the
+   * other list links (if any) as the peer; the nodes they touch are
+   * not recorded one by one.
+   *
+   * The records include only addresses; to identify the lists and
+   * the elements, the application can log their addresses separately.
+   */
+  class list_tracer
+  {
+  public:
+    /**
+     * @brief The traced operations.
+     */
+    enum class operation : std::uint32_t
+    {
+      link_next = 1,
+      link_previous = 2,
+      unlink = 3,
+      clear = 4,
+      relink_moved = 5,
+      link_range = 6,
+      splice = 7,
+      take_all = 8,
+      exchange = 9,
+      remove_if = 10,
+      partition = 11,
+      reverse = 12
+    };
+
+    /**
+     * @brief A record in the ring.
+     *
+     * @details
+     * The fields are atomic, accessed with relaxed loads and stores,
+     * since they may be read by the dump while being written; the
+     * timestamp is split in two halves, to be lock free on 32-bit
+     * cores.
+     */
+    struct record_type
+    {
+      /**
+       * @brief The record number plus one, set after the other
+       * fields; zero while they are being written.
+       */
+      std::atomic<std::size_t> sequence;
+
+      /**
+       * @brief The moment of the operation, the low 32-bits.
+       */
+      std::atomic<std::uint32_t> timestamp_low;
+
+      /**
+       * @brief The moment of the operation, the high 32-bits.
+       */
+      std::atomic<std::uint32_t> timestamp_high;
+
+      /**
+       * @brief The node linked, unlinked, moved or cleared,
+       * or the links of the list, for the bulk operations.
+       */
+      std::atomic<const void*> node;
+
+      /**
+       * @brief The neighbour the node was linked to or unlinked
+       * from, the old location of a moved node, or the links of
+       * the other list, for the bulk operations.
+       */
+      std::atomic<const void*> peer;
+
+      /**
+       * @brief The operation.
+       */
+      std::atomic<operation> op;
+    };
+
+    /**
+     * @brief The header of the dump.
+     */
+    struct dump_header
+    {
+      /**
+       * @brief The `magic` value, also identifying the byte order.
+       */
+      std::uint32_t magic;
+
+      /**
+       * @brief The `version` value.
+       */
+      std::uint32_t version;
+
+      /**
+       * @brief The number of records following the header.
+       */
+      std::uint32_t records;
+
+      /**
+       * @brief The number of records overwritten before the dump.
+       */
+      std::uint32_t lost;
+    };
+
+    /**
+     * @brief A record in the dump, with fixed size fields.
+     */
+    struct dump_record
+    {
+      /**
+       * @brief The moment of the operation.
+       */
+      std::uint64_t timestamp;
+
+      /**
+       * @brief The address of the node.
+       */
+      std::uint64_t node;
+
+      /**
+       * @brief The address of the peer node.
+       */
+      std::uint64_t peer;
+
+      /**
+       * @brief The operation, or 0 if the record was being written
+       * or overwritten during the dump.
+       */
+      std::uint32_t op;
+
+      /**
+       * @brief The ring where the record was written (the thread).
+       */
+      std::uint32_t ring;
+    };
+
+    static_assert (sizeof (dump_header) == 16, "Unexpected header size!");
+    static_assert (sizeof (dump_record) == 32, "Unexpected record size!");
+
+    /**
+     * @brief The dump magic number ("LTRC" when read as bytes).
+     */
+    static constexpr std::uint32_t magic = 0x4352544c;
+
+    /**
+     * @brief The dump format version.
+     */
+    static constexpr std::uint32_t version = 2;
+
+    /**
+     * @brief The number of rings.
+     */
+    static constexpr std::size_t rings = MICRO_OS_PLUS_UTILS_LISTS_TRACE_RINGS;
+
+    /**
+     * @brief The number of records in each ring.
+     */
+    static constexpr std::size_t ring_size
+        = MICRO_OS_PLUS_UTILS_LISTS_TRACE_RING_SIZE;
+
+    static_assert ((ring_size & (ring_size - 1)) == 0,
+                   "The ring size must be a power of 2!");
+
+    /**
+     * @brief Type of the functions returning the timestamps.
+     */
+    using clock_function = std::uint64_t (*) (void);
+
+    /**
+     * @cond ignore
+     */
+
+    // Only static members.
+    list_tracer () = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Record an operation in the ring of the current thread.
+     * @param [in] op The operation.
+     * @param [in] node The address of the node.
+     * @param [in] peer The address of the peer node, or `nullptr`.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    record (operation op, const void* node, const void* peer);
+
+    /**
+     * @brief Set the function returning the timestamps.
+     * @param [in] clock The function, or `nullptr` for the default.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * By default, the timestamps are the nanoseconds of the monotonic
+     * clock on hosted platforms, and a sequence number elsewhere;
+     * on embedded devices, a cycle counter is a better choice.
+     */
+    static void
+    set_clock (clock_function clock);
+
+    /**
+     * @brief Discard all records.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    reset (void);
+
+    /**
+     * @brief Write the binary dump of all rings.
+     * @tparam W Type of the writer.
+     * @param [in] write Callable object called with a pointer to the
+     *  data and its size, in bytes.
+     * @return The number of dumped records.
+     *
+     * @details
+     * The dump is a `dump_header` followed by `dump_record`s, in
+     * the native byte order; the records of each ring are in
+     * chronological order.
+     */
+    template <class W>
+    static std::size_t
+    dump (W&& write);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief A ring buffer.
+     */
+    struct ring_type
+    {
+      /**
+       * @brief The number of records written since the reset.
+       */
+      std::atomic<std::size_t> head;
+
+      /**
+       * @brief The records.
+       */
+      record_type records[ring_size];
+    };
+
+    /**
+     * @brief The rings, statically allocated.
+     */
+    static ring_type rings_[rings];
+  };
+
+  // ==========================================================================
+
+  /**
+   * @details
+   * The rings are read without stopping the writers; the records
+   * are copied one by one to fixed size dump records.
+   *
+   * A record is valid if its sequence word is the expected one
+   * both before and after its fields are copied; otherwise it was
+   * being written, or it was overwritten by a newer one, and it is
+   * dumped with operation 0, to keep the count in the header.
+   */
+  template <class W>
+  std::size_t
+  list_tracer::dump (W&& write)
+  {
+    std::size_t heads[rings];
+    dump_header header = { magic, version, 0, 0 };
+    for (std::size_t i = 0; i < rings; ++i)
+      {
+        heads[i] = rings_[i].head.load (std::memory_order_acquire);
+        const std::size_t count
+            = (heads[i] < ring_size) ? heads[i] : ring_size;
+        header.records += static_cast<std::uint32_t> (count);
+        header.lost += static_cast<std::uint32_t> (heads[i] - count);
+      }
+
+    write (static_cast<const void*> (&header), sizeof (header));
+
+    for (std::size_t i = 0; i < rings; ++i)
+      {
+        const std::size_t count
+            = (heads[i] < ring_size) ? heads[i] : ring_size;
+        for (std::size_t n = heads[i] - count; n != heads[i]; ++n)
+          {
+            const record_type& r = rings_[i].records[n & (ring_size - 1)];
+
+            const std::size_t sequence
+                = r.sequence.load (std::memory_order_acquire);
+            dump_record out = {
+              (static_cast<std::uint64_t> (
+                   r.timestamp_high.load (std::memory_order_relaxed))
+               << 32)
+                  | r.timestamp_low.load (std::memory_order_relaxed),
+              reinterpret_cast<std::uintptr_t> (
+                  r.node.load (std::memory_order_relaxed)),
+              reinterpret_cast<std::uintptr_t> (
+                  r.peer.load (std::memory_order_relaxed)),
+              static_cast<std::uint32_t> (
+                  r.op.load (std::memory_order_relaxed)),
+              static_cast<std::uint32_t> (i)
+            };
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (sequence != n + 1
+                || r.sequence.load (std::memory_order_relaxed) != n + 1)
+              {
+                out = { 0, 0, 0, 0, static_cast<std::uint32_t> (i) };
+              }
+            write (static_cast<const void*> (&out), sizeof (out));
+          }
+      }
+
+    return header.records;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_LIST_TRACER_H_
+
+// ----------------------------------------------------------------------------
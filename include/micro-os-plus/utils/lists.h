@@ -54,7 +54,39 @@
 #include <cstdint>
 #include <cstddef>
 #include <cassert>
+#include <atomic>
 #include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+#include <micro-os-plus/utils/list-tracer.h>
+#endif
+
+// ----------------------------------------------------------------------------
+
+// Atomic compare-and-swap on pointers is available natively
+// (not on Cortex-M0/M0+ and similar cores).
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+#if (defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4) && __SIZEOF_POINTER__ == 4) \
+    || (defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8) && __SIZEOF_POINTER__ == 8)
+#define MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS (1)
+#endif
+#endif // !defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+// The size of the cache lines, used to separate the data written
+// by different cores.
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+#define MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE (32)
+#else
+#define MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE (64)
+#endif
+#endif // !defined(MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+
+// To check the neighbours of the nodes on every N-th link or unlink
+// operation, define MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING to N
+// (1 checks all operations); by default there are no checks.
 
 // ----------------------------------------------------------------------------
 
@@ -141,7 +173,8 @@ namespace micro_os_plus::utils
     initialize (void);
 
     /**
-     * @brief Initialize the list only at first run.
+     * @brief Initialize the list only at first run; safe to be
+     * called concurrently.
      * @par Parameters
      *  None.
      * @par Returns
@@ -170,6 +203,16 @@ namespace micro_os_plus::utils
     void
     link_previous (double_list_links_base* node);
 
+    /**
+     * @brief Link the new node as **previous**, concurrently with
+     * `initialize_once()`.
+     * @param [in] node Pointer to the node to link.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_previous_concurrent (double_list_links_base* node);
+
     /**
      * @brief Remove this node from the list.
      * @par Returns
@@ -186,6 +229,27 @@ namespace micro_os_plus::utils
     bool
     linked (void) const;
 
+    /**
+     * @brief Check if the neighbours point back to this node.
+     * @par Parameters
+     *  None.
+     * @retval true The **next** node points back to this node, and
+     *  so does the **previous** one.
+     * @retval false The links are corrupted (or not initialised).
+     */
+    bool
+    consistent (void) const;
+
+    /**
+     * @brief Take the place of a node in its list.
+     * @param [in] old_node Pointer to the node to replace; its
+     *  pointers are copied and its neighbours updated.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    relink_moved (const double_list_links_base* old_node);
+
     /**
      * @brief Get the link to the **next** node.
      * @retval Pointer to the next node.
@@ -200,6 +264,55 @@ namespace micro_os_plus::utils
     constexpr double_list_links_base*
     previous (void) const;
 
+    /**
+     * @brief Set the link to the **next** node.
+     * @param [in] node Pointer to the next node.
+     * @par Returns
+     *  Nothing.
+     *
+     * @warning
+     * Low level accessor, the neighbour is not updated.
+     */
+    constexpr void
+    next (double_list_links_base* node);
+
+    /**
+     * @brief Set the link to the **previous** node.
+     * @param [in] node Pointer to the previous node.
+     * @par Returns
+     *  Nothing.
+     *
+     * @warning
+     * Low level accessor, the neighbour is not updated.
+     */
+    constexpr void
+    previous (double_list_links_base* node);
+
+    /**
+     * @brief Atomically get the link to the **next** node.
+     * @param [in] order The memory order of the load.
+     * @return Pointer to the next node.
+     *
+     * @details
+     * Used by lock-free readers, concurrently with writers
+     * publishing the links with `next (node, order)`.
+     */
+    double_list_links_base*
+    next (std::memory_order order) const;
+
+    /**
+     * @brief Atomically set the link to the **next** node.
+     * @param [in] node Pointer to the next node.
+     * @param [in] order The memory order of the store.
+     * @par Returns
+     *  Nothing.
+     *
+     * @warning
+     * Low level accessor, the neighbour is not updated.
+     */
+    void
+    next (double_list_links_base* node, std::memory_order order);
+
   protected:
     /**
      * @brief Pointer to the **previous** node.
@@ -355,278 +468,1219 @@ namespace micro_os_plus::utils
 
   /**
    * @ingroup micro-os-plus-utils-lists-double-lists
-   * @brief A class template for a double linked list forward iterator.
+   * @brief A class for a scoped lock serialising the concurrent
+   * list operations.
    * @headerfile lists.h <micro-os-plus/utils/lists.h>
    * @ingroup micro-os-plus-utils
-   * @tparam T Type of object returned by the iterator.
-   * @tparam N Type of intrusive node. Must have the public members
-   * **previous** & **next**.
-   * @tparam U Type stored in the list, derived from T.
    *
    * @details
-   * This class provides an interface similar to `std::list::iterator`.
+   * All instances share a single global spin lock; it is intended
+   * for rare operations, like the registration of static objects
+   * from constructors running on different threads, not for
+   * frequent use.
    *
-   * In a common double linked list, all types are `double_list_links`.
+   * On cores without atomic compare-and-swap, the lock does nothing;
+   * on these cores, the concurrent operations must be called from
+   * a critical section.
    */
-  template <class T, class N = T, class U = T>
-  class double_list_iterator
+  class concurrent_links_guard
   {
   public:
     /**
-     * @brief Type of value "pointed to" by the iterator.
+     * @brief Acquire the lock.
      */
-    using value_type = U;
+    concurrent_links_guard ();
 
     /**
-     * @brief Type of pointer to object "pointed to" by the iterator.
+     * @cond ignore
      */
-    using pointer = value_type*;
+
+    // The rule of five.
+    concurrent_links_guard (const concurrent_links_guard&) = delete;
+    concurrent_links_guard (concurrent_links_guard&&) = delete;
+    concurrent_links_guard&
+    operator= (const concurrent_links_guard&)
+        = delete;
+    concurrent_links_guard&
+    operator= (concurrent_links_guard&&)
+        = delete;
 
     /**
-     * @brief Type of reference to object "pointed to" by the iterator.
+     * @endcond
      */
-    using reference = value_type&;
 
     /**
-     * @brief Type of reference to the iterator internal pointer.
+     * @brief Release the lock.
      */
-    using iterator_pointer = N*;
+    ~concurrent_links_guard ();
+  };
+
+  // ==========================================================================
 
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class with the integrity checks of the list links.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The asserts in the link and unlink operations only check for
+   * null pointers, and are disabled in release builds; a neighbour
+   * corrupted by a stray write goes unnoticed until a crash far
+   * away.
+   *
+   * When `MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING` is defined to N,
+   * every N-th link or unlink operation also checks that the
+   * neighbours of the node point back to it; a failed check calls
+   * the handler. The cost is a counter update per operation and
+   * two loads every N operations, so the checks can be left enabled
+   * in production builds. On hosted platforms the counter is per
+   * thread, thus the operations on different cores do not share
+   * its cache line.
+   *
+   * For a complete check of a list, use `double_list::validate()`.
+   */
+  class list_integrity
+  {
+  public:
     /**
-     * @brief Type of pointer difference.
+     * @brief Type of the functions called for corrupted nodes.
      */
-    using difference_type = ptrdiff_t;
+    using handler_function = void (*) (const double_list_links_base* node);
 
     /**
-     * @brief Category of iterator.
+     * @cond ignore
      */
-    using iterator_category = std::forward_iterator_tag;
-
-    // ------------------------------------------------------------------------
-    constexpr double_list_iterator ();
 
-    constexpr explicit double_list_iterator (iterator_pointer const node);
-
-    constexpr explicit double_list_iterator (reference element);
-
-    // DO NOT delete the copy constructors, since the default one are
-    // used.
-
-    constexpr pointer
-    operator->() const;
-
-    constexpr reference
-    operator* () const;
+    // Only static members.
+    list_integrity () = delete;
 
-    constexpr double_list_iterator&
-    operator++ ();
-
-    constexpr double_list_iterator
-    operator++ (int);
+    /**
+     * @endcond
+     */
 
-    constexpr double_list_iterator&
-    operator-- ();
+    /**
+     * @brief Set the function called for corrupted nodes.
+     * @param [in] handler The function, or `nullptr` for the default.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * The default handler prints a trace message and calls
+     * `abort()`; the application may install a handler that logs
+     * the error and resets the device, or throws an exception.
+     */
+    static void
+    set_handler (handler_function handler);
 
-    constexpr double_list_iterator
-    operator-- (int);
+    /**
+     * @brief Check the neighbours of a node, and call the handler
+     * if they are corrupted.
+     * @param [in] node Pointer to the node.
+     * @retval true The neighbours point back to the node.
+     * @retval false The links are corrupted (and the handler
+     *  returned).
+     */
+    static bool
+    check (const double_list_links_base* node);
 
-    constexpr bool
-    operator== (const double_list_iterator& other) const;
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
 
-    constexpr bool
-    operator!= (const double_list_iterator& other) const;
+    /**
+     * @brief Check one of every `sampling` nodes.
+     */
+    static constexpr std::uint32_t sampling
+        = MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING;
 
-    constexpr pointer
-    get_pointer () const;
+    static_assert (sampling > 0, "The sampling must be at least 1!");
 
-    constexpr iterator_pointer
-    get_iterator_pointer () const;
+    /**
+     * @brief Count an operation, and check the node if it is the
+     * N-th one.
+     * @param [in] node Pointer to the node.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    sample (const double_list_links_base* node);
 
   protected:
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
     /**
-     * @brief Pointer to the node.
+     * @brief The number of operations of the current thread
+     * since its last check.
      */
-    iterator_pointer node_;
+    static inline thread_local std::uint32_t operations_ = 0;
+#else
+    /**
+     * @brief The number of operations since the last check.
+     */
+    static std::atomic<std::uint32_t> operations_;
+#endif
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
   };
 
   // ==========================================================================
 
   /**
    * @ingroup micro-os-plus-utils-lists-double-lists
-   * @brief A class template for a double linked list of nodes.
+   * @brief A class for the core of a double linked list
+   * with nodes stamped with the list generation.
    * @headerfile lists.h <micro-os-plus/utils/lists.h>
    * @ingroup micro-os-plus-utils
-   * @tparam T Type of the elements linked into the list,
-   * derived from class `double_list_links_base`.
-   * @tparam L Type of the links node (one of
-   * `double_list_links` or `static_double_list_links`).
    *
    * @details
-   * A double linked list is a pair of head/tail pointers,
-   * allowing to iterate over the nodes.
-   *
-   * @note
-   * Currently only forward
-   * iterators are provided, but there is no problem to add reverse
-   * iterators, if needed.
+   * In addition to the pair of pointers, each node keeps a pointer
+   * to the list head and the list generation at the moment it was
+   * linked.
    *
-   * The list elements (of type T) should be derived from the
-   * `double_list_links_base` class, (usually from `double_list_links`)
-   * extended with the payload, that may be either the actual content
-   * or a pointer to the content.
+   * Clearing a list with a `generation_double_list_head`
+   * only increments the list generation, in O(1);
+   * all nodes linked before become _stale_: they report that they are
+   * not linked, and unlinking them does not touch their (old) neighbours.
    *
-   * The iterators return pointers to the list elements, i.e. to the
-   * beginning of the objects of type T.
+   * This allows huge lists (like wait queues) to be reset
+   * in constant time, without walking them.
    *
    * @note
-   * The class does not use inheritance, but composition for
-   * the links node, to avoid inheriting unwanted methods from it.
+   * Both the list elements (N) and the list head (L) must be of
+   * these types.
+   *
+   * @warning
+   * Since the nodes refer to the list head, the list must outlive
+   * the nodes linked into it, including the stale ones, which were
+   * never unlinked. In debug builds, the list head counts the nodes
+   * that refer to it, and its destructor asserts that none is left.
    */
-  template <class T, class L = double_list_links>
-  class double_list
+  class generation_double_list_links : public double_list_links_base
   {
   public:
-    static_assert (std::is_base_of<double_list_links_base, L>::value == true,
-                   "L must be derived from double_list_links_base!");
-    static_assert (std::is_base_of<double_list_links_base, T>::value == true,
-                   "T must be derived from double_list_links_base!");
-
     /**
-     * @brief Type of the links node object where the pointers to the
-     * list head and tail are stored.
+     * @brief Type indicating that the links node is **not**
+     * statically allocated.
      */
-    using links_type = L;
+    using is_statically_allocated = std::false_type;
 
     /**
-     * @brief Type of value "pointed to" by the iterator.
+     * @brief Type of the list generation counter.
      */
-    using value_type = T;
+    using generation_type = std::size_t;
 
     /**
-     * @brief Type of pointer to object "pointed to" by the iterator.
+     * @brief Construct an unlinked node.
      */
-    using pointer = value_type*;
+    constexpr generation_double_list_links ();
 
     /**
-     * @brief Type of reference to object "pointed to" by the iterator.
+     * @cond ignore
      */
-    using reference = value_type&;
 
-    /**
-     * @brief Type of iterator over the values.
-     */
-    using iterator = double_list_iterator<value_type>;
+    // The rule of five.
+    generation_double_list_links (const generation_double_list_links&)
+        = delete;
+    generation_double_list_links (generation_double_list_links&&) = delete;
+    generation_double_list_links&
+    operator= (const generation_double_list_links&)
+        = delete;
+    generation_double_list_links&
+    operator= (generation_double_list_links&&)
+        = delete;
 
     /**
-     * @brief Type of reference to the iterator internal pointer.
+     * @endcond
      */
-    using iterator_pointer = value_type*;
 
     /**
-     * @brief Type indicating that the links node is statically allocated.
+     * @brief Destruct the node.
      */
-    using is_statically_allocated =
-        typename links_type::is_statically_allocated;
+    constexpr ~generation_double_list_links ();
 
     /**
-     * @brief Construct a double linked list.
+     * @brief Initialise the node links (unlinked, no list).
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
      */
-    double_list ();
+    constexpr void
+    initialize (void);
 
     /**
-     * @cond ignore
+     * @brief Link the new node as **next** and stamp it.
+     * @param [in] node Pointer to the node to link.
+     * @par Returns
+     *  Nothing.
      */
-
-    // The rule of five.
-    double_list (const double_list&) = delete;
-    double_list (double_list&&) = delete;
-    double_list&
-    operator= (const double_list&)
-        = delete;
-    double_list&
-    operator= (double_list&&)
-        = delete;
+    void
+    link_next (generation_double_list_links* node);
 
     /**
-     * @endcond
+     * @brief Link the new node as **previous** and stamp it.
+     * @param [in] node Pointer to the node to link.
+     * @par Returns
+     *  Nothing.
      */
+    void
+    link_previous (generation_double_list_links* node);
 
     /**
-     * @brief Destruct the list.
+     * @brief Remove this node from the list, if not stale.
+     * @par Returns
+     *  Nothing.
      */
-    constexpr ~double_list ();
+    void
+    unlink (void);
 
-  public:
     /**
-     * @brief Check if the list is uninitialised
-     * (only statically allocated can be).
-     * @par Parameters
-     *  None.
-     * @retval true The list was **not** initialised.
-     * @retval false The list was initialised.
+     * @brief Check if the node is linked to the current list generation.
+     * @retval true The node is linked and not stale.
+     * @retval false The node is not linked, or is stale.
      */
     bool
-    uninitialized (void) const;
+    linked (void) const;
 
     /**
-     * @brief Initialize the list only at first run.
-     * @par Parameters
-     *  None.
+     * @brief Take the place of a node in its list, if not stale.
+     * @param [in] old_node Pointer to the node to replace; its
+     *  pointers are copied and its neighbours updated.
      * @par Returns
      *  Nothing.
      */
     void
-    initialize_once (void);
+    relink_moved (generation_double_list_links* old_node);
 
     /**
-     * @brief Check if the list is empty.
+     * @brief Get the list generation (the stamp, for list elements).
      * @par Parameters
      *  None.
-     * @retval true The list has **no** nodes.
-     * @retval false The list has at least one node.
+     * @return The generation.
      */
-    bool
-    empty (void) const;
+    constexpr generation_type
+    generation (void) const;
 
+  protected:
     /**
-     * @brief Clear the list.
-     * @par Parameters
-     *  None.
+     * @brief Refer a new list head (counted in debug builds).
+     * @param [in] head Pointer to the list head, or `nullptr`.
      * @par Returns
      *  Nothing.
      */
-    void
-    clear (void);
+    constexpr void
+    set_head_ (generation_double_list_links* head);
 
     /**
-     * @brief Get the list **head**.
+     * @brief Pointer to the head of the list the node was linked to;
+     * the list head points to itself.
+     */
+    generation_double_list_links* head_;
+
+    /**
+     * @brief The list generation; for elements, the list generation
+     * when the node was linked.
+     */
+    generation_type generation_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class for the head of a double linked list
+   * with nodes stamped with the list generation.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * To be used as the list links type (L) of lists
+   * with `generation_double_list_links` elements.
+   *
+   * Initialising the head (as `clear()` does) starts a new
+   * list generation, making all existing elements stale.
+   */
+  class generation_double_list_head : public generation_double_list_links
+  {
+  public:
+    /**
+     * @brief Construct an empty list head.
+     */
+    constexpr generation_double_list_head ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    generation_double_list_head (const generation_double_list_head&)
+        = delete;
+    generation_double_list_head (generation_double_list_head&&) = delete;
+    generation_double_list_head&
+    operator= (const generation_double_list_head&)
+        = delete;
+    generation_double_list_head&
+    operator= (generation_double_list_head&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list head.
+     */
+    constexpr ~generation_double_list_head ();
+
+    /**
+     * @brief Empty the list and start a new generation.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    initialize (void);
+
+  protected:
+    friend class generation_double_list_links;
+
+    /**
+     * @brief The number of nodes that refer this list head;
+     * only counted in debug builds.
+     */
+    std::size_t references_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class template for a double linked list bidirectional iterator.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object returned by the iterator.
+   * @tparam N Type of intrusive node. Must have the public members
+   * **previous** & **next**.
+   * @tparam U Type stored in the list, derived from T; `const`
+   * qualified for constant iterators.
+   *
+   * @details
+   * This class provides an interface similar to `std::list::iterator`,
+   * and satisfies the C++20 `std::bidirectional_iterator` concept.
+   *
+   * In a common double linked list, all types are `double_list_links`.
+   */
+  template <class T, class N = T, class U = T>
+  class double_list_iterator
+  {
+  public:
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = typename std::remove_cv<U>::type;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = U*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = U&;
+
+    /**
+     * @brief Type of reference to the iterator internal pointer.
+     */
+    using iterator_pointer = N*;
+
+    /**
+     * @brief Type of pointer difference.
+     */
+    using difference_type = ptrdiff_t;
+
+    /**
+     * @brief Category of iterator.
+     */
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    // ------------------------------------------------------------------------
+    constexpr double_list_iterator ();
+
+    constexpr explicit double_list_iterator (iterator_pointer const node);
+
+    constexpr explicit double_list_iterator (reference element);
+
+    /**
+     * @brief Construct a constant iterator from a non-constant one.
+     * @param [in] other Reference to a non-constant iterator.
+     */
+    template <class V>
+      requires std::is_same<const V, U>::value
+    constexpr double_list_iterator (
+        const double_list_iterator<T, N, V>& other);
+
+    // DO NOT delete the copy constructors, since the default one are
+    // used.
+
+    constexpr pointer
+    operator->() const;
+
+    constexpr reference
+    operator* () const;
+
+    constexpr double_list_iterator&
+    operator++ ();
+
+    constexpr double_list_iterator
+    operator++ (int);
+
+    constexpr double_list_iterator&
+    operator-- ();
+
+    constexpr double_list_iterator
+    operator-- (int);
+
+    constexpr bool
+    operator== (const double_list_iterator& other) const;
+
+    constexpr bool
+    operator!= (const double_list_iterator& other) const;
+
+    constexpr pointer
+    get_pointer () const;
+
+    constexpr iterator_pointer
+    get_iterator_pointer () const;
+
+  protected:
+    /**
+     * @brief Pointer to the node.
+     */
+    iterator_pointer node_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class template for a list iterator adaptor that tolerates
+   * unlinking the current element.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam I Type of the list iterator.
+   *
+   * @details
+   * Unlinking a node makes it point to itself, so a plain iterator
+   * positioned on an unlinked node can no longer advance.
+   *
+   * The adaptor reads the successor of the current node when it is
+   * positioned on it, before the current element is made available,
+   * thus the current element can be unlinked (or linked into another
+   * list) before incrementing the iterator.
+   *
+   * @note
+   * Only the current element may be unlinked; unlinking its
+   * successor invalidates the iterator.
+   */
+  template <class I>
+  class safe_list_iterator
+  {
+  public:
+    /**
+     * @brief Type of the adapted iterator.
+     */
+    using iterator_type = I;
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = typename std::iterator_traits<I>::value_type;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = typename std::iterator_traits<I>::pointer;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = typename std::iterator_traits<I>::reference;
+
+    /**
+     * @brief Type of pointer difference.
+     */
+    using difference_type = typename std::iterator_traits<I>::difference_type;
+
+    /**
+     * @brief Category of iterator.
+     */
+    using iterator_category = std::forward_iterator_tag;
+
+    // ------------------------------------------------------------------------
+    constexpr safe_list_iterator ();
+
+    /**
+     * @brief Construct an iterator adaptor.
+     * @param [in] current The list iterator to adapt.
+     * @param [in] end The list end iterator.
+     */
+    constexpr safe_list_iterator (iterator_type current, iterator_type end);
+
+    /**
+     * @cond ignore
+     */
+
+    constexpr reference
+    operator* () const;
+
+    constexpr pointer
+    operator->() const;
+
+    constexpr safe_list_iterator&
+    operator++ ();
+
+    constexpr safe_list_iterator
+    operator++ (int);
+
+    constexpr bool
+    operator== (const safe_list_iterator& other) const;
+
+    constexpr bool
+    operator!= (const safe_list_iterator& other) const;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Get the adapted iterator.
+     * @par Parameters
+     *  None.
+     * @return The current list iterator.
+     */
+    constexpr iterator_type
+    base (void) const;
+
+  protected:
+    /**
+     * @brief Position the iterator and cache the successor.
+     * @param [in] current The new position.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    advance_to_ (iterator_type current);
+
+    /**
+     * @brief The current position.
+     */
+    iterator_type current_;
+
+    /**
+     * @brief The successor of the current position, read before
+     * the current element was made available.
+     */
+    iterator_type next_;
+
+    /**
+     * @brief The list end.
+     */
+    iterator_type end_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief The default statistics policy of the lists, without
+   * any counters.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * A statistics policy is a class used as the last template
+   * parameter of `double_list` and `intrusive_list`; the list
+   * derives from it, and calls its protected hooks when nodes are
+   * linked (`on_link_()`), unlinked (`on_unlink_()`), when all
+   * nodes are unlinked at once (`on_unlink_all_()`), when the list
+   * is cleared (`on_clear_()`) and when an iteration starts
+   * (`on_iterate_()`).
+   *
+   * The list constructs the policy with a boolean telling if the
+   * list is statically allocated; in this case the policy must not
+   * write its members, which may have already been used by other
+   * static constructors, like the list links.
+   *
+   * In this policy the class is empty and the hooks do nothing,
+   * so the lists have the same size and the same code as without
+   * statistics; for counters, use `list_stats` or
+   * `list_residency_stats` from `list-stats.h`.
+   */
+  class null_list_stats
+  {
+  public:
+    /**
+     * @brief Tell the lists that no statistics are collected.
+     */
+    static constexpr bool enabled = false;
+
+    /**
+     * @brief Construct the policy.
+     */
+    constexpr null_list_stats () = default;
+
+    /**
+     * @brief Construct the policy for a list.
+     * @param [in] statically_allocated True if the list is
+     *  statically allocated.
+     */
+    constexpr explicit null_list_stats (bool statically_allocated)
+    {
+      (void)statically_allocated;
+    }
+
+  protected:
+    /**
+     * @brief Hook called after a node was linked.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    constexpr void
+    on_link_ (N*)
+    {
+    }
+
+    /**
+     * @brief Hook called when a node is unlinked.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class N>
+    constexpr void
+    on_unlink_ (N*)
+    {
+    }
+
+    /**
+     * @brief Hook called when all nodes are unlinked at once,
+     *  in constant time.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    on_unlink_all_ (void)
+    {
+    }
+
+    /**
+     * @brief Hook called when an iteration starts.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    on_iterate_ (void) const
+    {
+    }
+
+    /**
+     * @brief Hook called when the list is cleared.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    on_clear_ (void)
+    {
+    }
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-double-lists
+   * @brief A class template for a double linked list of nodes.
+   * @headerfile lists.h <micro-os-plus/utils/lists.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of the elements linked into the list,
+   * derived from class `double_list_links_base`.
+   * @tparam L Type of the links node (one of
+   * `double_list_links` or `static_double_list_links`).
+   * @tparam S Type of the statistics policy (`null_list_stats`
+   * for no statistics).
+   *
+   * @details
+   * A double linked list is a pair of head/tail pointers,
+   * allowing to iterate over the nodes.
+   *
+   * @note
+   * The iterators are bidirectional; constant and reverse
+   * iterators are also provided, and the list can be used
+   * with the C++20 ranges library.
+   *
+   * The `remove_if()`, `unique()`, `partition()` and `reverse()`
+   * algorithms work in place, by updating the links, without
+   * allocating memory; the predicates and the disposers must not
+   * access the list being processed.
+   *
+   * To unlink elements while iterating, use `for_each_safe()`,
+   * `drain_if()` or the `safe_begin()`/`safe_end()` iterators.
+   *
+   * The list elements (of type T) should be derived from the
+   * `double_list_links_base` class, (usually from `double_list_links`)
+   * extended with the payload, that may be either the actual content
+   * or a pointer to the content.
+   *
+   * The iterators return pointers to the list elements, i.e. to the
+   * beginning of the objects of type T.
+   *
+   * The statistics are updated by the list methods; nodes unlinked
+   * directly, with `node.unlink()`, are not counted, so lists with
+   * statistics should use the `unlink()` method of the list.
+   *
+   * @note
+   * The class does not use inheritance, but composition for
+   * the links node, to avoid inheriting unwanted methods from it;
+   * only the statistics policy is a (protected) base, to take
+   * no space when empty.
+   */
+  template <class T, class L = double_list_links,
+            class S = null_list_stats>
+  class double_list : protected S
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, L>::value == true,
+                   "L must be derived from double_list_links_base!");
+    static_assert (std::is_base_of<double_list_links_base, T>::value == true,
+                   "T must be derived from double_list_links_base!");
+
+    /**
+     * @brief Type of the links node object where the pointers to the
+     * list head and tail are stored.
+     */
+    using links_type = L;
+
+    /**
+     * @brief Type of the statistics policy.
+     */
+    using stats_type = S;
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of iterator over the values.
+     */
+    using iterator = double_list_iterator<value_type>;
+
+    /**
+     * @brief Type of constant iterator over the values.
+     */
+    using const_iterator
+        = double_list_iterator<value_type, value_type, const value_type>;
+
+    /**
+     * @brief Type of reverse iterator over the values.
+     */
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /**
+     * @brief Type of constant reverse iterator over the values.
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Type of iterator that tolerates unlinking the current
+     * element.
+     */
+    using safe_iterator = safe_list_iterator<iterator>;
+
+    /**
+     * @brief Type of reference to the iterator internal pointer.
+     */
+    using iterator_pointer = value_type*;
+
+    /**
+     * @brief Type indicating that the links node is statically allocated.
+     */
+    using is_statically_allocated =
+        typename links_type::is_statically_allocated;
+
+    /**
+     * @brief Construct a double linked list.
+     */
+    double_list ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    double_list (const double_list&) = delete;
+    double_list (double_list&&) = delete;
+    double_list&
+    operator= (const double_list&)
+        = delete;
+    double_list&
+    operator= (double_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    constexpr ~double_list ();
+
+  public:
+    /**
+     * @brief Check if the list is uninitialised
+     * (only statically allocated can be).
+     * @par Parameters
+     *  None.
+     * @retval true The list was **not** initialised.
+     * @retval false The list was initialised.
+     */
+    bool
+    uninitialized (void) const;
+
+    /**
+     * @brief Initialize the list only at first run.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    initialize_once (void);
+
+    /**
+     * @brief Check if the list is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The list has **no** nodes.
+     * @retval false The list has at least one node.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Clear the list.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    clear (void);
+
+    /**
+     * @brief Get the list **head**.
      * @par Parameters
      *  None.
      * @return Pointer to the head node.
      */
-    constexpr pointer
-    head (void) const;
+    constexpr pointer
+    head (void) const;
+
+    /**
+     * @brief Get the list **tail**.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the tail node.
+     */
+    constexpr pointer
+    tail (void) const;
+
+    /**
+     * @brief Add a node to the tail of the list.
+     */
+    void
+    link_tail (reference node);
+
+    /**
+     * @brief Add a node to the head of the list.
+     */
+    void
+    link_head (reference node);
+
+    /**
+     * @brief Add a node to the tail of the list, possibly concurrently
+     * with other threads.
+     * @param [in] node Reference to a list node.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_tail_concurrent (reference node);
+
+    /**
+     * @brief Add a range of nodes to the tail of the list.
+     * @tparam I Type of iterator; it must refer to nodes or to
+     *  pointers to nodes.
+     * @param [in] first Iterator to the first node.
+     * @param [in] last Iterator past the last node.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class I>
+    void
+    link_tail_range (I first, I last);
+
+    /**
+     * @brief Add a range of nodes to the tail of the list.
+     * @tparam R Type of range (like `std::span`) of nodes or
+     *  pointers to nodes.
+     * @param [in] range Reference to the range.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class R>
+    void
+    link_tail_range (R&& range);
+
+    /**
+     * @brief Add a range of nodes to the head of the list,
+     * keeping their order.
+     * @tparam I Type of iterator; it must refer to nodes or to
+     *  pointers to nodes.
+     * @param [in] first Iterator to the first node.
+     * @param [in] last Iterator past the last node.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class I>
+    void
+    link_head_range (I first, I last);
+
+    /**
+     * @brief Add a range of nodes to the head of the list,
+     * keeping their order.
+     * @tparam R Type of range (like `std::span`) of nodes or
+     *  pointers to nodes.
+     * @param [in] range Reference to the range.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class R>
+    void
+    link_head_range (R&& range);
+
+    /**
+     * @brief Unlink a node from the list.
+     * @param [in] node Reference to a node linked in this list.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink (reference node);
+
+    /**
+     * @brief Unlink all nodes that satisfy a predicate.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each node.
+     * @return The number of nodes removed.
+     */
+    template <class P>
+    std::size_t
+    remove_if (P&& pred);
+
+    /**
+     * @brief Unlink all nodes that satisfy a predicate, and pass them
+     * to a disposer.
+     * @tparam P Type of the predicate.
+     * @tparam D Type of the disposer.
+     * @param [in] pred Predicate called with a reference to each node.
+     * @param [in] disposer Callable object called with a reference
+     *  to each removed node, after it was unlinked.
+     * @return The number of nodes removed.
+     */
+    template <class P, class D>
+    std::size_t
+    remove_if (P&& pred, D&& disposer);
+
+    /**
+     * @brief Unlink the consecutive duplicate nodes.
+     * @tparam E Type of the equality predicate.
+     * @param [in] eq Binary predicate called with the last kept
+     *  node and the current one.
+     * @return The number of nodes removed.
+     */
+    template <class E>
+    std::size_t
+    unique (E&& eq);
+
+    /**
+     * @brief Unlink the consecutive duplicate nodes, and pass them
+     * to a disposer.
+     * @tparam E Type of the equality predicate.
+     * @tparam D Type of the disposer.
+     * @param [in] eq Binary predicate called with the last kept
+     *  node and the current one.
+     * @param [in] disposer Callable object called with a reference
+     *  to each removed node, after it was unlinked.
+     * @return The number of nodes removed.
+     */
+    template <class E, class D>
+    std::size_t
+    unique (E&& eq, D&& disposer);
+
+    /**
+     * @brief Move the nodes that satisfy a predicate to the tail
+     * of another list.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each node.
+     * @param [in] out Reference to the destination list.
+     * @return The number of nodes moved.
+     */
+    template <class P>
+    std::size_t
+    partition (P&& pred, double_list& out);
+
+    /**
+     * @brief Move the nodes that satisfy a predicate to the tail
+     * of another list, keeping their relative order.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each node.
+     * @param [in] out Reference to the destination list.
+     * @return The number of nodes moved.
+     */
+    template <class P>
+    std::size_t
+    stable_partition (P&& pred, double_list& out);
+
+    /**
+     * @brief Reverse the order of the nodes.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    reverse (void);
+
+    /**
+     * @brief Move a range of nodes from a list before a given position.
+     * @param [in] position Iterator to the node before which to move.
+     * @param [in] other Reference to the source list (it may be this
+     *  list, if the position is not in the range).
+     * @param [in] first Iterator to the first node to move.
+     * @param [in] last Iterator past the last node to move.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    splice (iterator position, double_list& other, iterator first,
+            iterator last);
+
+    /**
+     * @brief Move all nodes to the tail of another list.
+     * @param [in] out Reference to the destination list, usually
+     *  an empty (static or local) list.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    take_all (double_list& out);
 
     /**
-     * @brief Get the list **tail**.
-     * @par Parameters
-     *  None.
-     * @return Pointer to the tail node.
+     * @brief Move all nodes to the tail of another list, with
+     * this list protected by a lock.
+     * @tparam Lock Type of the lock (BasicLockable).
+     * @param [in] out Reference to the destination list, not
+     *  shared with other threads.
+     * @param [in] lock Reference to the lock protecting this list.
+     * @par Returns
+     *  Nothing.
      */
-    constexpr pointer
-    tail (void) const;
+    template <class Lock>
+    void
+    take_all (double_list& out, Lock& lock);
 
     /**
-     * @brief Add a node to the tail of the list.
+     * @brief Exchange the nodes of two lists.
+     * @param [in] other Reference to the other list.
+     * @par Returns
+     *  Nothing.
      */
     void
-    link_tail (reference node);
+    exchange (double_list& other);
 
     /**
-     * @brief Add a node to the head of the list.
+     * @brief Exchange the nodes of two lists, with this list
+     * protected by a lock.
+     * @tparam Lock Type of the lock (BasicLockable).
+     * @param [in] other Reference to the other list, not shared
+     *  with other threads.
+     * @param [in] lock Reference to the lock protecting this list.
+     * @par Returns
+     *  Nothing.
      */
+    template <class Lock>
     void
-    link_head (reference node);
+    exchange (double_list& other, Lock& lock);
+
+    /**
+     * @brief Call a function for each node; the function may
+     * unlink the node it receives.
+     * @tparam F Type of the function.
+     * @param [in] function Callable object called with a reference
+     *  to each node.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class F>
+    void
+    for_each_safe (F&& function);
+
+    /**
+     * @brief Unlink the nodes that satisfy a predicate, and pass
+     * them to a function.
+     * @tparam P Type of the predicate.
+     * @tparam F Type of the function.
+     * @param [in] pred Predicate called with a reference to each node.
+     * @param [in] function Callable object called with a reference
+     *  to each unlinked node; the list is consistent and can be used.
+     * @return The number of nodes unlinked.
+     */
+    template <class P, class F>
+    std::size_t
+    drain_if (P&& pred, F&& function);
+
+    /**
+     * @brief Check the integrity of the list links.
+     * @par Parameters
+     *  None.
+     * @retval true The list is consistent.
+     * @retval false The list is corrupted.
+     */
+    bool
+    validate (void) const;
+
+    /**
+     * @brief Check the integrity of the list links and the number
+     * of nodes.
+     * @param [in] expected_size The expected number of nodes.
+     * @retval true The list is consistent and has the expected size.
+     * @retval false The list is corrupted or has a different size.
+     */
+    bool
+    validate (std::size_t expected_size) const;
 
     // ------------------------------------------------------------------------
 
@@ -644,6 +1698,63 @@ namespace micro_os_plus::utils
     iterator
     end () const;
 
+    /**
+     * @brief Constant iterator begin.
+     * @return A constant iterator positioned at the first element.
+     */
+    const_iterator
+    cbegin () const;
+
+    /**
+     * @brief Constant iterator end.
+     * @return A constant iterator positioned after the last element.
+     */
+    const_iterator
+    cend () const;
+
+    /**
+     * @brief Reverse iterator begin.
+     * @return A reverse iterator positioned at the last element.
+     */
+    reverse_iterator
+    rbegin () const;
+
+    /**
+     * @brief Reverse iterator end.
+     * @return A reverse iterator positioned before the first element.
+     */
+    reverse_iterator
+    rend () const;
+
+    /**
+     * @brief Constant reverse iterator begin.
+     * @return A constant reverse iterator positioned at the last element.
+     */
+    const_reverse_iterator
+    crbegin () const;
+
+    /**
+     * @brief Constant reverse iterator end.
+     * @return A constant reverse iterator positioned before the
+     *  first element.
+     */
+    const_reverse_iterator
+    crend () const;
+
+    /**
+     * @brief Removal-safe iterator begin.
+     * @return A removal-safe iterator positioned at the first element.
+     */
+    safe_iterator
+    safe_begin () const;
+
+    /**
+     * @brief Removal-safe iterator end.
+     * @return A removal-safe iterator positioned after the last element.
+     */
+    safe_iterator
+    safe_end () const;
+
     // Required in derived class iterator end(), where direct
     // access to member fails.
     /**
@@ -656,9 +1767,116 @@ namespace micro_os_plus::utils
       return &links_;
     }
 
+    /**
+     * @brief Get the statistics of the list.
+     * @par Parameters
+     *  None.
+     * @return A reference to the statistics policy object.
+     */
+    constexpr const stats_type&
+    stats (void) const
+    {
+      return *this;
+    }
+
+    /**
+     * @brief Get the statistics of the list, to configure them.
+     * @par Parameters
+     *  None.
+     * @return A reference to the statistics policy object.
+     */
+    constexpr stats_type&
+    stats (void)
+    {
+      return *this;
+    }
+
     // ------------------------------------------------------------------------
 
   protected:
+    /**
+     * @brief Link a range of nodes after a given node.
+     * @param [in] after Pointer to the node after which to link.
+     * @param [in] first Iterator to the first element.
+     * @param [in] last Iterator past the last element.
+     * @param [in] to_node Callable object returning the links node
+     *  of an element.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class I, class F>
+    void
+    link_range_after_ (double_list_links_base* after, I first, I last,
+                       F&& to_node);
+
+    /**
+     * @brief Unlink the nodes that satisfy a predicate.
+     * @param [in] pred Predicate called with the last kept node
+     *  (`nullptr` if none) and the current node.
+     * @param [in] disposer Callable object called with each
+     *  removed node.
+     * @return The number of nodes removed.
+     */
+    template <class P, class D>
+    std::size_t
+    remove_nodes_if_ (P&& pred, D&& disposer);
+
+    /**
+     * @brief Move the nodes that satisfy a predicate to the tail
+     * of another list.
+     * @param [in] pred Predicate called with each node.
+     * @param [in] out Reference to the destination list.
+     * @return The number of nodes moved.
+     */
+    template <class P>
+    std::size_t
+    partition_nodes_ (P&& pred, double_list& out);
+
+    /**
+     * @brief Move a range of nodes before a given node.
+     * @param [in] position Pointer to the node before which to move.
+     * @param [in] first Pointer to the first node to move.
+     * @param [in] last Pointer to the node past the last node to move.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    splice_nodes_ (double_list_links_base* position,
+                   double_list_links_base* first,
+                   double_list_links_base* last);
+
+    /**
+     * @brief Account a range of nodes linked into this list.
+     * @param [in] first Pointer to the first node.
+     * @param [in] last Pointer to the node past the last node.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    stats_link_range_ (double_list_links_base* first,
+                       double_list_links_base* last);
+
+    /**
+     * @brief Account a range of nodes unlinked from this list.
+     * @param [in] first Pointer to the first node.
+     * @param [in] last Pointer to the node past the last node.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    stats_unlink_range_ (double_list_links_base* first,
+                         double_list_links_base* last);
+
+    /**
+     * @brief Walk the list and check the links of all nodes.
+     * @param [out] size Reference to a variable where to store
+     *  the number of nodes.
+     * @retval true The list is consistent.
+     * @retval false The list is corrupted.
+     */
+    bool
+    validate_ (std::size_t& size) const;
+
     /**
      * @brief The list top node used to point to **head**
      * and **tail** nodes.
@@ -684,12 +1902,15 @@ namespace micro_os_plus::utils
    * @tparam N Type of intrusive node. Must have the public members
    * **previous** & **next**.
    * @tparam MP Name of the intrusive node member in object T.
-   * @tparam U Type stored in the list, derived from T.
+   * @tparam U Type stored in the list, derived from T; `const`
+   * qualified for constant iterators.
    *
    * @details
    * This class provides an interface similar to `std::list::iterator`,
    * except that it keeps track of the offset where the intrusive
    * list element is located in the parent object.
+   *
+   * It satisfies the C++20 `std::bidirectional_iterator` concept.
    */
   template <class T, class N, N T::*MP, class U = T>
   class intrusive_list_iterator
@@ -698,17 +1919,17 @@ namespace micro_os_plus::utils
     /**
      * @brief Type of value "pointed to" by the iterator.
      */
-    using value_type = U;
+    using value_type = typename std::remove_cv<U>::type;
 
     /**
      * @brief Type of pointer to object "pointed to" by the iterator.
      */
-    using pointer = value_type*;
+    using pointer = U*;
 
     /**
      * @brief Type of reference to object "pointed to" by the iterator.
      */
-    using reference = value_type&;
+    using reference = U&;
 
     /**
      * @brief Type of reference to the iterator internal pointer.
@@ -723,7 +1944,7 @@ namespace micro_os_plus::utils
     /**
      * @brief Category of iterator.
      */
-    using iterator_category = std::forward_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
 
     // ------------------------------------------------------------------------
     constexpr intrusive_list_iterator ();
@@ -732,6 +1953,15 @@ namespace micro_os_plus::utils
 
     constexpr explicit intrusive_list_iterator (reference element);
 
+    /**
+     * @brief Construct a constant iterator from a non-constant one.
+     * @param [in] other Reference to a non-constant iterator.
+     */
+    template <class V>
+      requires std::is_same<const V, U>::value
+    constexpr intrusive_list_iterator (
+        const intrusive_list_iterator<T, N, MP, V>& other);
+
     // DO NOT delete the copy constructors, since the default one are
     // used.
 
@@ -790,6 +2020,8 @@ namespace micro_os_plus::utils
    * @tparam L Type of the links node (one of
    * `double_list_links` or `static_double_list_links`).
    * @tparam U Type stored in the list, derived from T.
+   * @tparam S Type of the statistics policy (`null_list_stats`
+   * for no statistics).
    *
    * @par Examples
    *
@@ -809,11 +2041,15 @@ namespace micro_os_plus::utils
    * the offset from the address of the member storing the pointers.
    *
    * For statically allocated lists, set L=static_double_list_links.
+   *
+   * For statistics, set S to `list_stats` (or `list_residency_stats`,
+   * which also requires N to be `timestamped_double_list_links`),
+   * and unlink the elements with the `unlink()` method of the list.
    */
 
   template <class T, class N, N T::*MP, class L = double_list_links,
-            class U = T>
-  class intrusive_list : public double_list<N, L>
+            class U = T, class S = null_list_stats>
+  class intrusive_list : public double_list<N, L, S>
   {
   public:
     static_assert (std::is_base_of<double_list_links_base, L>::value == true,
@@ -847,6 +2083,27 @@ namespace micro_os_plus::utils
      */
     using iterator = intrusive_list_iterator<T, N, MP, U>;
 
+    /**
+     * @brief Type of constant iterator over the values.
+     */
+    using const_iterator = intrusive_list_iterator<T, N, MP, const U>;
+
+    /**
+     * @brief Type of reverse iterator over the values.
+     */
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /**
+     * @brief Type of constant reverse iterator over the values.
+     */
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Type of iterator that tolerates unlinking the current
+     * element.
+     */
+    using safe_iterator = safe_list_iterator<iterator>;
+
     /**
      * @brief Type of reference to the iterator internal pointer.
      */
@@ -930,6 +2187,77 @@ namespace micro_os_plus::utils
     void
     link_head (reference node);
 
+    /**
+     * @brief Add an element to the tail of the list, possibly concurrently
+     * with other threads.
+     * @param [in] node Reference to a list element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_tail_concurrent (reference node);
+
+    /**
+     * @brief Add a range of elements to the tail of the list.
+     * @tparam I Type of iterator; it must refer to elements or to
+     *  pointers to elements.
+     * @param [in] first Iterator to the first element.
+     * @param [in] last Iterator past the last element.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class I>
+    void
+    link_tail_range (I first, I last);
+
+    /**
+     * @brief Add a range of elements to the tail of the list.
+     * @tparam R Type of range (like `std::span`) of elements or
+     *  pointers to elements.
+     * @param [in] range Reference to the range.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class R>
+    void
+    link_tail_range (R&& range);
+
+    /**
+     * @brief Add a range of elements to the head of the list,
+     * keeping their order.
+     * @tparam I Type of iterator; it must refer to elements or to
+     *  pointers to elements.
+     * @param [in] first Iterator to the first element.
+     * @param [in] last Iterator past the last element.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class I>
+    void
+    link_head_range (I first, I last);
+
+    /**
+     * @brief Add a range of elements to the head of the list,
+     * keeping their order.
+     * @tparam R Type of range (like `std::span`) of elements or
+     *  pointers to elements.
+     * @param [in] range Reference to the range.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class R>
+    void
+    link_head_range (R&& range);
+
+    /**
+     * @brief Unlink an element from the list.
+     * @param [in] node Reference to an element linked in this list.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink (reference node);
+
     /**
      * @brief Unlink the last element from the list.
      * @return Pointer to the last element in the list.
@@ -944,6 +2272,169 @@ namespace micro_os_plus::utils
     pointer
     unlink_head (void);
 
+    /**
+     * @brief Unlink all elements that satisfy a predicate.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each element.
+     * @return The number of elements removed.
+     */
+    template <class P>
+    std::size_t
+    remove_if (P&& pred);
+
+    /**
+     * @brief Unlink all elements that satisfy a predicate, and pass them
+     * to a disposer.
+     * @tparam P Type of the predicate.
+     * @tparam D Type of the disposer.
+     * @param [in] pred Predicate called with a reference to each element.
+     * @param [in] disposer Callable object called with a reference
+     *  to each removed element, after it was unlinked.
+     * @return The number of elements removed.
+     */
+    template <class P, class D>
+    std::size_t
+    remove_if (P&& pred, D&& disposer);
+
+    /**
+     * @brief Unlink the consecutive duplicate elements.
+     * @tparam E Type of the equality predicate.
+     * @param [in] eq Binary predicate called with the last kept
+     *  element and the current one.
+     * @return The number of elements removed.
+     */
+    template <class E>
+    std::size_t
+    unique (E&& eq);
+
+    /**
+     * @brief Unlink the consecutive duplicate elements, and pass them
+     * to a disposer.
+     * @tparam E Type of the equality predicate.
+     * @tparam D Type of the disposer.
+     * @param [in] eq Binary predicate called with the last kept
+     *  element and the current one.
+     * @param [in] disposer Callable object called with a reference
+     *  to each removed element, after it was unlinked.
+     * @return The number of elements removed.
+     */
+    template <class E, class D>
+    std::size_t
+    unique (E&& eq, D&& disposer);
+
+    /**
+     * @brief Move the elements that satisfy a predicate to the tail
+     * of another list.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each element.
+     * @param [in] out Reference to the destination list.
+     * @return The number of elements moved.
+     */
+    template <class P>
+    std::size_t
+    partition (P&& pred, intrusive_list& out);
+
+    /**
+     * @brief Move the elements that satisfy a predicate to the tail
+     * of another list, keeping their relative order.
+     * @tparam P Type of the predicate.
+     * @param [in] pred Predicate called with a reference to each element.
+     * @param [in] out Reference to the destination list.
+     * @return The number of elements moved.
+     */
+    template <class P>
+    std::size_t
+    stable_partition (P&& pred, intrusive_list& out);
+
+    /**
+     * @brief Move a range of elements from a list before a given
+     * position.
+     * @param [in] position Iterator to the element before which to move.
+     * @param [in] other Reference to the source list (it may be this
+     *  list, if the position is not in the range).
+     * @param [in] first Iterator to the first element to move.
+     * @param [in] last Iterator past the last element to move.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    splice (iterator position, intrusive_list& other, iterator first,
+            iterator last);
+
+    /**
+     * @brief Move all elements to the tail of another list.
+     * @param [in] out Reference to the destination list, usually
+     *  an empty (static or local) list.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    take_all (intrusive_list& out);
+
+    /**
+     * @brief Move all elements to the tail of another list, with
+     * this list protected by a lock.
+     * @tparam Lock Type of the lock (BasicLockable).
+     * @param [in] out Reference to the destination list, not
+     *  shared with other threads.
+     * @param [in] lock Reference to the lock protecting this list.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class Lock>
+    void
+    take_all (intrusive_list& out, Lock& lock);
+
+    /**
+     * @brief Exchange the elements of two lists.
+     * @param [in] other Reference to the other list.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    exchange (intrusive_list& other);
+
+    /**
+     * @brief Exchange the elements of two lists, with this list
+     * protected by a lock.
+     * @tparam Lock Type of the lock (BasicLockable).
+     * @param [in] other Reference to the other list, not shared
+     *  with other threads.
+     * @param [in] lock Reference to the lock protecting this list.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class Lock>
+    void
+    exchange (intrusive_list& other, Lock& lock);
+
+    /**
+     * @brief Call a function for each element; the function may
+     * unlink the element it receives.
+     * @tparam F Type of the function.
+     * @param [in] function Callable object called with a reference
+     *  to each element.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class F>
+    void
+    for_each_safe (F&& function);
+
+    /**
+     * @brief Unlink the elements that satisfy a predicate, and pass
+     * them to a function.
+     * @tparam P Type of the predicate.
+     * @tparam F Type of the function.
+     * @param [in] pred Predicate called with a reference to each element.
+     * @param [in] function Callable object called with a reference
+     *  to each unlinked element; the list is consistent and can be used.
+     * @return The number of elements unlinked.
+     */
+    template <class P, class F>
+    std::size_t
+    drain_if (P&& pred, F&& function);
+
     // ------------------------------------------------------------------------
 
     /**
@@ -954,12 +2445,69 @@ namespace micro_os_plus::utils
     begin () const;
 
     /**
-     * @brief Iterator begin.
+     * @brief Iterator end.
      * @return An iterator positioned after the last element.
      */
     iterator
     end () const;
 
+    /**
+     * @brief Constant iterator begin.
+     * @return A constant iterator positioned at the first element.
+     */
+    const_iterator
+    cbegin () const;
+
+    /**
+     * @brief Constant iterator end.
+     * @return A constant iterator positioned after the last element.
+     */
+    const_iterator
+    cend () const;
+
+    /**
+     * @brief Reverse iterator begin.
+     * @return A reverse iterator positioned at the last element.
+     */
+    reverse_iterator
+    rbegin () const;
+
+    /**
+     * @brief Reverse iterator end.
+     * @return A reverse iterator positioned before the first element.
+     */
+    reverse_iterator
+    rend () const;
+
+    /**
+     * @brief Constant reverse iterator begin.
+     * @return A constant reverse iterator positioned at the last element.
+     */
+    const_reverse_iterator
+    crbegin () const;
+
+    /**
+     * @brief Constant reverse iterator end.
+     * @return A constant reverse iterator positioned before the
+     *  first element.
+     */
+    const_reverse_iterator
+    crend () const;
+
+    /**
+     * @brief Removal-safe iterator begin.
+     * @return A removal-safe iterator positioned at the first element.
+     */
+    safe_iterator
+    safe_begin () const;
+
+    /**
+     * @brief Removal-safe iterator end.
+     * @return A removal-safe iterator positioned after the last element.
+     */
+    safe_iterator
+    safe_end () const;
+
     // ------------------------------------------------------------------------
   protected:
     /**
@@ -968,6 +2516,14 @@ namespace micro_os_plus::utils
      */
     pointer
     get_pointer (iterator_pointer node) const;
+
+    /**
+     * @brief Get the address of the intrusive node of an element.
+     * @param [in] element Reference to an element.
+     * @return A pointer to the node.
+     */
+    static iterator_pointer
+    get_node (reference element);
   };
 
   // --------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_LOCKS_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_LOCKS_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  constexpr void
+  null_lock::lock (void)
+  {
+  }
+
+  constexpr bool
+  null_lock::try_lock (void)
+  {
+    return true;
+  }
+
+  constexpr void
+  null_lock::unlock (void)
+  {
+  }
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+  // ==========================================================================
+
+  inline void
+  spin_lock::lock (void)
+  {
+    while (flag_.test_and_set (std::memory_order_acquire))
+      {
+        while (flag_.test (std::memory_order_relaxed))
+          {
+            // Spin.
+          }
+      }
+  }
+
+  inline bool
+  spin_lock::try_lock (void)
+  {
+    return !flag_.test (std::memory_order_relaxed)
+           && !flag_.test_and_set (std::memory_order_acquire);
+  }
+
+  inline void
+  spin_lock::unlock (void)
+  {
+    flag_.clear (std::memory_order_release);
+  }
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_LOCKS_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Simple locks, used as policies by the concurrent containers.
+ *
+ * They satisfy the C++ _BasicLockable_ requirements (`lock()` and
+ * `unlock()`), so any other lock with the same interface (like an
+ * RTOS mutex, or an interrupts critical section) can be used instead.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_LOCKS_H_
+#define MICRO_OS_PLUS_UTILS_LOCKS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <atomic>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for a lock that does nothing.
+   * @headerfile locks.h <micro-os-plus/utils/locks.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * For containers used from a single thread, or protected
+   * by other means.
+   */
+  class null_lock
+  {
+  public:
+    /**
+     * @brief Acquire the lock (nothing).
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    lock (void);
+
+    /**
+     * @brief Try to acquire the lock (always succeeds).
+     * @par Parameters
+     *  None.
+     * @retval true The lock was acquired.
+     */
+    constexpr bool
+    try_lock (void);
+
+    /**
+     * @brief Release the lock (nothing).
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    constexpr void
+    unlock (void);
+  };
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for a busy waiting lock.
+   * @headerfile locks.h <micro-os-plus/utils/locks.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * Intended for short critical sections between threads running
+   * on different cores; waiting only reads the flag, to avoid
+   * bouncing the cache line while the lock is taken.
+   *
+   * Available only on cores with atomic compare-and-swap.
+   */
+  class spin_lock
+  {
+  public:
+    /**
+     * @brief Construct an unlocked lock.
+     */
+    constexpr spin_lock () = default;
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    spin_lock (const spin_lock&) = delete;
+    spin_lock (spin_lock&&) = delete;
+    spin_lock&
+    operator= (const spin_lock&)
+        = delete;
+    spin_lock&
+    operator= (spin_lock&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the lock.
+     */
+    ~spin_lock () = default;
+
+    /**
+     * @brief Acquire the lock, waiting if needed.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    lock (void);
+
+    /**
+     * @brief Try to acquire the lock, without waiting.
+     * @par Parameters
+     *  None.
+     * @retval true The lock was acquired.
+     * @retval false The lock is taken.
+     */
+    bool
+    try_lock (void);
+
+    /**
+     * @brief Release the lock.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlock (void);
+
+  protected:
+    /**
+     * @brief The lock flag.
+     */
+    std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+  };
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "locks-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_LOCKS_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,308 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_NODE_POOL_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_NODE_POOL_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @details
+   * The storage is left untouched; slots are handed out in
+   * order the first time, and from the free list afterwards.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  constexpr node_pool<T, N, MP, Capacity, Lock>::node_pool ()
+  {
+  }
+
+  /**
+   * @details
+   * The objects still allocated are not destroyed.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  constexpr node_pool<T, N, MP, Capacity, Lock>::~node_pool ()
+  {
+  }
+
+  /**
+   * @details
+   * Recently freed slots are reused first (LIFO), since they are
+   * more likely to still be in the cache.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  typename node_pool<T, N, MP, Capacity, Lock>::pointer
+  node_pool<T, N, MP, Capacity, Lock>::allocate (void)
+  {
+    pointer object = nullptr;
+
+    lock_.lock ();
+    if (!free_list_.empty ())
+      {
+        object = free_list_.unlink_head ();
+      }
+    else if (unused_index_ < Capacity)
+      {
+        object = slot (unused_index_++);
+      }
+
+    if (object != nullptr)
+      {
+        --available_;
+      }
+    lock_.unlock ();
+
+    return object;
+  }
+
+  /**
+   * @details
+   * A fresh links node is constructed in place of the MP member
+   * of the destroyed object (outside the lock, since the slot is
+   * not yet shared) and linked to the head of the free list.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  void
+  node_pool<T, N, MP, Capacity, Lock>::deallocate (pointer object)
+  {
+    assert (owns (object));
+
+    ::new (static_cast<void*> (&(object->*MP))) N{};
+
+    lock_.lock ();
+    free_list_.link_head (*object);
+    ++available_;
+    lock_.unlock ();
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  template <class... Args>
+  typename node_pool<T, N, MP, Capacity, Lock>::pointer
+  node_pool<T, N, MP, Capacity, Lock>::create (Args&&... args)
+  {
+    pointer object = allocate ();
+    if (object == nullptr)
+      {
+        return nullptr;
+      }
+
+    return ::new (static_cast<void*> (object))
+        T (std::forward<Args> (args)...);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  void
+  node_pool<T, N, MP, Capacity, Lock>::destroy (pointer object)
+  {
+    object->~T ();
+    deallocate (object);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  bool
+  node_pool<T, N, MP, Capacity, Lock>::owns (const value_type* object) const
+  {
+    const auto address = reinterpret_cast<const std::byte*> (object);
+    return (address >= &storage_[0])
+           && (address < &storage_[0] + sizeof (storage_));
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  constexpr typename node_pool<T, N, MP, Capacity, Lock>::size_type
+  node_pool<T, N, MP, Capacity, Lock>::capacity (void)
+  {
+    return Capacity;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  typename node_pool<T, N, MP, Capacity, Lock>::size_type
+  node_pool<T, N, MP, Capacity, Lock>::available (void) const
+  {
+    lock_.lock ();
+    const size_type count = available_;
+    lock_.unlock ();
+
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity, class Lock>
+  inline typename node_pool<T, N, MP, Capacity, Lock>::pointer
+  node_pool<T, N, MP, Capacity, Lock>::slot (size_type index)
+  {
+    return reinterpret_cast<pointer> (&storage_[index * sizeof (T)]);
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  constexpr node_slab<T, N, MP, ChunkCapacity, Lock>::node_slab ()
+  {
+  }
+
+  /**
+   * @details
+   * All chunks are returned to the heap; the objects still allocated
+   * are not destroyed.
+   */
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  node_slab<T, N, MP, ChunkCapacity, Lock>::~node_slab ()
+  {
+    // The free slots point inside the chunks, forget them first.
+    free_list_.clear ();
+
+    while (chunks_ != nullptr)
+      {
+        chunk* next = chunks_->next;
+        ::operator delete (static_cast<void*> (chunks_),
+                           std::align_val_t{ alignof (chunk) });
+        chunks_ = next;
+      }
+  }
+
+  /**
+   * @details
+   * Recently freed slots are reused first (LIFO); when there are none,
+   * the slots of the last chunk are handed out in order, and when
+   * the last chunk is exhausted, a new one is allocated.
+   */
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  typename node_slab<T, N, MP, ChunkCapacity, Lock>::pointer
+  node_slab<T, N, MP, ChunkCapacity, Lock>::allocate (void)
+  {
+    pointer object = nullptr;
+
+    lock_.lock ();
+    if (!free_list_.empty ())
+      {
+        object = free_list_.unlink_head ();
+      }
+    else
+      {
+        if (unused_index_ >= ChunkCapacity)
+          {
+            void* storage
+                = ::operator new (sizeof (chunk),
+                                  std::align_val_t{ alignof (chunk) },
+                                  std::nothrow);
+            if (storage != nullptr)
+              {
+                chunk* new_chunk = ::new (storage) chunk;
+                new_chunk->next = chunks_;
+                chunks_ = new_chunk;
+                ++chunks_count_;
+                unused_index_ = 0;
+              }
+          }
+
+        if (unused_index_ < ChunkCapacity)
+          {
+            object = reinterpret_cast<pointer> (
+                &chunks_->storage[unused_index_++ * sizeof (T)]);
+          }
+      }
+    lock_.unlock ();
+
+    return object;
+  }
+
+  /**
+   * @details
+   * A fresh links node is constructed in place of the MP member
+   * of the destroyed object and linked to the head of the free list.
+   */
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  void
+  node_slab<T, N, MP, ChunkCapacity, Lock>::deallocate (pointer object)
+  {
+    ::new (static_cast<void*> (&(object->*MP))) N{};
+
+    lock_.lock ();
+    free_list_.link_head (*object);
+    lock_.unlock ();
+  }
+
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  template <class... Args>
+  typename node_slab<T, N, MP, ChunkCapacity, Lock>::pointer
+  node_slab<T, N, MP, ChunkCapacity, Lock>::create (Args&&... args)
+  {
+    pointer object = allocate ();
+    if (object == nullptr)
+      {
+        return nullptr;
+      }
+
+    return ::new (static_cast<void*> (object))
+        T (std::forward<Args> (args)...);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  void
+  node_slab<T, N, MP, ChunkCapacity, Lock>::destroy (pointer object)
+  {
+    object->~T ();
+    deallocate (object);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity,
+            class Lock>
+  typename node_slab<T, N, MP, ChunkCapacity, Lock>::size_type
+  node_slab<T, N, MP, ChunkCapacity, Lock>::capacity (void) const
+  {
+    lock_.lock ();
+    const size_type count = chunks_count_;
+    lock_.unlock ();
+
+    return count * ChunkCapacity;
+  }
+
+  // ==========================================================================
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_NODE_POOL_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,477 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Pools of objects that are to be linked into intrusive lists.
+ *
+ * Instead of allocating each object with `new`, the pools keep a
+ * reserve of storage slots and manage the free slots with an intrusive
+ * list threaded through the very links member that the objects use
+ * when they are in service; thus a free slot costs no extra memory.
+ *
+ * Both allocation and deallocation are O(1). By default the pools
+ * are not synchronised; pools shared between threads or interrupts
+ * take a lock policy (like `spin_lock`, an RTOS mutex or an interrupts
+ * critical section), held only for the few free list updates.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_NODE_POOL_H_
+#define MICRO_OS_PLUS_UTILS_NODE_POOL_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-allocators
+   * @brief A class template for a statically allocated pool of objects
+   * that can be linked into intrusive lists.
+   * @headerfile node-pool.h <micro-os-plus/utils/node-pool.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam Capacity Number of objects in the pool.
+   * @tparam Lock Type of the lock protecting the free slots
+   *  (BasicLockable); by default the pool is not synchronised.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * using threads_pool = utils::node_pool<
+   * thread, utils::double_list_links, &thread::child_links_, 16>;
+   *
+   * // Shared by several threads.
+   * using messages_pool = utils::node_pool<
+   * message, utils::double_list_links, &message::links_, 64,
+   * utils::spin_lock>;
+   * @endcode
+   *
+   * @details
+   * The storage for all objects is part of the pool object, so a
+   * pool defined in the global scope does not use the heap at all.
+   *
+   * The free slots are kept in an intrusive list threaded through
+   * the MP member of the (not yet constructed) objects.
+   * Slots that were never used are handed out from a separate
+   * index, so constructing the pool does not touch the storage.
+   *
+   * @note
+   * The pool returns storage, not objects; use `create()` and
+   * `destroy()` to also run the constructors and destructors.
+   *
+   * The lock is taken only for the free list and the counters;
+   * the constructors and the destructors run outside it.
+   * With the default `null_lock`, concurrent calls must be
+   * serialised by the caller.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity,
+            class Lock = null_lock>
+  class node_pool
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+    static_assert (Capacity > 0, "Capacity must be positive!");
+
+    /**
+     * @brief Type of the objects in the pool.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object in the pool.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object in the pool.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the list used to keep the free slots.
+     */
+    using free_list_type = intrusive_list<T, N, MP>;
+
+    /**
+     * @brief Type of sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Construct an empty pool (all slots free).
+     */
+    constexpr node_pool ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    node_pool (const node_pool&) = delete;
+    node_pool (node_pool&&) = delete;
+    node_pool&
+    operator= (const node_pool&)
+        = delete;
+    node_pool&
+    operator= (node_pool&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the pool.
+     */
+    constexpr ~node_pool ();
+
+  public:
+    /**
+     * @brief Allocate storage for an object.
+     * @par Parameters
+     *  None.
+     * @return Pointer to uninitialised storage, or `nullptr` if the
+     *  pool is exhausted.
+     */
+    pointer
+    allocate (void);
+
+    /**
+     * @brief Return the storage of an object to the pool.
+     * @param [in] object Pointer to storage obtained from `allocate()`;
+     *  the object must already be destroyed.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    deallocate (pointer object);
+
+    /**
+     * @brief Allocate storage and construct an object.
+     * @param [in] args Arguments passed to the constructor.
+     * @return Pointer to the new object, or `nullptr` if the
+     *  pool is exhausted.
+     */
+    template <class... Args>
+    pointer
+    create (Args&&... args);
+
+    /**
+     * @brief Destruct an object and return its storage to the pool.
+     * @param [in] object Pointer to an object obtained from `create()`.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    destroy (pointer object);
+
+    /**
+     * @brief Check if the object storage belongs to this pool.
+     * @param [in] object Pointer to an object.
+     * @retval true The object is inside the pool storage.
+     * @retval false The object is not managed by this pool.
+     */
+    bool
+    owns (const value_type* object) const;
+
+    /**
+     * @brief Get the number of objects the pool can hold.
+     * @par Parameters
+     *  None.
+     * @return The pool capacity.
+     */
+    static constexpr size_type
+    capacity (void);
+
+    /**
+     * @brief Get the number of slots still available.
+     * @par Parameters
+     *  None.
+     * @return The number of free slots.
+     */
+    size_type
+    available (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Get the address of a slot.
+     * @param [in] index Slot index.
+     * @return A pointer to the slot storage.
+     */
+    pointer
+    slot (size_type index);
+
+    /**
+     * @brief The storage for all objects.
+     */
+    alignas (T) std::byte storage_[sizeof (T) * Capacity];
+
+    /**
+     * @brief The list of slots returned to the pool.
+     */
+    free_list_type free_list_;
+
+    /**
+     * @brief Index of the first slot that was never allocated.
+     */
+    size_type unused_index_ = 0;
+
+    /**
+     * @brief Number of slots still available.
+     */
+    size_type available_ = Capacity;
+
+    /**
+     * @brief The lock protecting the free list and the counters.
+     */
+    mutable lock_type lock_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-allocators
+   * @brief A class template for a growable pool of objects
+   * that can be linked into intrusive lists.
+   * @headerfile node-pool.h <micro-os-plus/utils/node-pool.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam ChunkCapacity Number of objects in each chunk.
+   * @tparam Lock Type of the lock protecting the free slots
+   *  (BasicLockable); by default the slab is not synchronised.
+   *
+   * @details
+   * Similar to `node_pool`, but the storage is allocated from the
+   * heap in chunks of `ChunkCapacity` objects, when the free slots
+   * are exhausted; with a lock, the new chunk is also allocated
+   * with the lock held.
+   *
+   * Chunks are never returned to the heap while the slab is alive;
+   * after a warm-up period, allocations no longer reach the heap.
+   */
+  template <class T, class N, N T::*MP, std::size_t ChunkCapacity = 32,
+            class Lock = null_lock>
+  class node_slab
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+    static_assert (ChunkCapacity > 0, "ChunkCapacity must be positive!");
+
+    /**
+     * @brief Type of the objects in the slab.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object in the slab.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object in the slab.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the list used to keep the free slots.
+     */
+    using free_list_type = intrusive_list<T, N, MP>;
+
+    /**
+     * @brief Type of sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Construct an empty slab (no chunks allocated).
+     */
+    constexpr node_slab ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    node_slab (const node_slab&) = delete;
+    node_slab (node_slab&&) = delete;
+    node_slab&
+    operator= (const node_slab&)
+        = delete;
+    node_slab&
+    operator= (node_slab&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the slab and free all chunks.
+     */
+    ~node_slab ();
+
+  public:
+    /**
+     * @brief Allocate storage for an object.
+     * @par Parameters
+     *  None.
+     * @return Pointer to uninitialised storage, or `nullptr` if a new
+     *  chunk was needed and the heap is exhausted.
+     */
+    pointer
+    allocate (void);
+
+    /**
+     * @brief Return the storage of an object to the slab.
+     * @param [in] object Pointer to storage obtained from `allocate()`;
+     *  the object must already be destroyed.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    deallocate (pointer object);
+
+    /**
+     * @brief Allocate storage and construct an object.
+     * @param [in] args Arguments passed to the constructor.
+     * @return Pointer to the new object, or `nullptr` if the
+     *  heap is exhausted.
+     */
+    template <class... Args>
+    pointer
+    create (Args&&... args);
+
+    /**
+     * @brief Destruct an object and return its storage to the slab.
+     * @param [in] object Pointer to an object obtained from `create()`.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    destroy (pointer object);
+
+    /**
+     * @brief Get the number of objects the allocated chunks can hold.
+     * @par Parameters
+     *  None.
+     * @return The current capacity.
+     */
+    size_type
+    capacity (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief A chunk of storage, allocated from the heap.
+     */
+    struct chunk
+    {
+      /**
+       * @brief Link to the previously allocated chunk.
+       */
+      chunk* next;
+
+      /**
+       * @brief The storage for the chunk objects.
+       */
+      alignas (T) std::byte storage[sizeof (T) * ChunkCapacity];
+    };
+
+    /**
+     * @brief The list of slots returned to the slab.
+     */
+    free_list_type free_list_;
+
+    /**
+     * @brief The most recently allocated chunk.
+     */
+    chunk* chunks_ = nullptr;
+
+    /**
+     * @brief Index of the first slot in the last chunk that was
+     * never allocated.
+     */
+    size_type unused_index_ = ChunkCapacity;
+
+    /**
+     * @brief Number of allocated chunks.
+     */
+    size_type chunks_count_ = 0;
+
+    /**
+     * @brief The lock protecting the free list and the chunks.
+     */
+    mutable lock_type lock_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "node-pool-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_NODE_POOL_H_
+
+// ----------------------------------------------------------------------------
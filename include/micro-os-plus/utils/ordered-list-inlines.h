@@ -0,0 +1,343 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_ORDERED_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_ORDERED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  constexpr ordered_list_links::ordered_list_links ()
+  {
+  }
+
+  constexpr ordered_list_links::~ordered_list_links ()
+  {
+  }
+
+  inline void
+  ordered_list_links::initialize (void)
+  {
+    next_.store (0, std::memory_order_relaxed);
+  }
+
+  inline ordered_list_links*
+  ordered_list_links::next (bool& marked, std::memory_order order) const
+  {
+    const std::uintptr_t word = next_.load (order);
+    marked = (word & 1) != 0;
+    return reinterpret_cast<ordered_list_links*> (word & ~std::uintptr_t{ 1 });
+  }
+
+  inline void
+  ordered_list_links::next (ordered_list_links* node, std::memory_order order)
+  {
+    next_.store (reinterpret_cast<std::uintptr_t> (node), order);
+  }
+
+  /**
+   * @details
+   * The expected value has no mark, so the exchange fails
+   * if the node was marked meanwhile.
+   */
+  inline bool
+  ordered_list_links::compare_exchange_next (ordered_list_links* expected,
+                                             ordered_list_links* desired)
+  {
+    auto word = reinterpret_cast<std::uintptr_t> (expected);
+    return next_.compare_exchange_strong (
+        word, reinterpret_cast<std::uintptr_t> (desired),
+        std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+  inline bool
+  ordered_list_links::mark (void)
+  {
+    return (next_.fetch_or (1, std::memory_order_acq_rel) & 1) == 0;
+  }
+
+  inline bool
+  ordered_list_links::marked (void) const
+  {
+    return (next_.load (std::memory_order_acquire) & 1) != 0;
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, class Compare>
+  ordered_intrusive_list<T, N, MP, Compare>::ordered_intrusive_list (
+      compare_type compare)
+      : compare_{ compare }
+  {
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  ordered_intrusive_list<T, N, MP, Compare>::~ordered_intrusive_list ()
+  {
+  }
+
+  /**
+   * @details
+   * The new node is linked to its successor before being
+   * published with the compare-and-swap; if the predecessor
+   * changed (or was marked), the position is searched again.
+   */
+  template <class T, class N, N T::*MP, class Compare>
+  bool
+  ordered_intrusive_list<T, N, MP, Compare>::insert (reference element)
+  {
+    ordered_list_links* node = &(element.*MP);
+
+    ordered_list_links* previous;
+    ordered_list_links* current;
+    while (true)
+      {
+        if (search_ (element, previous, current))
+          {
+            return false;
+          }
+
+        node->next (current, std::memory_order_relaxed);
+        if (previous->compare_exchange_next (current, node))
+          {
+            return true;
+          }
+      }
+  }
+
+  /**
+   * @details
+   * The thread that marks the node owns the erase. If unlinking it
+   * fails, another search is done, which unlinks it (or finds it
+   * already unlinked by another thread); either way, on return the
+   * node is no longer reachable from the list.
+   */
+  template <class T, class N, N T::*MP, class Compare>
+  template <class K>
+  typename ordered_intrusive_list<T, N, MP, Compare>::pointer
+  ordered_intrusive_list<T, N, MP, Compare>::erase (const K& key)
+  {
+    ordered_list_links* previous;
+    ordered_list_links* current;
+    while (true)
+      {
+        if (!search_ (key, previous, current))
+          {
+            return nullptr;
+          }
+
+        if (!current->mark ())
+          {
+            // Erased by another thread, search again.
+            continue;
+          }
+
+        bool marked;
+        ordered_list_links* next = current->next (marked);
+        if (!previous->compare_exchange_next (current, next))
+          {
+            ordered_list_links* node = current;
+            search_ (key, previous, current);
+            current = node;
+          }
+
+        return get_pointer_ (current);
+      }
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  template <class K, class R>
+  bool
+  ordered_intrusive_list<T, N, MP, Compare>::erase (const K& key,
+                                                    R& reclaimer)
+  {
+    pointer element = erase (key);
+    if (element == nullptr)
+      {
+        return false;
+      }
+
+    reclaimer.retire (*element);
+    return true;
+  }
+
+  /**
+   * @details
+   * The marked nodes are skipped, not unlinked.
+   */
+  template <class T, class N, N T::*MP, class Compare>
+  template <class K>
+  typename ordered_intrusive_list<T, N, MP, Compare>::pointer
+  ordered_intrusive_list<T, N, MP, Compare>::find (const K& key) const
+  {
+    bool marked;
+    ordered_list_links* current = head_.next (marked);
+    while (current != nullptr)
+      {
+        ordered_list_links* next = current->next (marked);
+        pointer element = get_pointer_ (current);
+        if (!compare_ (*element, key))
+          {
+            if (marked || compare_ (key, *element))
+              {
+                return nullptr;
+              }
+            return element;
+          }
+        current = next;
+      }
+
+    return nullptr;
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  template <class K>
+  inline bool
+  ordered_intrusive_list<T, N, MP, Compare>::contains (const K& key) const
+  {
+    return find (key) != nullptr;
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  template <class F>
+  void
+  ordered_intrusive_list<T, N, MP, Compare>::for_each (F&& function) const
+  {
+    bool marked;
+    ordered_list_links* current = head_.next (marked);
+    while (current != nullptr)
+      {
+        ordered_list_links* next = current->next (marked);
+        if (!marked)
+          {
+            function (*get_pointer_ (current));
+          }
+        current = next;
+      }
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  bool
+  ordered_intrusive_list<T, N, MP, Compare>::empty (void) const
+  {
+    bool marked;
+    ordered_list_links* current = head_.next (marked);
+    while (current != nullptr)
+      {
+        ordered_list_links* next = current->next (marked);
+        if (!marked)
+          {
+            return false;
+          }
+        current = next;
+      }
+
+    return true;
+  }
+
+  /**
+   * @details
+   * When a marked node is found, it is unlinked from its
+   * predecessor; if this fails, the predecessor changed or was
+   * marked itself, and the search restarts from the head.
+   */
+  template <class T, class N, N T::*MP, class Compare>
+  template <class K>
+  bool
+  ordered_intrusive_list<T, N, MP, Compare>::search_ (
+      const K& key, ordered_list_links*& previous,
+      ordered_list_links*& current)
+  {
+  retry:
+    previous = &head_;
+    bool marked;
+    current = previous->next (marked);
+    while (current != nullptr)
+      {
+        ordered_list_links* next = current->next (marked);
+        if (marked)
+          {
+            if (!previous->compare_exchange_next (current, next))
+              {
+                goto retry;
+              }
+            current = next;
+            continue;
+          }
+
+        pointer element = get_pointer_ (current);
+        if (!compare_ (*element, key))
+          {
+            return !compare_ (key, *element);
+          }
+
+        previous = current;
+        current = next;
+      }
+
+    return false;
+  }
+
+  template <class T, class N, N T::*MP, class Compare>
+  inline typename ordered_intrusive_list<T, N, MP, Compare>::pointer
+  ordered_intrusive_list<T, N, MP, Compare>::get_pointer_ (
+      ordered_list_links* node)
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<std::ptrdiff_t> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    // Compute the address of the object which includes the
+    // intrusive node, by adjusting down the node address.
+    return reinterpret_cast<pointer> (
+        reinterpret_cast<std::ptrdiff_t> (static_cast<N*> (node)) - offset);
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_ORDERED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,426 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Lock-free ordered intrusive lists (Harris-Michael).
+ *
+ * The elements are kept sorted in a singly linked list, with the
+ * least significant bit of the **next** link used as a mark. An
+ * element is erased in two steps: first its link is marked (the
+ * logical removal, after which the link can no longer change),
+ * then it is unlinked from its predecessor (the physical removal),
+ * either by the eraser or by any thread that traverses it.
+ *
+ * The erased elements may still be read by concurrent traversals;
+ * they must be passed to a reclamation scheme (like a retire list),
+ * and the operations must be called inside its read-side critical
+ * sections (like those of an RCU reader).
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_ORDERED_LIST_H_
+#define MICRO_OS_PLUS_UTILS_ORDERED_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @brief The node of a lock-free ordered list, with a
+   * markable **next** link.
+   * @headerfile ordered-list.h <micro-os-plus/utils/ordered-list.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The nodes are aligned to at least 2 bytes, so the least
+   * significant bit of the pointers is free to be used as a mark.
+   */
+  class ordered_list_links
+  {
+  public:
+    /**
+     * @brief Construct an unlinked node.
+     */
+    constexpr ordered_list_links ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    ordered_list_links (const ordered_list_links&) = delete;
+    ordered_list_links (ordered_list_links&&) = delete;
+    ordered_list_links&
+    operator= (const ordered_list_links&)
+        = delete;
+    ordered_list_links&
+    operator= (ordered_list_links&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the node.
+     */
+    constexpr ~ordered_list_links ();
+
+    /**
+     * @brief Clear the link and the mark.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    initialize (void);
+
+    /**
+     * @brief Get the link to the **next** node and the mark.
+     * @param [out] marked Set to true if the node is logically removed.
+     * @param [in] order The memory order of the load.
+     * @return Pointer to the next node, or `nullptr` at the end
+     *  of the list.
+     */
+    ordered_list_links*
+    next (bool& marked,
+          std::memory_order order = std::memory_order_acquire) const;
+
+    /**
+     * @brief Set the link to the **next** node, without mark.
+     * @param [in] node Pointer to the next node.
+     * @param [in] order The memory order of the store.
+     * @par Returns
+     *  Nothing.
+     *
+     * @warning
+     * Low level accessor, only for nodes not yet published.
+     */
+    void
+    next (ordered_list_links* node,
+          std::memory_order order = std::memory_order_relaxed);
+
+    /**
+     * @brief Replace the link to the **next** node, if not marked.
+     * @param [in] expected Pointer to the expected next node.
+     * @param [in] desired Pointer to the new next node.
+     * @retval true The link was replaced.
+     * @retval false The link changed, or the node was marked.
+     */
+    bool
+    compare_exchange_next (ordered_list_links* expected,
+                           ordered_list_links* desired);
+
+    /**
+     * @brief Mark the node as logically removed.
+     * @par Parameters
+     *  None.
+     * @retval true The node was marked by this call.
+     * @retval false The node was already marked.
+     */
+    bool
+    mark (void);
+
+    /**
+     * @brief Check if the node is marked.
+     * @par Parameters
+     *  None.
+     * @retval true The node is logically removed.
+     * @retval false The node is not marked.
+     */
+    bool
+    marked (void) const;
+
+  protected:
+    /**
+     * @brief The **next** link, with the mark in the least
+     * significant bit.
+     */
+    std::atomic<std::uintptr_t> next_{ 0 };
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a lock-free ordered intrusive list.
+   * @headerfile ordered-list.h <micro-os-plus/utils/ordered-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node, derived from `ordered_list_links`.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam Compare Type of the strict weak ordering, callable with
+   *  elements and keys in both positions.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::ordered_intrusive_list<session, utils::ordered_list_links,
+   *     &session::table_links_> table;
+   *
+   * reader.lock ();
+   * table.insert (*s);
+   * bool found = table.contains (id);
+   * session* erased = table.erase (id);
+   * reader.unlock ();
+   *
+   * if (erased != nullptr)
+   *   {
+   *     retired.retire (*erased);
+   *   }
+   * @endcode
+   *
+   * @details
+   * The list is a set; elements with equivalent keys are
+   * not inserted twice.
+   *
+   * `insert()` and `erase()` are lock-free, `contains()` and
+   * `find()` are wait-free and do not write to the list.
+   *
+   * The reclamation scheme is chosen by the caller: `erase()`
+   * returns the element once it is no longer reachable from the
+   * list, or passes it to any object with a `retire (reference)`
+   * method, like a per-thread `retire_list`.
+   *
+   * @warning
+   * Unless the erased elements are never reused while the list
+   * is in use, all operations must be called inside a read-side
+   * critical section of the reclamation scheme.
+   */
+  template <class T, class N, N T::*MP, class Compare = std::less<>>
+  class ordered_intrusive_list
+  {
+  public:
+    static_assert (std::is_base_of<ordered_list_links, N>::value == true,
+                   "N must be derived from ordered_list_links!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the ordering.
+     */
+    using compare_type = Compare;
+
+    /**
+     * @brief Construct an empty list.
+     * @param [in] compare The ordering.
+     */
+    explicit ordered_intrusive_list (compare_type compare = compare_type{});
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    ordered_intrusive_list (const ordered_intrusive_list&) = delete;
+    ordered_intrusive_list (ordered_intrusive_list&&) = delete;
+    ordered_intrusive_list&
+    operator= (const ordered_intrusive_list&)
+        = delete;
+    ordered_intrusive_list&
+    operator= (ordered_intrusive_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~ordered_intrusive_list ();
+
+    /**
+     * @brief Insert an element in order.
+     * @param [in] element Reference to the element.
+     * @retval true The element was inserted.
+     * @retval false An element with an equivalent key is
+     *  already in the list.
+     */
+    bool
+    insert (reference element);
+
+    /**
+     * @brief Erase the element with the given key.
+     * @tparam K Type of the key.
+     * @param [in] key The key.
+     * @return Pointer to the erased element, no longer reachable
+     *  from the list, or `nullptr` if not found.
+     */
+    template <class K>
+    pointer
+    erase (const K& key);
+
+    /**
+     * @brief Erase the element with the given key and retire it.
+     * @tparam K Type of the key.
+     * @tparam R Type of the reclaimer, with a `retire (reference)`
+     *  method.
+     * @param [in] key The key.
+     * @param [in] reclaimer Reference to the reclaimer.
+     * @retval true The element was erased and retired.
+     * @retval false No element with the given key.
+     *
+     * @warning
+     * A `retire_list` may wait for the readers when its threshold
+     * is reached, so it must not be used inside a read-side critical
+     * section; in this case retire the element returned by
+     * `erase (key)` after leaving it.
+     */
+    template <class K, class R>
+    bool
+    erase (const K& key, R& reclaimer);
+
+    /**
+     * @brief Find the element with the given key.
+     * @tparam K Type of the key.
+     * @param [in] key The key.
+     * @return Pointer to the element, or `nullptr` if not found.
+     */
+    template <class K>
+    pointer
+    find (const K& key) const;
+
+    /**
+     * @brief Check if an element with the given key is in the list.
+     * @tparam K Type of the key.
+     * @param [in] key The key.
+     * @retval true The element was found.
+     * @retval false The element was not found.
+     */
+    template <class K>
+    bool
+    contains (const K& key) const;
+
+    /**
+     * @brief Call a function for all elements, in order.
+     * @tparam F Type of the function, called with a reference.
+     * @param [in] function The function.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * The elements erased during the traversal may or may not
+     * be visited.
+     */
+    template <class F>
+    void
+    for_each (F&& function) const;
+
+    /**
+     * @brief Check if the list is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The list has no elements.
+     * @retval false The list has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Find the position of a key, unlinking the marked
+     * nodes on the way.
+     * @tparam K Type of the key.
+     * @param [in] key The key.
+     * @param [out] previous Set to the last node before the key.
+     * @param [out] current Set to the first node not before the key.
+     * @retval true The current node has an equivalent key.
+     * @retval false The key is not in the list.
+     */
+    template <class K>
+    bool
+    search_ (const K& key, ordered_list_links*& previous,
+             ordered_list_links*& current);
+
+    /**
+     * @brief Get the address of the element from the node.
+     * @param [in] node Pointer to the node.
+     * @return Pointer to the element.
+     */
+    static pointer
+    get_pointer_ (ordered_list_links* node);
+
+    /**
+     * @brief The head of the list, not part of any element.
+     */
+    ordered_list_links head_;
+
+    /**
+     * @brief The ordering.
+     */
+    compare_type compare_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "ordered-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_ORDERED_LIST_H_
+
+// ----------------------------------------------------------------------------
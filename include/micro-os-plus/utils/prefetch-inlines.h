@@ -0,0 +1,180 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_PREFETCH_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_PREFETCH_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @details
+   * The prefetch is for reading, with high temporal locality.
+   */
+  inline void
+  prefetch_address ([[maybe_unused]] const void* address)
+  {
+#if defined(__GNUC__)
+    __builtin_prefetch (address, 0, 3);
+#endif
+  }
+
+  // ==========================================================================
+
+  template <class I, bool Objects>
+  constexpr prefetch_iterator<I, Objects>::prefetch_iterator ()
+      : current_{}, end_{}
+  {
+  }
+
+  template <class I, bool Objects>
+  prefetch_iterator<I, Objects>::prefetch_iterator (iterator_type current,
+                                                    iterator_type end)
+      : current_{ current }, end_{ end }
+  {
+    prefetch_next_ ();
+  }
+
+  template <class I, bool Objects>
+  inline typename prefetch_iterator<I, Objects>::pointer
+  prefetch_iterator<I, Objects>::operator->() const
+  {
+    return current_.operator->();
+  }
+
+  template <class I, bool Objects>
+  inline typename prefetch_iterator<I, Objects>::reference
+  prefetch_iterator<I, Objects>::operator* () const
+  {
+    return *current_;
+  }
+
+  template <class I, bool Objects>
+  inline prefetch_iterator<I, Objects>&
+  prefetch_iterator<I, Objects>::operator++ ()
+  {
+    ++current_;
+    prefetch_next_ ();
+    return *this;
+  }
+
+  template <class I, bool Objects>
+  inline prefetch_iterator<I, Objects>
+  prefetch_iterator<I, Objects>::operator++ (int)
+  {
+    const auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  template <class I, bool Objects>
+  inline bool
+  prefetch_iterator<I, Objects>::operator== (
+      const prefetch_iterator& other) const
+  {
+    return current_ == other.current_;
+  }
+
+  template <class I, bool Objects>
+  inline bool
+  prefetch_iterator<I, Objects>::operator!= (
+      const prefetch_iterator& other) const
+  {
+    return current_ != other.current_;
+  }
+
+  template <class I, bool Objects>
+  constexpr typename prefetch_iterator<I, Objects>::iterator_type
+  prefetch_iterator<I, Objects>::base (void) const
+  {
+    return current_;
+  }
+
+  /**
+   * @details
+   * The current node is about to be used, so reading its **next**
+   * pointer does not add a stall.
+   */
+  template <class I, bool Objects>
+  inline void
+  prefetch_iterator<I, Objects>::prefetch_next_ (void) const
+  {
+    if (current_ == end_)
+      {
+        return;
+      }
+
+    auto next = current_;
+    ++next;
+    if (next == end_)
+      {
+        return;
+      }
+
+    prefetch_address (next.get_iterator_pointer ());
+
+    if constexpr (Objects)
+      {
+        prefetch_address (next.get_pointer ());
+      }
+  }
+
+  // ==========================================================================
+
+  template <bool Objects, class L, class F>
+  void
+  for_each_prefetch (const L& list, F&& function)
+  {
+    using iterator = prefetch_iterator<typename L::iterator, Objects>;
+
+    const auto end = list.end ();
+    for (iterator it{ list.begin (), end }; it.base () != end;
+         ++it)
+      {
+        function (*it);
+      }
+  }
+
+  // ==========================================================================
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_PREFETCH_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,233 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Traversal of long lists with software prefetching.
+ *
+ * Walking a long list is a chain of dependent loads; when the nodes
+ * are not in the cache, each step waits for the memory. The
+ * definitions in this file ask the CPU to fetch the next node while
+ * the current one is processed, so that the memory access overlaps
+ * with the processing of the current element.
+ *
+ * The address of a node is known only after the previous node is
+ * loaded, thus a list cannot be prefetched more than one node ahead
+ * without walking it; the lead is one node, and the benefit is
+ * limited to the time spent processing each element.
+ *
+ * On compilers without `__builtin_prefetch()`, the prefetches
+ * are ignored.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_PREFETCH_H_
+#define MICRO_OS_PLUS_UTILS_PREFETCH_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <iterator>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief Hint the CPU to bring an address into the cache.
+   * @param [in] address The address to prefetch.
+   * @par Returns
+   *  Nothing.
+   */
+  inline void
+  prefetch_address (const void* address);
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for an iterator adaptor that prefetches
+   * the nodes ahead.
+   * @headerfile prefetch.h <micro-os-plus/utils/prefetch.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam I Type of the list iterator (like `intrusive_list::iterator`).
+   * @tparam Objects If `true`, also prefetch the beginning of the
+   *  objects that contain the nodes ahead.
+   *
+   * @details
+   * Each time the iterator reaches a node, the next node is
+   * prefetched, so that it is loaded while the current element
+   * is processed.
+   *
+   * The lead is a single node: the address of the node after the
+   * next one is not known until the next one is in the cache,
+   * and walking further ahead would only move the same stalls
+   * to the walk ahead.
+   *
+   * For intrusive lists, the links may be in a different cache
+   * line than the payload; `Objects` prefetches the object
+   * computed from the node address via the MP offset.
+   */
+  template <class I, bool Objects = false>
+  class prefetch_iterator
+  {
+  public:
+    /**
+     * @brief Type of the underlying iterator.
+     */
+    using iterator_type = I;
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = typename I::value_type;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = typename I::pointer;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = typename I::reference;
+
+    /**
+     * @brief Type of pointer difference.
+     */
+    using difference_type = typename I::difference_type;
+
+    /**
+     * @brief Category of iterator.
+     */
+    using iterator_category = std::forward_iterator_tag;
+
+    // ------------------------------------------------------------------------
+    constexpr prefetch_iterator ();
+
+    /**
+     * @brief Construct an iterator that prefetches the next node.
+     * @param [in] current The position of the iterator.
+     * @param [in] end The end of the list.
+     */
+    prefetch_iterator (iterator_type current, iterator_type end);
+
+    // DO NOT delete the copy constructors, since the default one are
+    // used.
+
+    pointer
+    operator->() const;
+
+    reference
+    operator* () const;
+
+    prefetch_iterator&
+    operator++ ();
+
+    prefetch_iterator
+    operator++ (int);
+
+    bool
+    operator== (const prefetch_iterator& other) const;
+
+    bool
+    operator!= (const prefetch_iterator& other) const;
+
+    /**
+     * @brief Get the underlying iterator.
+     * @return The iterator at the current position.
+     */
+    constexpr iterator_type
+    base (void) const;
+
+  protected:
+    /**
+     * @brief Prefetch the node after the current one.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    prefetch_next_ (void) const;
+
+    /**
+     * @brief The current position.
+     */
+    iterator_type current_;
+
+    /**
+     * @brief The end of the list.
+     */
+    iterator_type end_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief Invoke a function for all list elements, prefetching
+   * the next node.
+   * @tparam Objects If `true`, also prefetch the next object.
+   * @tparam L Type of the list (like `intrusive_list`).
+   * @tparam F Type of the callable object.
+   * @param [in] list Reference to the list.
+   * @param [in] function Callable object invoked with a reference to
+   *  each element, in order.
+   * @par Returns
+   *  Nothing.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::for_each_prefetch (threads, [] (thread& t) { t.update (); });
+   * @endcode
+   */
+  template <bool Objects = false, class L, class F>
+  void
+  for_each_prefetch (const L& list, F&& function);
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "prefetch-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_PREFETCH_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_RCU_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_RCU_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  constexpr rcu_domain&
+  rcu_reader::domain (void) const
+  {
+    return domain_;
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP>
+  constexpr rcu_list_iterator<T, N, MP>::rcu_list_iterator () : node_{}
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr rcu_list_iterator<T, N, MP>::rcu_list_iterator (
+      double_list_links_base* node)
+      : node_{ node }
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename rcu_list_iterator<T, N, MP>::pointer
+  rcu_list_iterator<T, N, MP>::operator->() const
+  {
+    return get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename rcu_list_iterator<T, N, MP>::reference
+  rcu_list_iterator<T, N, MP>::operator* () const
+  {
+    return *get_pointer ();
+  }
+
+  template <class T, class N, N T::*MP>
+  inline rcu_list_iterator<T, N, MP>&
+  rcu_list_iterator<T, N, MP>::operator++ ()
+  {
+    node_ = node_->next (std::memory_order_acquire);
+    return *this;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline rcu_list_iterator<T, N, MP>
+  rcu_list_iterator<T, N, MP>::operator++ (int)
+  {
+    const auto tmp = *this;
+    node_ = node_->next (std::memory_order_acquire);
+    return tmp;
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr bool
+  rcu_list_iterator<T, N, MP>::operator== (
+      const rcu_list_iterator& other) const
+  {
+    return node_ == other.node_;
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr bool
+  rcu_list_iterator<T, N, MP>::operator!= (
+      const rcu_list_iterator& other) const
+  {
+    return node_ != other.node_;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename rcu_list_iterator<T, N, MP>::pointer
+  rcu_list_iterator<T, N, MP>::get_pointer (void) const
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<std::ptrdiff_t> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    // Compute the address of the object which includes the
+    // intrusive node, by adjusting down the node address.
+    return reinterpret_cast<pointer> (
+        reinterpret_cast<std::ptrdiff_t> (static_cast<N*> (node_)) - offset);
+  }
+
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP>
+  rcu_intrusive_list<T, N, MP>::rcu_intrusive_list (rcu_domain& domain)
+      : domain_{ domain }
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  rcu_intrusive_list<T, N, MP>::~rcu_intrusive_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP>
+  inline bool
+  rcu_intrusive_list<T, N, MP>::empty (void) const
+  {
+    return head_.next (std::memory_order_acquire) == &head_;
+  }
+
+  /**
+   * @details
+   * The new node is completely set up before being published,
+   * so readers either do not see it, or see it linked.
+   */
+  template <class T, class N, N T::*MP>
+  void
+  rcu_intrusive_list<T, N, MP>::link_tail (reference element)
+  {
+    writers_lock_.lock ();
+    publish_ (&(element.*MP), head_.previous (), &head_);
+    writers_lock_.unlock ();
+  }
+
+  template <class T, class N, N T::*MP>
+  void
+  rcu_intrusive_list<T, N, MP>::link_head (reference element)
+  {
+    writers_lock_.lock ();
+    publish_ (&(element.*MP), &head_, head_.next ());
+    writers_lock_.unlock ();
+  }
+
+  /**
+   * @details
+   * Only the neighbours are updated; the node keeps its links,
+   * so the readers that are positioned on it can continue
+   * the traversal.
+   */
+  template <class T, class N, N T::*MP>
+  void
+  rcu_intrusive_list<T, N, MP>::unlink (reference element)
+  {
+    double_list_links_base* node = &(element.*MP);
+
+    writers_lock_.lock ();
+
+    double_list_links_base* previous = node->previous ();
+    double_list_links_base* next = node->next ();
+    previous->next (next, std::memory_order_release);
+    next->previous (previous);
+
+    writers_lock_.unlock ();
+  }
+
+  template <class T, class N, N T::*MP>
+  void
+  rcu_intrusive_list<T, N, MP>::unlink_synchronize (reference element)
+  {
+    unlink (element);
+    domain_.synchronize ();
+    reinitialize (element);
+  }
+
+  template <class T, class N, N T::*MP>
+  inline void
+  rcu_intrusive_list<T, N, MP>::reinitialize (reference element)
+  {
+    (element.*MP).initialize ();
+  }
+
+  template <class T, class N, N T::*MP>
+  constexpr rcu_domain&
+  rcu_intrusive_list<T, N, MP>::domain (void) const
+  {
+    return domain_;
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename rcu_intrusive_list<T, N, MP>::iterator
+  rcu_intrusive_list<T, N, MP>::begin () const
+  {
+    return iterator{ head_.next (std::memory_order_acquire) };
+  }
+
+  template <class T, class N, N T::*MP>
+  inline typename rcu_intrusive_list<T, N, MP>::iterator
+  rcu_intrusive_list<T, N, MP>::end () const
+  {
+    return iterator{ const_cast<double_list_links*> (&head_) };
+  }
+
+  /**
+   * @details
+   * The **next** link of the previous node is the only one
+   * visible to readers, and it is stored last, with release
+   * semantics.
+   */
+  template <class T, class N, N T::*MP>
+  void
+  rcu_intrusive_list<T, N, MP>::publish_ (double_list_links_base* node,
+                                          double_list_links_base* previous,
+                                          double_list_links_base* next)
+  {
+    node->previous (previous);
+    node->next (next, std::memory_order_relaxed);
+    next->previous (node);
+    previous->next (node, std::memory_order_release);
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_RCU_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,629 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Read-mostly lists, with lock-free readers (RCU style).
+ *
+ * The readers traverse the list without locks and without atomic
+ * read-modify-write operations; they only announce, in a per-reader
+ * slot, that they are inside a read-side critical section.
+ *
+ * The writers are serialised by a spin lock, and publish the links
+ * with release stores, so that a reader always sees fully
+ * initialised nodes. An unlinked node may still be in use by the
+ * readers that reached it before it was unlinked; it can be reused
+ * only after a grace period, i.e. after all readers that were in a
+ * critical section when it was unlinked have left it.
+ *
+ * The grace periods are managed by a simple epoch based domain:
+ * a global epoch, incremented by `synchronize()`, and one slot per
+ * registered reader, storing the epoch when the reader entered its
+ * critical section.
+ *
+ * The definitions are available only on cores with atomic
+ * compare-and-swap.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_RCU_H_
+#define MICRO_OS_PLUS_UTILS_RCU_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  class rcu_domain;
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for a reader registered in an RCU domain.
+   * @headerfile rcu.h <micro-os-plus/utils/rcu.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * thread_local utils::rcu_reader reader{ domain };
+   *
+   * std::scoped_lock lock{ reader };
+   * for (auto& driver : drivers)
+   *   {
+   *     // ...
+   *   }
+   * @endcode
+   *
+   * @details
+   * Each thread that reads RCU lists needs its own reader object;
+   * `lock()` and `unlock()` delimit the read-side critical sections
+   * (they satisfy the _BasicLockable_ requirements, and can be nested).
+   *
+   * Entering a critical section costs a store and a full fence;
+   * leaving it costs a release store.
+   */
+  class rcu_reader
+  {
+  public:
+    /**
+     * @brief Type of the epochs.
+     */
+    using epoch_type = std::uintptr_t;
+
+    /**
+     * @brief Construct a reader and register it in the domain.
+     * @param [in] domain Reference to the RCU domain.
+     */
+    explicit rcu_reader (rcu_domain& domain);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    rcu_reader (const rcu_reader&) = delete;
+    rcu_reader (rcu_reader&&) = delete;
+    rcu_reader&
+    operator= (const rcu_reader&)
+        = delete;
+    rcu_reader&
+    operator= (rcu_reader&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Unregister the reader and destruct it.
+     */
+    ~rcu_reader ();
+
+    /**
+     * @brief Enter a read-side critical section.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    lock (void);
+
+    /**
+     * @brief Leave a read-side critical section.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlock (void);
+
+    /**
+     * @brief Get the domain.
+     * @par Parameters
+     *  None.
+     * @return Reference to the domain the reader is registered in.
+     */
+    constexpr rcu_domain&
+    domain (void) const;
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Links to the other readers registered in the domain.
+     */
+    double_list_links registry_links_;
+
+  protected:
+    friend class rcu_domain;
+
+    /**
+     * @brief The domain.
+     */
+    rcu_domain& domain_;
+
+    /**
+     * @brief The epoch when the reader entered the critical section,
+     * or 0 outside it.
+     */
+    std::atomic<epoch_type> epoch_{ 0 };
+
+    /**
+     * @brief The nesting level of the critical sections.
+     */
+    std::size_t nesting_ = 0;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class for an RCU domain (the global epoch and the
+   * registered readers).
+   * @headerfile rcu.h <micro-os-plus/utils/rcu.h>
+   * @ingroup micro-os-plus-utils
+   *
+   * @details
+   * The epochs are odd numbers, so that a reader slot with 0 means
+   * _not in a critical section_; they are compared modulo the
+   * word size, thus the wrap-around is harmless.
+   */
+  class rcu_domain
+  {
+  public:
+    /**
+     * @brief Type of the epochs.
+     */
+    using epoch_type = rcu_reader::epoch_type;
+
+    /**
+     * @brief Construct a domain without readers.
+     */
+    rcu_domain ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    rcu_domain (const rcu_domain&) = delete;
+    rcu_domain (rcu_domain&&) = delete;
+    rcu_domain&
+    operator= (const rcu_domain&)
+        = delete;
+    rcu_domain&
+    operator= (rcu_domain&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the domain; all readers must be destroyed first.
+     */
+    ~rcu_domain ();
+
+    /**
+     * @brief Wait for a grace period.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * Returns after all readers that were in a critical section
+     * when it was called have left it. Must not be called from
+     * a read-side critical section.
+     */
+    void
+    synchronize (void);
+
+    /**
+     * @brief Start a new epoch.
+     * @par Parameters
+     *  None.
+     * @return The new epoch.
+     */
+    epoch_type
+    advance (void);
+
+    /**
+     * @brief Check if a grace period elapsed since an epoch started.
+     * @param [in] epoch An epoch returned by `advance()`.
+     * @retval true No reader is still in a critical section entered
+     *  before the epoch.
+     * @retval false At least one reader may still use older nodes.
+     */
+    bool
+    is_quiescent (epoch_type epoch);
+
+    /**
+     * @brief Get the current epoch.
+     * @par Parameters
+     *  None.
+     * @return The current epoch.
+     */
+    epoch_type
+    epoch (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    friend class rcu_reader;
+
+    /**
+     * @brief Type of the list of registered readers.
+     */
+    using readers_list
+        = intrusive_list<rcu_reader, double_list_links,
+                         &rcu_reader::registry_links_>;
+
+    /**
+     * @brief The global epoch.
+     */
+    std::atomic<epoch_type> epoch_{ 1 };
+
+    /**
+     * @brief The registered readers.
+     */
+    readers_list readers_;
+
+    /**
+     * @brief The lock protecting the readers list.
+     */
+    spin_lock readers_lock_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for an RCU list forward iterator.
+   * @headerfile rcu.h <micro-os-plus/utils/rcu.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node.
+   * @tparam MP Name of the intrusive node member in object T.
+   *
+   * @details
+   * The **next** links are read with acquire loads, so the nodes
+   * published by the writers are seen fully initialised.
+   */
+  template <class T, class N, N T::*MP>
+  class rcu_list_iterator
+  {
+  public:
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of pointer difference.
+     */
+    using difference_type = ptrdiff_t;
+
+    /**
+     * @brief Category of iterator.
+     */
+    using iterator_category = std::forward_iterator_tag;
+
+    // ------------------------------------------------------------------------
+    constexpr rcu_list_iterator ();
+
+    constexpr explicit rcu_list_iterator (double_list_links_base* node);
+
+    /**
+     * @cond ignore
+     */
+
+    pointer
+    operator->() const;
+
+    reference
+    operator* () const;
+
+    rcu_list_iterator&
+    operator++ ();
+
+    rcu_list_iterator
+    operator++ (int);
+
+    constexpr bool
+    operator== (const rcu_list_iterator& other) const;
+
+    constexpr bool
+    operator!= (const rcu_list_iterator& other) const;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Get the object node from the intrusive node.
+     * @par Parameters
+     *  None.
+     * @return Pointer to object.
+     */
+    pointer
+    get_pointer (void) const;
+
+  protected:
+    /**
+     * @brief Pointer to intrusive node.
+     */
+    double_list_links_base* node_;
+  };
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a read-mostly intrusive list,
+   * with lock-free readers.
+   * @headerfile rcu.h <micro-os-plus/utils/rcu.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node (`double_list_links`).
+   * @tparam MP Name of the intrusive node member in object T.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::rcu_domain domain;
+   * utils::rcu_intrusive_list<driver, utils::double_list_links,
+   *     &driver::registry_links_> drivers{ domain };
+   *
+   * // Writer.
+   * drivers.link_tail (d);
+   * drivers.unlink_synchronize (old);
+   * @endcode
+   *
+   * @details
+   * The readers must iterate inside a read-side critical section
+   * of an `rcu_reader` registered in the same domain; they can
+   * only iterate forwards.
+   *
+   * The writers are serialised by an internal spin lock. An unlinked
+   * element can be reused (or destroyed) only after a grace period;
+   * use `unlink_synchronize()`, or `unlink()` for several
+   * elements followed by a single `domain().synchronize()` and
+   * `reinitialize()` for each of them.
+   */
+  template <class T, class N, N T::*MP>
+  class rcu_intrusive_list
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of iterator over the values.
+     */
+    using iterator = rcu_list_iterator<T, N, MP>;
+
+    /**
+     * @brief Construct an empty list.
+     * @param [in] domain Reference to the RCU domain.
+     */
+    explicit rcu_intrusive_list (rcu_domain& domain);
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    rcu_intrusive_list (const rcu_intrusive_list&) = delete;
+    rcu_intrusive_list (rcu_intrusive_list&&) = delete;
+    rcu_intrusive_list&
+    operator= (const rcu_intrusive_list&)
+        = delete;
+    rcu_intrusive_list&
+    operator= (rcu_intrusive_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~rcu_intrusive_list ();
+
+    /**
+     * @brief Check if the list is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The list has no elements.
+     * @retval false The list has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Publish an element at the tail of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_tail (reference element);
+
+    /**
+     * @brief Publish an element at the head of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_head (reference element);
+
+    /**
+     * @brief Unlink an element; it cannot be reused before
+     * a grace period.
+     * @param [in] element Reference to a linked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink (reference element);
+
+    /**
+     * @brief Unlink an element and wait for a grace period; after
+     * return, the element can be reused.
+     * @param [in] element Reference to a linked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink_synchronize (reference element);
+
+    /**
+     * @brief Prepare an element unlinked before a grace period
+     * for reuse.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    reinitialize (reference element);
+
+    /**
+     * @brief Get the domain.
+     * @par Parameters
+     *  None.
+     * @return Reference to the RCU domain.
+     */
+    constexpr rcu_domain&
+    domain (void) const;
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Iterator begin.
+     * @return An iterator positioned at the first element.
+     */
+    iterator
+    begin () const;
+
+    /**
+     * @brief Iterator end.
+     * @return An iterator positioned after the last element.
+     */
+    iterator
+    end () const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Publish a node between two linked nodes.
+     * @param [in] node Pointer to the new node.
+     * @param [in] previous Pointer to the node before.
+     * @param [in] next Pointer to the node after.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    publish_ (double_list_links_base* node, double_list_links_base* previous,
+              double_list_links_base* next);
+
+    /**
+     * @brief The list head.
+     */
+    double_list_links head_;
+
+    /**
+     * @brief The RCU domain.
+     */
+    rcu_domain& domain_;
+
+    /**
+     * @brief The lock serialising the writers.
+     */
+    spin_lock writers_lock_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "rcu-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_RCU_H_
+
+// ----------------------------------------------------------------------------
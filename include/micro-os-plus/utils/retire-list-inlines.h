@@ -0,0 +1,171 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_RETIRE_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_RETIRE_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, class D>
+  retire_list<T, N, MP, D>::retire_list (rcu_domain& domain,
+                                         std::size_t threshold,
+                                         disposer_type disposer)
+      : domain_{ domain }, threshold_{ threshold }, disposer_{ disposer }
+  {
+    assert (threshold > 0);
+  }
+
+  template <class T, class N, N T::*MP, class D>
+  retire_list<T, N, MP, D>::~retire_list ()
+  {
+    flush ();
+  }
+
+  /**
+   * @details
+   * The element must have been unlinked from the concurrent list;
+   * its links used by the readers are not touched.
+   */
+  template <class T, class N, N T::*MP, class D>
+  void
+  retire_list<T, N, MP, D>::retire (reference element)
+  {
+    batches_[open_].link_tail (element);
+    ++pending_;
+
+    if (pending_ >= threshold_)
+      {
+        reclaim ();
+        if (pending_ >= threshold_)
+          {
+            flush ();
+          }
+      }
+  }
+
+  /**
+   * @details
+   * The sealed batch is disposed if no reader is still in a critical
+   * section entered before it was sealed. Then, if there is no sealed
+   * batch, the open batch is sealed, stamped with a new epoch.
+   */
+  template <class T, class N, N T::*MP, class D>
+  std::size_t
+  retire_list<T, N, MP, D>::reclaim (void)
+  {
+    std::size_t count = 0;
+
+    list_type& sealed = batches_[open_ ^ 1];
+    if (!sealed.empty () && domain_.is_quiescent (sealed_epoch_))
+      {
+        count = dispose_ (sealed);
+      }
+
+    if (sealed.empty () && !batches_[open_].empty ())
+      {
+        open_ ^= 1;
+        sealed_epoch_ = domain_.advance ();
+      }
+
+    return count;
+  }
+
+  /**
+   * @details
+   * At most two grace periods are needed, one for each batch.
+   */
+  template <class T, class N, N T::*MP, class D>
+  std::size_t
+  retire_list<T, N, MP, D>::flush (void)
+  {
+    std::size_t count = 0;
+    while (pending_ > 0)
+      {
+        count += reclaim ();
+        if (pending_ > 0)
+          {
+            domain_.synchronize ();
+            count += reclaim ();
+          }
+      }
+
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, class D>
+  inline std::size_t
+  retire_list<T, N, MP, D>::pending (void) const
+  {
+    return pending_;
+  }
+
+  template <class T, class N, N T::*MP, class D>
+  inline std::size_t
+  retire_list<T, N, MP, D>::threshold (void) const
+  {
+    return threshold_;
+  }
+
+  template <class T, class N, N T::*MP, class D>
+  std::size_t
+  retire_list<T, N, MP, D>::dispose_ (list_type& batch)
+  {
+    std::size_t count = 0;
+    while (!batch.empty ())
+      {
+        disposer_ (*batch.unlink_head ());
+        ++count;
+      }
+    pending_ -= count;
+
+    return count;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_RETIRE_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
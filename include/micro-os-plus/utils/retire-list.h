@@ -0,0 +1,278 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Epoch based reclamation of the nodes removed from concurrent lists.
+ *
+ * A node unlinked from a list traversed by lock-free readers may
+ * still be in use by them; it must not be reused (or freed) before
+ * a grace period.
+ *
+ * Instead of waiting, the writer retires the node to a per-thread
+ * retire list, which is itself an intrusive list, linked via a second
+ * links member of the node. The retired nodes are grouped in batches
+ * stamped with an epoch of the RCU domain; a batch is passed to the
+ * disposer when the domain reports that the epoch is quiescent.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_RETIRE_LIST_H_
+#define MICRO_OS_PLUS_UTILS_RETIRE_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/rcu.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a list of retired nodes, waiting
+   * for a grace period before being disposed.
+   * @headerfile retire-list.h <micro-os-plus/utils/retire-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member used for retiring,
+   *  distinct from the member used by the concurrent list.
+   * @tparam D Type of the disposer, called with a reference to
+   *  each reclaimed element.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * thread_local utils::retire_list<driver, utils::double_list_links,
+   *     &driver::retire_links_, driver_deleter>
+   *     retired{ domain, 64 };
+   *
+   * drivers.unlink (*d);
+   * retired.retire (*d);
+   * @endcode
+   *
+   * @details
+   * The list is not thread safe; each writer thread should have
+   * its own.
+   *
+   * The retired elements are kept in two batches: the open batch,
+   * which receives the new elements, and the sealed batch, stamped
+   * with the epoch started when it was sealed. `reclaim()` disposes
+   * the sealed batch if its epoch is quiescent, then seals the
+   * open batch. Thus the disposer is called for whole batches, and
+   * the domain is scanned once per batch, not once per element.
+   *
+   * The memory is bounded: when the number of pending elements
+   * reaches the threshold, `retire()` reclaims, and if the readers
+   * still hold the sealed batch, waits for a grace period.
+   */
+  template <class T, class N, N T::*MP, class D>
+  class retire_list
+  {
+  public:
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the disposer.
+     */
+    using disposer_type = D;
+
+    /**
+     * @brief Type of the epochs.
+     */
+    using epoch_type = rcu_domain::epoch_type;
+
+    /**
+     * @brief Type of the lists of retired elements.
+     */
+    using list_type = intrusive_list<T, N, MP>;
+
+    /**
+     * @brief Construct an empty retire list.
+     * @param [in] domain Reference to the RCU domain of the readers.
+     * @param [in] threshold The maximum number of pending elements;
+     *  must be positive.
+     * @param [in] disposer The disposer.
+     */
+    retire_list (rcu_domain& domain, std::size_t threshold,
+                 disposer_type disposer = disposer_type{});
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    retire_list (const retire_list&) = delete;
+    retire_list (retire_list&&) = delete;
+    retire_list&
+    operator= (const retire_list&)
+        = delete;
+    retire_list&
+    operator= (retire_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Dispose all pending elements, waiting for the readers,
+     * and destruct the list.
+     */
+    ~retire_list ();
+
+    /**
+     * @brief Retire an element already unlinked from the concurrent list.
+     * @param [in] element Reference to the element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    retire (reference element);
+
+    /**
+     * @brief Dispose the batch that is safe, without waiting.
+     * @par Parameters
+     *  None.
+     * @return The number of disposed elements.
+     */
+    std::size_t
+    reclaim (void);
+
+    /**
+     * @brief Dispose all pending elements, waiting for the grace
+     * periods.
+     * @par Parameters
+     *  None.
+     * @return The number of disposed elements.
+     */
+    std::size_t
+    flush (void);
+
+    /**
+     * @brief Get the number of elements waiting to be disposed.
+     * @par Parameters
+     *  None.
+     * @return The number of pending elements.
+     */
+    std::size_t
+    pending (void) const;
+
+    /**
+     * @brief Get the threshold.
+     * @par Parameters
+     *  None.
+     * @return The maximum number of pending elements.
+     */
+    std::size_t
+    threshold (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Dispose all elements in a batch.
+     * @param [in] batch Reference to the batch.
+     * @return The number of disposed elements.
+     */
+    std::size_t
+    dispose_ (list_type& batch);
+
+    /**
+     * @brief The RCU domain.
+     */
+    rcu_domain& domain_;
+
+    /**
+     * @brief The open and the sealed batches.
+     */
+    list_type batches_[2];
+
+    /**
+     * @brief The epoch when the sealed batch was sealed.
+     */
+    epoch_type sealed_epoch_ = 0;
+
+    /**
+     * @brief The index of the open batch.
+     */
+    std::size_t open_ = 0;
+
+    /**
+     * @brief The number of pending elements, in both batches.
+     */
+    std::size_t pending_ = 0;
+
+    /**
+     * @brief The maximum number of pending elements.
+     */
+    std::size_t threshold_;
+
+    /**
+     * @brief The disposer.
+     */
+    disposer_type disposer_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "retire-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_RETIRE_LIST_H_
+
+// ----------------------------------------------------------------------------
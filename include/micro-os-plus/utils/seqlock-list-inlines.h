@@ -0,0 +1,245 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, class Lock>
+  seqlock_intrusive_list<T, N, MP, Lock>::seqlock_intrusive_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  seqlock_intrusive_list<T, N, MP, Lock>::~seqlock_intrusive_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  inline bool
+  seqlock_intrusive_list<T, N, MP, Lock>::empty (void) const
+  {
+    return head_.next (std::memory_order_acquire) == &head_;
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  void
+  seqlock_intrusive_list<T, N, MP, Lock>::link_tail (reference element)
+  {
+    begin_write_ ();
+    link_ (&(element.*MP), head_.previous (), &head_);
+    end_write_ ();
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  void
+  seqlock_intrusive_list<T, N, MP, Lock>::link_head (reference element)
+  {
+    begin_write_ ();
+    link_ (&(element.*MP), &head_, head_.next ());
+    end_write_ ();
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  void
+  seqlock_intrusive_list<T, N, MP, Lock>::unlink (reference element)
+  {
+    begin_write_ ();
+    unlink_ (&(element.*MP));
+    end_write_ ();
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  typename seqlock_intrusive_list<T, N, MP, Lock>::pointer
+  seqlock_intrusive_list<T, N, MP, Lock>::unlink_head (void)
+  {
+    pointer element = nullptr;
+
+    begin_write_ ();
+    double_list_links_base* node = head_.next ();
+    if (node != &head_)
+      {
+        unlink_ (node);
+        element = get_pointer_ (node);
+      }
+    end_write_ ();
+
+    return element;
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  typename seqlock_intrusive_list<T, N, MP, Lock>::pointer
+  seqlock_intrusive_list<T, N, MP, Lock>::unlink_tail (void)
+  {
+    pointer element = nullptr;
+
+    begin_write_ ();
+    double_list_links_base* node = head_.previous ();
+    if (node != &head_)
+      {
+        unlink_ (node);
+        element = get_pointer_ (node);
+      }
+    end_write_ ();
+
+    return element;
+  }
+
+  /**
+   * @details
+   * The acquire fence orders the copy before the second read of
+   * the sequence; if it changed, or was odd from the start, the
+   * copy is discarded and retried. The traversal is bounded by
+   * the span size, so a torn traversal cannot loop forever.
+   */
+  template <class T, class N, N T::*MP, class Lock>
+  typename seqlock_intrusive_list<T, N, MP, Lock>::size_type
+  seqlock_intrusive_list<T, N, MP, Lock>::snapshot (
+      std::span<pointer> out) const
+  {
+    while (true)
+      {
+        const sequence_type sequence
+            = sequence_.load (std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+          {
+            // Update in progress.
+            continue;
+          }
+
+        size_type count = 0;
+        double_list_links_base* node = head_.next (std::memory_order_relaxed);
+        while (node != &head_ && node != nullptr && count < out.size ())
+          {
+            out[count++] = get_pointer_ (node);
+            node = node->next (std::memory_order_relaxed);
+          }
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (sequence_.load (std::memory_order_relaxed) == sequence)
+          {
+            return count;
+          }
+      }
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  inline typename seqlock_intrusive_list<T, N, MP, Lock>::sequence_type
+  seqlock_intrusive_list<T, N, MP, Lock>::sequence (void) const
+  {
+    return sequence_.load (std::memory_order_acquire);
+  }
+
+  /**
+   * @details
+   * The release fence orders the odd sequence before the
+   * following updates of the links.
+   */
+  template <class T, class N, N T::*MP, class Lock>
+  inline void
+  seqlock_intrusive_list<T, N, MP, Lock>::begin_write_ (void)
+  {
+    writers_lock_.lock ();
+    sequence_.store (sequence_.load (std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  inline void
+  seqlock_intrusive_list<T, N, MP, Lock>::end_write_ (void)
+  {
+    sequence_.store (sequence_.load (std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+    writers_lock_.unlock ();
+  }
+
+  /**
+   * @details
+   * The **next** links are the only ones read by the readers,
+   * so they are stored atomically.
+   */
+  template <class T, class N, N T::*MP, class Lock>
+  inline void
+  seqlock_intrusive_list<T, N, MP, Lock>::link_ (
+      double_list_links_base* node, double_list_links_base* previous,
+      double_list_links_base* next)
+  {
+    node->previous (previous);
+    node->next (next, std::memory_order_relaxed);
+    next->previous (node);
+    previous->next (node, std::memory_order_relaxed);
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  inline void
+  seqlock_intrusive_list<T, N, MP, Lock>::unlink_ (
+      double_list_links_base* node)
+  {
+    double_list_links_base* previous = node->previous ();
+    double_list_links_base* next = node->next ();
+    previous->next (next, std::memory_order_relaxed);
+    next->previous (previous);
+  }
+
+  template <class T, class N, N T::*MP, class Lock>
+  inline typename seqlock_intrusive_list<T, N, MP, Lock>::pointer
+  seqlock_intrusive_list<T, N, MP, Lock>::get_pointer_ (
+      double_list_links_base* node)
+  {
+    // Compute the distance between the member intrusive link
+    // node and the class begin.
+    const auto offset = reinterpret_cast<std::ptrdiff_t> (
+        &(static_cast<T*> (nullptr)->*MP));
+
+    // Compute the address of the object which includes the
+    // intrusive node, by adjusting down the node address.
+    return reinterpret_cast<pointer> (
+        reinterpret_cast<std::ptrdiff_t> (static_cast<N*> (node)) - offset);
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
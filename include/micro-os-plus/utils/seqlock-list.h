@@ -0,0 +1,330 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Seqlock protected intrusive lists, for small lists copied
+ * by readers (like for status reports).
+ *
+ * The writers increment a sequence counter before and after each
+ * update, so the counter is odd while an update is in progress.
+ * The readers never block the writers; they copy the pointers to
+ * the elements optimistically, and retry when the counter shows
+ * that an update overlapped the copy.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_H_
+#define MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a seqlock protected intrusive list,
+   * with optimistic snapshots.
+   * @headerfile seqlock-list.h <micro-os-plus/utils/seqlock-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node (`double_list_links`).
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam Lock Type of the lock serialising the writers (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::seqlock_intrusive_list<thread, utils::double_list_links,
+   *     &thread::status_links_> threads;
+   *
+   * // Writer.
+   * threads.link_tail (*t);
+   *
+   * // Reader.
+   * thread* copy[64];
+   * std::size_t count = threads.snapshot (copy);
+   * @endcode
+   *
+   * @details
+   * The writers are serialised by the lock; the readers use only
+   * atomic loads and may run concurrently with the writers, but
+   * can starve if the updates are very frequent.
+   *
+   * The readers copy only the pointers; the elements must remain
+   * in memory while the list is in use, since a reader that raced
+   * an update may follow the links of an element just unlinked
+   * (before noticing the race and retrying).
+   *
+   * The links of the unlinked elements are not changed.
+   */
+  template <class T, class N, N T::*MP,
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+            class Lock = spin_lock
+#else
+            class Lock
+#endif
+            >
+  class seqlock_intrusive_list
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Type of the sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of the sequence counter.
+     */
+    using sequence_type = std::size_t;
+
+    /**
+     * @brief Construct an empty list.
+     */
+    seqlock_intrusive_list ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    seqlock_intrusive_list (const seqlock_intrusive_list&) = delete;
+    seqlock_intrusive_list (seqlock_intrusive_list&&) = delete;
+    seqlock_intrusive_list&
+    operator= (const seqlock_intrusive_list&)
+        = delete;
+    seqlock_intrusive_list&
+    operator= (seqlock_intrusive_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~seqlock_intrusive_list ();
+
+    /**
+     * @brief Check if the list is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The list has no elements.
+     * @retval false The list has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Add an element to the tail of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_tail (reference element);
+
+    /**
+     * @brief Add an element to the head of the list.
+     * @param [in] element Reference to an unlinked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    link_head (reference element);
+
+    /**
+     * @brief Remove an element from the list.
+     * @param [in] element Reference to a linked element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    unlink (reference element);
+
+    /**
+     * @brief Remove the element at the head of the list.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the element, or `nullptr` if the list
+     *  is empty.
+     */
+    pointer
+    unlink_head (void);
+
+    /**
+     * @brief Remove the element at the tail of the list.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the element, or `nullptr` if the list
+     *  is empty.
+     */
+    pointer
+    unlink_tail (void);
+
+    /**
+     * @brief Copy the pointers to the elements, in order.
+     * @param [out] out The span where the pointers are copied.
+     * @return The number of copied pointers.
+     *
+     * @details
+     * The copy is consistent, taken between two updates. If the
+     * list has more elements than the span, only the first ones
+     * are copied.
+     */
+    size_type
+    snapshot (std::span<pointer> out) const;
+
+    /**
+     * @brief Get the sequence counter.
+     * @par Parameters
+     *  None.
+     * @return The number of started updates, times 2; odd while
+     *  an update is in progress.
+     */
+    sequence_type
+    sequence (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Take the writers lock and make the sequence odd.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    begin_write_ (void);
+
+    /**
+     * @brief Make the sequence even and release the writers lock.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    end_write_ (void);
+
+    /**
+     * @brief Link a node between two linked nodes.
+     * @param [in] node Pointer to the new node.
+     * @param [in] previous Pointer to the node before.
+     * @param [in] next Pointer to the node after.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    link_ (double_list_links_base* node, double_list_links_base* previous,
+           double_list_links_base* next);
+
+    /**
+     * @brief Unlink a node, leaving its links unchanged.
+     * @param [in] node Pointer to the linked node.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    unlink_ (double_list_links_base* node);
+
+    /**
+     * @brief Get the address of the element from the node.
+     * @param [in] node Pointer to the node.
+     * @return Pointer to the element.
+     */
+    static pointer
+    get_pointer_ (double_list_links_base* node);
+
+    /**
+     * @brief The sequence counter.
+     */
+    std::atomic<sequence_type> sequence_{ 0 };
+
+    /**
+     * @brief The list head.
+     */
+    double_list_links head_;
+
+    /**
+     * @brief The lock serialising the writers.
+     */
+    lock_type writers_lock_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "seqlock-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SEQLOCK_LIST_H_
+
+// ----------------------------------------------------------------------------
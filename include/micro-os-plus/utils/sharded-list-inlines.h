@@ -0,0 +1,229 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SHARDED_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_SHARDED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::sharded_intrusive_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::~sharded_intrusive_list ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  void
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::push (size_type shard,
+                                                        reference element)
+  {
+    assert (shard < Shards);
+    shard_type& local = shards_[shard];
+
+    local.lock.lock ();
+    local.list.link_tail (element);
+    local.size.store (local.size.load (std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    local.lock.unlock ();
+  }
+
+  /**
+   * @details
+   * The shards that look empty are skipped without taking their
+   * locks. The first stolen element is returned, and the others
+   * are moved to the local shard.
+   */
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  typename sharded_intrusive_list<T, N, MP, Shards, Lock>::pointer
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::pop (size_type shard)
+  {
+    assert (shard < Shards);
+    shard_type& local = shards_[shard];
+
+    local.lock.lock ();
+    if (!local.list.empty ())
+      {
+        pointer element = local.list.unlink_head ();
+        local.size.store (local.size.load (std::memory_order_relaxed) - 1,
+                          std::memory_order_relaxed);
+        local.lock.unlock ();
+        return element;
+      }
+    local.lock.unlock ();
+
+    for (size_type i = 1; i < Shards; ++i)
+      {
+        shard_type& victim = shards_[(shard + i) % Shards];
+        if (victim.size.load (std::memory_order_relaxed) == 0)
+          {
+            continue;
+          }
+
+        list_type stolen;
+        victim.lock.lock ();
+        const size_type count = detach_half_ (victim, stolen);
+        victim.lock.unlock ();
+
+        if (count == 0)
+          {
+            continue;
+          }
+
+        pointer element = stolen.unlink_head ();
+        if (count > 1)
+          {
+            local.lock.lock ();
+            local.list.splice (local.list.end (), stolen, stolen.begin (),
+                               stolen.end ());
+            local.size.store (local.size.load (std::memory_order_relaxed)
+                                  + count - 1,
+                              std::memory_order_relaxed);
+            local.lock.unlock ();
+          }
+        return element;
+      }
+
+    return nullptr;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  typename sharded_intrusive_list<T, N, MP, Shards, Lock>::size_type
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::steal (size_type shard,
+                                                         size_type victim)
+  {
+    assert (shard < Shards);
+    assert (victim < Shards);
+
+    if (shard == victim)
+      {
+        return 0;
+      }
+
+    list_type stolen;
+    shards_[victim].lock.lock ();
+    const size_type count = detach_half_ (shards_[victim], stolen);
+    shards_[victim].lock.unlock ();
+
+    if (count > 0)
+      {
+        shard_type& local = shards_[shard];
+        local.lock.lock ();
+        local.list.splice (local.list.end (), stolen, stolen.begin (),
+                           stolen.end ());
+        local.size.store (local.size.load (std::memory_order_relaxed) + count,
+                          std::memory_order_relaxed);
+        local.lock.unlock ();
+      }
+
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  typename sharded_intrusive_list<T, N, MP, Shards, Lock>::size_type
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::size (void) const
+  {
+    size_type result = 0;
+    for (const auto& shard : shards_)
+      {
+        result += shard.size.load (std::memory_order_relaxed);
+      }
+
+    return result;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  inline typename sharded_intrusive_list<T, N, MP, Shards, Lock>::size_type
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::size (size_type shard) const
+  {
+    assert (shard < Shards);
+    return shards_[shard].size.load (std::memory_order_relaxed);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  constexpr typename sharded_intrusive_list<T, N, MP, Shards, Lock>::size_type
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::shards (void)
+  {
+    return Shards;
+  }
+
+  /**
+   * @details
+   * Must be called with the victim lock taken. The split point is
+   * found by walking back from the tail over half of the elements,
+   * but not more than `max_steal`, so the time the victim lock is
+   * held does not grow with the shard; the elements are then
+   * detached with a single splice.
+   */
+  template <class T, class N, N T::*MP, std::size_t Shards, class Lock>
+  typename sharded_intrusive_list<T, N, MP, Shards, Lock>::size_type
+  sharded_intrusive_list<T, N, MP, Shards, Lock>::detach_half_ (
+      shard_type& victim, list_type& out)
+  {
+    const size_type size = victim.size.load (std::memory_order_relaxed);
+    if (size == 0)
+      {
+        return 0;
+      }
+
+    const size_type half = (size + 1) / 2;
+    const size_type count = (half < max_steal) ? half : max_steal;
+    auto first = victim.list.end ();
+    for (size_type i = 0; i < count; ++i)
+      {
+        --first;
+      }
+
+    out.splice (out.end (), victim.list, first, victim.list.end ());
+    victim.size.store (size - count, std::memory_order_relaxed);
+
+    return count;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SHARDED_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,292 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Sharded intrusive lists, with work stealing.
+ *
+ * A single list shared by many worker threads (like a ready list)
+ * becomes a contention point, since all of them take the same lock.
+ * The sharded list keeps one list per worker (or per core), each with
+ * its own lock, on its own cache line; the workers push to and pop
+ * from their local shard, and only when it is empty they steal
+ * half of the elements of another shard (up to a limit).
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SHARDED_LIST_H_
+#define MICRO_OS_PLUS_UTILS_SHARDED_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#include <atomic>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+// The maximum number of elements stolen at once; the victim lock is
+// held while walking back over them, so it bounds the lock time.
+#if !defined(MICRO_OS_PLUS_UTILS_LISTS_MAX_STEAL)
+#define MICRO_OS_PLUS_UTILS_LISTS_MAX_STEAL (16)
+#endif // !defined(MICRO_OS_PLUS_UTILS_LISTS_MAX_STEAL)
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for an intrusive list split in shards,
+   * with work stealing.
+   * @headerfile sharded-list.h <micro-os-plus/utils/sharded-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam Shards The number of shards.
+   * @tparam Lock Type of the lock protecting each shard (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::sharded_intrusive_list<task, utils::double_list_links,
+   *     &task::ready_links_, 8> ready;
+   *
+   * // In the worker running on core `id`.
+   * ready.push (id, *t);
+   * task* next = ready.pop (id);
+   * @endcode
+   *
+   * @details
+   * The callers identify their local shard by an index (like the
+   * core or the worker number); several callers may share a shard.
+   *
+   * `pop()` takes the oldest element of the local shard; if the shard
+   * is empty, it steals the newest half of the first non-empty shard,
+   * in a round robin order starting after the local one, but not
+   * more than `max_steal` elements, so that the victim lock is held
+   * for a bounded time. The stolen
+   * elements are detached under the victim lock and moved to the local
+   * shard under the local lock, so no two locks are held at once.
+   *
+   * The elements are not ordered across shards.
+   */
+  template <class T, class N, N T::*MP, std::size_t Shards,
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+            class Lock = spin_lock
+#else
+            class Lock
+#endif
+            >
+  class sharded_intrusive_list
+  {
+  public:
+    static_assert (Shards > 0, "There must be at least one shard!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the lists in each shard.
+     */
+    using list_type = intrusive_list<T, N, MP>;
+
+    /**
+     * @brief Type of the locks.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Type of the shard indices and sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief The maximum number of elements stolen at once.
+     */
+    static constexpr size_type max_steal
+        = MICRO_OS_PLUS_UTILS_LISTS_MAX_STEAL;
+
+    static_assert (max_steal > 0, "At least one element must be stolen!");
+
+    /**
+     * @brief Construct an empty list.
+     */
+    sharded_intrusive_list ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    sharded_intrusive_list (const sharded_intrusive_list&) = delete;
+    sharded_intrusive_list (sharded_intrusive_list&&) = delete;
+    sharded_intrusive_list&
+    operator= (const sharded_intrusive_list&)
+        = delete;
+    sharded_intrusive_list&
+    operator= (sharded_intrusive_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the list.
+     */
+    ~sharded_intrusive_list ();
+
+    /**
+     * @brief Add an element to the tail of a shard.
+     * @param [in] shard The index of the local shard.
+     * @param [in] element Reference to the element.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    push (size_type shard, reference element);
+
+    /**
+     * @brief Remove an element from a shard, stealing from the other
+     * shards if it is empty.
+     * @param [in] shard The index of the local shard.
+     * @return Pointer to the element, or `nullptr` if all shards
+     *  were found empty.
+     */
+    pointer
+    pop (size_type shard);
+
+    /**
+     * @brief Move half of the elements of a shard (at most `max_steal`)
+     * to another shard.
+     * @param [in] shard The index of the destination shard.
+     * @param [in] victim The index of the source shard.
+     * @return The number of moved elements.
+     */
+    size_type
+    steal (size_type shard, size_type victim);
+
+    /**
+     * @brief Get the approximate number of elements.
+     * @par Parameters
+     *  None.
+     * @return The sum of the shard sizes, read without locking.
+     */
+    size_type
+    size (void) const;
+
+    /**
+     * @brief Get the number of elements in a shard.
+     * @param [in] shard The index of the shard.
+     * @return The number of elements, read without locking.
+     */
+    size_type
+    size (size_type shard) const;
+
+    /**
+     * @brief Get the number of shards.
+     * @par Parameters
+     *  None.
+     * @return The number of shards.
+     */
+    static constexpr size_type
+    shards (void);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Type of the shards, each on its own cache line.
+     */
+    struct alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE) shard_type
+    {
+      /**
+       * @brief The lock protecting the shard.
+       */
+      lock_type lock;
+
+      /**
+       * @brief The list of elements.
+       */
+      list_type list;
+
+      /**
+       * @brief The number of elements, written under the lock.
+       */
+      std::atomic<size_type> size{ 0 };
+    };
+
+    /**
+     * @brief Detach the newest half of a shard (at most `max_steal`
+     * elements) into a list.
+     * @param [in] victim Reference to the source shard.
+     * @param [in] out Reference to the destination list.
+     * @return The number of detached elements.
+     */
+    static size_type
+    detach_half_ (shard_type& victim, list_type& out);
+
+    /**
+     * @brief The shards.
+     */
+    shard_type shards_[Shards];
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "sharded-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SHARDED_LIST_H_
+
+// ----------------------------------------------------------------------------
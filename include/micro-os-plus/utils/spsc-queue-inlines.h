@@ -0,0 +1,171 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SPSC_QUEUE_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_SPSC_QUEUE_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  constexpr spsc_queue<T, N, MP, Capacity>::spsc_queue ()
+  {
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  constexpr spsc_queue<T, N, MP, Capacity>::~spsc_queue ()
+  {
+  }
+
+  /**
+   * @details
+   * The consumer index is read only when the cached copy shows
+   * the queue full.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  bool
+  spsc_queue<T, N, MP, Capacity>::push (reference element)
+  {
+    const size_type tail = tail_.load (std::memory_order_relaxed);
+    if (tail - head_cache_ == Capacity)
+      {
+        head_cache_ = head_.load (std::memory_order_acquire);
+        if (tail - head_cache_ == Capacity)
+          {
+            return false;
+          }
+      }
+
+    slots_[tail & mask] = &element;
+    tail_.store (tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @details
+   * The producer index is read only when the cached copy shows
+   * the queue empty.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  typename spsc_queue<T, N, MP, Capacity>::pointer
+  spsc_queue<T, N, MP, Capacity>::pop (void)
+  {
+    const size_type head = head_.load (std::memory_order_relaxed);
+    if (head == tail_cache_)
+      {
+        tail_cache_ = tail_.load (std::memory_order_acquire);
+        if (head == tail_cache_)
+          {
+            return nullptr;
+          }
+      }
+
+    pointer element = slots_[head & mask];
+    head_.store (head + 1, std::memory_order_release);
+
+    return element;
+  }
+
+  /**
+   * @details
+   * The occupied slots are at most two contiguous ranges in the ring,
+   * each linked with `link_tail_range()`.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  template <class L>
+  typename spsc_queue<T, N, MP, Capacity>::size_type
+  spsc_queue<T, N, MP, Capacity>::drain_into (L& list)
+  {
+    const size_type head = head_.load (std::memory_order_relaxed);
+    tail_cache_ = tail_.load (std::memory_order_acquire);
+
+    const size_type count = tail_cache_ - head;
+    if (count == 0)
+      {
+        return 0;
+      }
+
+    const size_type first = head & mask;
+    const size_type last = first + count;
+    if (last <= Capacity)
+      {
+        list.link_tail_range (&slots_[first], &slots_[last]);
+      }
+    else
+      {
+        list.link_tail_range (&slots_[first], &slots_[Capacity]);
+        list.link_tail_range (&slots_[0], &slots_[last - Capacity]);
+      }
+
+    head_.store (tail_cache_, std::memory_order_release);
+
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  inline bool
+  spsc_queue<T, N, MP, Capacity>::empty (void) const
+  {
+    return head_.load (std::memory_order_relaxed)
+           == tail_.load (std::memory_order_acquire);
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  inline typename spsc_queue<T, N, MP, Capacity>::size_type
+  spsc_queue<T, N, MP, Capacity>::size (void) const
+  {
+    const size_type head = head_.load (std::memory_order_acquire);
+    return tail_.load (std::memory_order_acquire) - head;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  constexpr typename spsc_queue<T, N, MP, Capacity>::size_type
+  spsc_queue<T, N, MP, Capacity>::capacity (void)
+  {
+    return Capacity;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SPSC_QUEUE_INLINES_H_
+
+// ----------------------------------------------------------------------------
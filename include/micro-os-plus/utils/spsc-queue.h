@@ -0,0 +1,268 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Wait-free single-producer/single-consumer queues, for handing
+ * elements from an interrupt handler to a thread (or between two
+ * threads) without critical sections.
+ *
+ * The queue is a ring of pointers to the elements, with free running
+ * producer and consumer indices; each index is written by one side
+ * only, with release stores, and read by the other side with acquire
+ * loads. No read-modify-write operations are used, so the queue works
+ * on all cores, including those without atomic compare-and-swap.
+ *
+ * The two indices are kept on separate cache lines, each with a
+ * private copy of the other index, so that the two sides do not
+ * share cache lines as long as the queue is neither full nor empty.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_SPSC_QUEUE_H_
+#define MICRO_OS_PLUS_UTILS_SPSC_QUEUE_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <atomic>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a wait-free single-producer/single-consumer
+   * queue of intrusive elements.
+   * @headerfile spsc-queue.h <micro-os-plus/utils/spsc-queue.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam Capacity The maximum number of elements; must be a power of 2.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::spsc_queue<buffer, utils::double_list_links,
+   *     &buffer::links_, 16> received;
+   *
+   * // In the interrupt handler.
+   * received.push (*b);
+   *
+   * // In the thread.
+   * received.drain_into (pending);
+   * @endcode
+   *
+   * @details
+   * `push()` must be called only by the producer, and `pop()` and
+   * `drain_into()` only by the consumer; all of them complete in
+   * a bounded number of steps.
+   *
+   * The queue stores only pointers to the elements; their links
+   * are not used while in the queue, and are used by `drain_into()`
+   * to link the elements to the consumer list.
+   */
+  template <class T, class N, N T::*MP, std::size_t Capacity>
+  class spsc_queue
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+    static_assert (Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                   "Capacity must be a power of 2!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the indices and sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Construct an empty queue.
+     */
+    constexpr spsc_queue ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    spsc_queue (const spsc_queue&) = delete;
+    spsc_queue (spsc_queue&&) = delete;
+    spsc_queue&
+    operator= (const spsc_queue&)
+        = delete;
+    spsc_queue&
+    operator= (spsc_queue&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the queue.
+     */
+    constexpr ~spsc_queue ();
+
+    /**
+     * @brief Add an element at the tail of the queue (producer only).
+     * @param [in] element Reference to the element.
+     * @retval true The element was added.
+     * @retval false The queue is full.
+     */
+    bool
+    push (reference element);
+
+    /**
+     * @brief Remove the element at the head of the queue
+     * (consumer only).
+     * @par Parameters
+     *  None.
+     * @return Pointer to the element, or `nullptr` if the queue
+     *  is empty.
+     */
+    pointer
+    pop (void);
+
+    /**
+     * @brief Move all elements to the tail of a list (consumer only).
+     * @tparam L Type of the intrusive list, using the same T, N, MP.
+     * @param [in] list Reference to the list.
+     * @return The number of moved elements.
+     *
+     * @details
+     * The elements are linked among themselves and to the list with
+     * a single update of the list head, and removed from the queue
+     * with a single store.
+     */
+    template <class L>
+    size_type
+    drain_into (L& list);
+
+    /**
+     * @brief Check if the queue is empty (consumer side).
+     * @par Parameters
+     *  None.
+     * @retval true The queue has no elements.
+     * @retval false The queue has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Get the number of elements in the queue.
+     * @par Parameters
+     *  None.
+     * @return The number of elements, exact only when called from one
+     *  of the two sides.
+     */
+    size_type
+    size (void) const;
+
+    /**
+     * @brief Get the maximum number of elements.
+     * @par Parameters
+     *  None.
+     * @return The capacity.
+     */
+    static constexpr size_type
+    capacity (void);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Mask to get the slot from an index.
+     */
+    static constexpr size_type mask = Capacity - 1;
+
+    /**
+     * @brief The producer index, written by the producer.
+     */
+    alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+        std::atomic<size_type> tail_{ 0 };
+
+    /**
+     * @brief The consumer index, as last seen by the producer.
+     */
+    size_type head_cache_ = 0;
+
+    /**
+     * @brief The consumer index, written by the consumer.
+     */
+    alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+        std::atomic<size_type> head_{ 0 };
+
+    /**
+     * @brief The producer index, as last seen by the consumer.
+     */
+    size_type tail_cache_ = 0;
+
+    /**
+     * @brief The ring of pointers to the elements.
+     */
+    alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE) pointer
+        slots_[Capacity];
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "spsc-queue-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_SPSC_QUEUE_H_
+
+// ----------------------------------------------------------------------------
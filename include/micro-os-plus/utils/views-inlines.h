@@ -0,0 +1,147 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_VIEWS_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_VIEWS_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils::views
+{
+  // ==========================================================================
+
+  /**
+   * @details
+   * The end of the first chunk is computed here, so that
+   * dereferencing the iterator does not walk the range again.
+   */
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr chunk_view<V>::iterator::iterator (base_iterator current,
+                                               base_sentinel end,
+                                               difference_type size)
+      : current_{ current }, next_{ std::ranges::next (current, size, end) },
+        end_{ end }, size_{ size }
+  {
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr typename chunk_view<V>::iterator::value_type
+  chunk_view<V>::iterator::operator* () const
+  {
+    return value_type{ current_, next_ };
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr typename chunk_view<V>::iterator&
+  chunk_view<V>::iterator::operator++ ()
+  {
+    current_ = next_;
+    next_ = std::ranges::next (next_, size_, end_);
+    return *this;
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr typename chunk_view<V>::iterator
+  chunk_view<V>::iterator::operator++ (int)
+  {
+    const auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr bool
+  chunk_view<V>::iterator::operator== (const iterator& other) const
+  {
+    return current_ == other.current_;
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr bool
+  chunk_view<V>::iterator::operator== (std::default_sentinel_t) const
+  {
+    return current_ == end_;
+  }
+
+  // ==========================================================================
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr chunk_view<V>::chunk_view (V base, difference_type size)
+      : base_{ std::move (base) }, size_{ size }
+  {
+    assert (size > 0);
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr V
+  chunk_view<V>::base () const
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr typename chunk_view<V>::iterator
+  chunk_view<V>::begin ()
+  {
+    return iterator{ std::ranges::begin (base_), std::ranges::end (base_),
+                     size_ };
+  }
+
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  constexpr std::default_sentinel_t
+  chunk_view<V>::end () const
+  {
+    return std::default_sentinel;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils::views
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_VIEWS_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,337 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Lazy views over lists.
+ *
+ * Since the list iterators are standard bidirectional iterators,
+ * the C++20 range adaptors work directly on the lists, without
+ * copying the elements into temporary containers; the views only
+ * keep list iterators, and yield references to the original objects.
+ *
+ * This file groups the adaptors commonly used with lists in a single
+ * namespace, and adds `chunk`, which is only available in the
+ * standard library starting with C++23.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_VIEWS_H_
+#define MICRO_OS_PLUS_UTILS_VIEWS_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils::views
+{
+  // ==========================================================================
+
+  /**
+   * @cond ignore
+   */
+
+  using std::views::filter;
+  using std::views::take_while;
+  using std::views::transform;
+
+  /**
+   * @endcond
+   */
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a view that splits a range into
+   * consecutive sub-ranges of a given size.
+   * @headerfile views.h <micro-os-plus/utils/views.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam V Type of the underlying view.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * for (auto batch : threads | utils::views::chunk (8))
+   *   {
+   *     for (auto& t : batch)
+   *       {
+   *         // ...
+   *       }
+   *   }
+   * @endcode
+   *
+   * @details
+   * Each element of the view is a `std::ranges::subrange` of the
+   * underlying view; all chunks have `size` elements, except
+   * the last one, which may be shorter.
+   *
+   * The underlying range is traversed once; the view does not
+   * allocate memory.
+   */
+  template <std::ranges::forward_range V>
+    requires std::ranges::view<V>
+  class chunk_view : public std::ranges::view_interface<chunk_view<V>>
+  {
+  public:
+    /**
+     * @brief Type of iterator of the underlying view.
+     */
+    using base_iterator = std::ranges::iterator_t<V>;
+
+    /**
+     * @brief Type of sentinel of the underlying view.
+     */
+    using base_sentinel = std::ranges::sentinel_t<V>;
+
+    /**
+     * @brief Type of the chunks.
+     */
+    using chunk_type = std::ranges::subrange<base_iterator>;
+
+    /**
+     * @brief Type of distances and sizes.
+     */
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    /**
+     * @brief A class for the chunk view iterator.
+     */
+    class iterator
+    {
+    public:
+      /**
+       * @brief Type of value "pointed to" by the iterator.
+       */
+      using value_type = chunk_type;
+
+      /**
+       * @brief Type of distances between iterators.
+       */
+      using difference_type = chunk_view::difference_type;
+
+      /**
+       * @brief Category of iterator.
+       */
+      using iterator_category = std::forward_iterator_tag;
+
+      /**
+       * @brief Concept of iterator.
+       */
+      using iterator_concept = std::forward_iterator_tag;
+
+      constexpr iterator () = default;
+
+      constexpr iterator (base_iterator current, base_sentinel end,
+                          difference_type size);
+
+      constexpr value_type
+      operator* () const;
+
+      constexpr iterator&
+      operator++ ();
+
+      constexpr iterator
+      operator++ (int);
+
+      constexpr bool
+      operator== (const iterator& other) const;
+
+      constexpr bool
+      operator== (std::default_sentinel_t) const;
+
+    protected:
+      /**
+       * @brief Iterator to the first element in the current chunk.
+       */
+      base_iterator current_{};
+
+      /**
+       * @brief Iterator to the first element after the current chunk.
+       */
+      base_iterator next_{};
+
+      /**
+       * @brief End of the underlying view.
+       */
+      base_sentinel end_{};
+
+      /**
+       * @brief The chunk size.
+       */
+      difference_type size_ = 0;
+    };
+
+    /**
+     * @brief Construct an empty view.
+     */
+    constexpr chunk_view ()
+      requires std::default_initializable<V>
+    = default;
+
+    /**
+     * @brief Construct a view over a range.
+     * @param [in] base The underlying view.
+     * @param [in] size The number of elements in each chunk; must
+     *  be positive.
+     */
+    constexpr chunk_view (V base, difference_type size);
+
+    /**
+     * @brief Get the underlying view.
+     * @par Parameters
+     *  None.
+     * @return A copy of the underlying view.
+     */
+    constexpr V
+    base () const
+      requires std::copy_constructible<V>;
+
+    /**
+     * @brief Iterator begin.
+     * @return An iterator positioned at the first chunk.
+     */
+    constexpr iterator
+    begin ();
+
+    /**
+     * @brief Sentinel end.
+     * @return A sentinel that compares equal to the iterator
+     *  positioned after the last chunk.
+     */
+    constexpr std::default_sentinel_t
+    end () const;
+
+  protected:
+    /**
+     * @brief The underlying view.
+     */
+    V base_{};
+
+    /**
+     * @brief The chunk size.
+     */
+    difference_type size_ = 0;
+  };
+
+  /**
+   * @cond ignore
+   */
+
+  template <class R>
+  chunk_view (R&&, std::ranges::range_difference_t<R>)
+      -> chunk_view<std::views::all_t<R>>;
+
+  /**
+   * @endcond
+   */
+
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief The range adaptor closure returned by `chunk (size)`.
+   */
+  struct chunk_closure
+  {
+    /**
+     * @brief The chunk size.
+     */
+    std::ptrdiff_t size;
+
+    /**
+     * @brief Apply the adaptor to a range.
+     * @param [in] range The range to split.
+     * @param [in] closure The adaptor.
+     * @return A chunk view over the range.
+     */
+    template <std::ranges::viewable_range R>
+      requires std::ranges::forward_range<R>
+    friend constexpr auto
+    operator| (R&& range, const chunk_closure& closure)
+    {
+      return chunk_view{ std::forward<R> (range),
+                         static_cast<std::ranges::range_difference_t<R>> (
+                             closure.size) };
+    }
+  };
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief The `chunk` range adaptor.
+   *
+   * @details
+   * `chunk (range, size)` and `range | chunk (size)` both return
+   * a `chunk_view`.
+   */
+  struct chunk_fn
+  {
+    template <std::ranges::viewable_range R>
+      requires std::ranges::forward_range<R>
+    constexpr auto
+    operator() (R&& range, std::ranges::range_difference_t<R> size) const
+    {
+      return chunk_view{ std::forward<R> (range), size };
+    }
+
+    constexpr chunk_closure
+    operator() (std::ptrdiff_t size) const
+    {
+      return chunk_closure{ size };
+    }
+  };
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief Split a range into consecutive chunks.
+   */
+  inline constexpr chunk_fn chunk{};
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils::views
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "views-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_VIEWS_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,308 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_WAIT_LIST_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_WAIT_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class Lock>
+  wait_list<Lock>::wait_list ()
+  {
+  }
+
+  template <class Lock>
+  wait_list<Lock>::~wait_list ()
+  {
+    assert (waiters_.empty ());
+  }
+
+  template <class Lock>
+  template <class L>
+  void
+  wait_list<Lock>::wait (L& lock)
+  {
+    waiter node;
+    enqueue_ (node, lock);
+    block_ (node, nullptr);
+    lock.lock ();
+  }
+
+  template <class Lock>
+  template <class L, class P>
+  void
+  wait_list<Lock>::wait (L& lock, P predicate)
+  {
+    while (!predicate ())
+      {
+        wait (lock);
+      }
+  }
+
+  template <class Lock>
+  template <class L, class Rep, class Period>
+  bool
+  wait_list<Lock>::wait_for (L& lock,
+                             const std::chrono::duration<Rep, Period>& timeout)
+  {
+    return wait_until (
+        lock, std::chrono::steady_clock::now ()
+                  + std::chrono::ceil<std::chrono::steady_clock::duration> (
+                      timeout));
+  }
+
+  template <class Lock>
+  template <class L, class Rep, class Period, class P>
+  bool
+  wait_list<Lock>::wait_for (L& lock,
+                             const std::chrono::duration<Rep, Period>& timeout,
+                             P predicate)
+  {
+    const auto deadline
+        = std::chrono::steady_clock::now ()
+          + std::chrono::ceil<std::chrono::steady_clock::duration> (timeout);
+    while (!predicate ())
+      {
+        if (!wait_until (lock, deadline))
+          {
+            return predicate ();
+          }
+      }
+
+    return true;
+  }
+
+  template <class Lock>
+  template <class L>
+  bool
+  wait_list<Lock>::wait_until (
+      L& lock, const std::chrono::steady_clock::time_point& deadline)
+  {
+    waiter node;
+    enqueue_ (node, lock);
+    const bool result = block_ (node, &deadline);
+    lock.lock ();
+
+    return result;
+  }
+
+  /**
+   * @details
+   * The waiter is marked as claimed while still under the lock,
+   * so a waiter whose timeout expires meanwhile knows that it was
+   * unlinked, and waits for the wakeup instead of returning
+   * (its node is still used by the notifier).
+   */
+  template <class Lock>
+  void
+  wait_list<Lock>::notify_one (void)
+  {
+    waiter* node = nullptr;
+
+    lock_.lock ();
+    if (!waiters_.empty ())
+      {
+        node = waiters_.unlink_head ();
+        node->state_.store (waiter::claimed, std::memory_order_relaxed);
+      }
+    lock_.unlock ();
+
+    if (node != nullptr)
+      {
+        wake_ (node);
+      }
+  }
+
+  /**
+   * @details
+   * All waiters are moved to a local list under the lock, and
+   * awakened in FIFO order after releasing it.
+   */
+  template <class Lock>
+  void
+  wait_list<Lock>::notify_all (void)
+  {
+    waiter_list ready;
+
+    lock_.lock ();
+    ready.splice (ready.end (), waiters_, waiters_.begin (), waiters_.end ());
+    for (auto& node : ready)
+      {
+        node.state_.store (waiter::claimed, std::memory_order_relaxed);
+      }
+    lock_.unlock ();
+
+    while (!ready.empty ())
+      {
+        wake_ (ready.unlink_head ());
+      }
+  }
+
+  template <class Lock>
+  bool
+  wait_list<Lock>::empty (void)
+  {
+    lock_.lock ();
+    const bool result = waiters_.empty ();
+    lock_.unlock ();
+
+    return result;
+  }
+
+  template <class Lock>
+  template <class L>
+  void
+  wait_list<Lock>::enqueue_ (waiter& node, L& lock)
+  {
+    lock_.lock ();
+    waiters_.link_tail (node);
+    lock_.unlock ();
+
+    lock.unlock ();
+  }
+
+  /**
+   * @details
+   * The futex calls return early on signals and on state changes,
+   * so the state is checked again after each of them.
+   *
+   * When the deadline expires, the node is unlinked only if no
+   * notifier claimed it meanwhile; a claimed node must wait for the
+   * notifier to release it, and the wait counts as notified.
+   */
+  template <class Lock>
+  bool
+  wait_list<Lock>::block_ (
+      waiter& node, const std::chrono::steady_clock::time_point* deadline)
+  {
+    while (true)
+      {
+        const std::uint32_t state
+            = node.state_.load (std::memory_order_acquire);
+        if (state == waiter::notified)
+          {
+            return true;
+          }
+
+        if (state == waiter::claimed || deadline == nullptr)
+          {
+            futex_wait_ (&node.state_, state, nullptr);
+            continue;
+          }
+
+        const auto now = std::chrono::steady_clock::now ();
+        if (now >= *deadline)
+          {
+            lock_.lock ();
+            const bool linked = (node.state_.load (std::memory_order_relaxed)
+                                 == waiter::waiting);
+            if (linked)
+              {
+                node.links_.unlink ();
+              }
+            lock_.unlock ();
+
+            if (linked)
+              {
+                return false;
+              }
+            continue;
+          }
+
+        const auto remaining
+            = std::chrono::duration_cast<std::chrono::nanoseconds> (*deadline
+                                                                    - now);
+        const auto seconds
+            = std::chrono::duration_cast<std::chrono::seconds> (remaining);
+
+        struct timespec timeout = {};
+        timeout.tv_sec = seconds.count ();
+        timeout.tv_nsec = (remaining - seconds).count ();
+        futex_wait_ (&node.state_, state, &timeout);
+      }
+  }
+
+  /**
+   * @details
+   * Once the state is `notified`, the waiter may return and its
+   * stack may be reused, so the node is not accessed afterwards;
+   * the futex wake uses only the address, and at worst causes a
+   * spurious wakeup of an unrelated futex, which all futex users
+   * must tolerate.
+   */
+  template <class Lock>
+  void
+  wait_list<Lock>::wake_ (waiter* node)
+  {
+    std::atomic<std::uint32_t>* word = &node->state_;
+    word->store (waiter::notified, std::memory_order_release);
+    futex_wake_ (word);
+  }
+
+  template <class Lock>
+  inline void
+  wait_list<Lock>::futex_wait_ (std::atomic<std::uint32_t>* word,
+                                std::uint32_t expected,
+                                const struct timespec* timeout)
+  {
+    // The result is not relevant, the caller checks the state again.
+    static_cast<void> (syscall (SYS_futex, word, FUTEX_WAIT_PRIVATE, expected,
+                                timeout, nullptr, 0));
+  }
+
+  template <class Lock>
+  inline void
+  wait_list<Lock>::futex_wake_ (std::atomic<std::uint32_t>* word)
+  {
+    static_cast<void> (
+        syscall (SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0));
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(__linux__)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_WAIT_LIST_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,373 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Futex based wait lists, for blocking threads on Linux.
+ *
+ * Each waiting thread links a node allocated on its own stack to an
+ * intrusive list, and sleeps on a futex word inside the node; the
+ * notifiers unlink the oldest waiter (or all of them) under a short
+ * lock, and wake them after releasing it. No memory is allocated,
+ * and the waiters are awakened in FIFO order.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_WAIT_LIST_H_
+#define MICRO_OS_PLUS_UTILS_WAIT_LIST_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/locks.h>
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a list of threads blocked on a
+   * condition, with futex wakeups.
+   * @headerfile wait-list.h <micro-os-plus/utils/wait-list.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam Lock Type of the lock protecting the list (BasicLockable).
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * std::mutex mx;
+   * utils::wait_list<> not_empty;
+   *
+   * // Consumer.
+   * std::unique_lock lock{ mx };
+   * not_empty.wait (lock, [&] { return !queue.empty (); });
+   *
+   * // Producer.
+   * {
+   *   std::lock_guard guard{ mx };
+   *   queue.push (item);
+   * }
+   * not_empty.notify_one ();
+   * @endcode
+   *
+   * @details
+   * A replacement for `std::condition_variable_any`, with the
+   * waiters awakened strictly in FIFO order, and no spurious
+   * wakeups (a wait returns only after a notification or a
+   * timeout).
+   *
+   * The waiter is linked before the user lock is released, so a
+   * notification issued after that cannot be lost.
+   *
+   * The internal lock is held only to link and unlink the nodes;
+   * the futex system calls are issued outside it.
+   */
+  template <
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+      class Lock = spin_lock
+#else
+      class Lock
+#endif
+      >
+  class wait_list
+  {
+  public:
+    /**
+     * @brief Type of the lock.
+     */
+    using lock_type = Lock;
+
+    /**
+     * @brief Construct an empty wait list.
+     */
+    wait_list ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    wait_list (const wait_list&) = delete;
+    wait_list (wait_list&&) = delete;
+    wait_list&
+    operator= (const wait_list&)
+        = delete;
+    wait_list&
+    operator= (wait_list&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the wait list.
+     */
+    ~wait_list ();
+
+    /**
+     * @brief Block until notified.
+     * @tparam L Type of the user lock (BasicLockable).
+     * @param [in] lock The user lock, locked by the caller.
+     * @par Returns
+     *  Nothing.
+     *
+     * @details
+     * The user lock is released while waiting, and locked
+     * again before returning.
+     */
+    template <class L>
+    void
+    wait (L& lock);
+
+    /**
+     * @brief Block until the predicate is true.
+     * @tparam L Type of the user lock (BasicLockable).
+     * @tparam P Type of the predicate.
+     * @param [in] lock The user lock, locked by the caller.
+     * @param [in] predicate Function returning `true` when the
+     *  condition is met, called with the user lock held.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class L, class P>
+    void
+    wait (L& lock, P predicate);
+
+    /**
+     * @brief Block until notified, or until the timeout expires.
+     * @tparam L Type of the user lock (BasicLockable).
+     * @param [in] lock The user lock, locked by the caller.
+     * @param [in] timeout The maximum time to wait.
+     * @retval true Notified.
+     * @retval false The timeout expired.
+     */
+    template <class L, class Rep, class Period>
+    bool
+    wait_for (L& lock, const std::chrono::duration<Rep, Period>& timeout);
+
+    /**
+     * @brief Block until the predicate is true, or until the
+     * timeout expires.
+     * @tparam L Type of the user lock (BasicLockable).
+     * @tparam P Type of the predicate.
+     * @param [in] lock The user lock, locked by the caller.
+     * @param [in] timeout The maximum time to wait.
+     * @param [in] predicate Function returning `true` when the
+     *  condition is met, called with the user lock held.
+     * @return The last value returned by the predicate.
+     */
+    template <class L, class Rep, class Period, class P>
+    bool
+    wait_for (L& lock, const std::chrono::duration<Rep, Period>& timeout,
+              P predicate);
+
+    /**
+     * @brief Block until notified, or until the deadline expires.
+     * @tparam L Type of the user lock (BasicLockable).
+     * @param [in] lock The user lock, locked by the caller.
+     * @param [in] deadline The monotonic time when to stop waiting.
+     * @retval true Notified.
+     * @retval false The deadline expired.
+     */
+    template <class L>
+    bool
+    wait_until (L& lock,
+                const std::chrono::steady_clock::time_point& deadline);
+
+    /**
+     * @brief Wake the oldest waiter, if any.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    notify_one (void);
+
+    /**
+     * @brief Wake all waiters.
+     * @par Parameters
+     *  None.
+     * @par Returns
+     *  Nothing.
+     */
+    void
+    notify_all (void);
+
+    /**
+     * @brief Check if there are waiters.
+     * @par Parameters
+     *  None.
+     * @retval true No thread is waiting.
+     * @retval false At least one thread is waiting.
+     */
+    bool
+    empty (void);
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief The node linked by each waiting thread, on its stack.
+     */
+    class waiter
+    {
+    public:
+      /**
+       * @brief The waiter was not yet claimed by a notifier.
+       */
+      static constexpr std::uint32_t waiting = 0;
+
+      /**
+       * @brief The waiter was unlinked by a notifier, which still
+       * uses the node.
+       */
+      static constexpr std::uint32_t claimed = 1;
+
+      /**
+       * @brief The notifier no longer uses the node.
+       */
+      static constexpr std::uint32_t notified = 2;
+
+      /**
+       * @brief Links to the other waiters.
+       */
+      double_list_links links_;
+
+      /**
+       * @brief The futex word.
+       */
+      std::atomic<std::uint32_t> state_{ waiting };
+    };
+
+    static_assert (sizeof (std::atomic<std::uint32_t>) == 4,
+                   "The futex word must have 32-bits!");
+
+    /**
+     * @brief Type of the lists of waiters.
+     */
+    using waiter_list
+        = intrusive_list<waiter, double_list_links, &waiter::links_>;
+
+    /**
+     * @brief Link the waiter and release the user lock.
+     * @param [in] node The waiter.
+     * @param [in] lock The user lock.
+     * @par Returns
+     *  Nothing.
+     */
+    template <class L>
+    void
+    enqueue_ (waiter& node, L& lock);
+
+    /**
+     * @brief Block until the waiter is notified, or until the
+     * deadline expires.
+     * @param [in] node The linked waiter.
+     * @param [in] deadline The monotonic deadline, or `nullptr`
+     *  to wait forever.
+     * @retval true Notified.
+     * @retval false The deadline expired.
+     */
+    bool
+    block_ (waiter& node, const std::chrono::steady_clock::time_point*
+                              deadline);
+
+    /**
+     * @brief Wake a waiter unlinked by a notifier.
+     * @param [in] node The claimed waiter.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    wake_ (waiter* node);
+
+    /**
+     * @brief Sleep while the futex word has the expected value.
+     * @param [in] word The address of the futex word.
+     * @param [in] expected The value checked by the kernel.
+     * @param [in] timeout The relative timeout, or `nullptr`.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    futex_wait_ (std::atomic<std::uint32_t>* word, std::uint32_t expected,
+                 const struct timespec* timeout);
+
+    /**
+     * @brief Wake the thread sleeping on the futex word.
+     * @param [in] word The address of the futex word.
+     * @par Returns
+     *  Nothing.
+     */
+    static void
+    futex_wake_ (std::atomic<std::uint32_t>* word);
+
+    /**
+     * @brief The waiting threads, in FIFO order.
+     */
+    waiter_list waiters_;
+
+    /**
+     * @brief The lock protecting the list.
+     */
+    lock_type lock_;
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(__linux__)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "wait-list-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_WAIT_LIST_H_
+
+// ----------------------------------------------------------------------------
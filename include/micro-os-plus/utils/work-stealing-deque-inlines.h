@@ -0,0 +1,268 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_INLINES_H_
+#define MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_INLINES_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  work_stealing_deque<T, N, MP, InitialCapacity>::work_stealing_deque ()
+      : ring_{ &initial_ring_ }, initial_ring_{ InitialCapacity - 1, nullptr,
+                                                initial_slots_ }
+  {
+  }
+
+  /**
+   * @details
+   * The elements still in the deque are not touched.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  work_stealing_deque<T, N, MP, InitialCapacity>::~work_stealing_deque ()
+  {
+    ring_type* ring = ring_.load (std::memory_order_relaxed);
+    while (ring != &initial_ring_)
+      {
+        ring_type* retired = ring->retired;
+        ::operator delete (static_cast<void*> (ring));
+        ring = retired;
+      }
+  }
+
+  /**
+   * @details
+   * The element is stored in its slot before the bottom index is
+   * advanced with release semantics, so a thief that sees the new
+   * index also sees the element.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  bool
+  work_stealing_deque<T, N, MP, InitialCapacity>::push (reference element)
+  {
+    const index_type bottom = bottom_.load (std::memory_order_relaxed);
+    const index_type top = top_.load (std::memory_order_acquire);
+    ring_type* ring = ring_.load (std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<index_type> (ring->mask))
+      {
+        ring = grow_ (ring, top, bottom);
+        if (ring == nullptr)
+          {
+            return false;
+          }
+        ring_.store (ring, std::memory_order_release);
+      }
+
+    ring->slots[static_cast<size_type> (bottom) & ring->mask].store (
+        &element, std::memory_order_relaxed);
+    bottom_.store (bottom + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @details
+   * The bottom index is decremented first, and the full fence
+   * orders this before reading the top index; thieves either
+   * see the smaller deque, or the owner sees their progress.
+   * Only the race for the last element is decided with a
+   * compare-and-swap.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  typename work_stealing_deque<T, N, MP, InitialCapacity>::pointer
+  work_stealing_deque<T, N, MP, InitialCapacity>::pop (void)
+  {
+    const index_type bottom = bottom_.load (std::memory_order_relaxed) - 1;
+    ring_type* ring = ring_.load (std::memory_order_relaxed);
+    bottom_.store (bottom, std::memory_order_release);
+
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    index_type top = top_.load (std::memory_order_relaxed);
+    if (top > bottom)
+      {
+        // Empty, restore the index.
+        bottom_.store (bottom + 1, std::memory_order_release);
+        return nullptr;
+      }
+
+    pointer element
+        = ring->slots[static_cast<size_type> (bottom) & ring->mask].load (
+            std::memory_order_relaxed);
+    if (top == bottom)
+      {
+        // The last element, race with the thieves.
+        if (!top_.compare_exchange_strong (top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+          {
+            element = nullptr;
+          }
+        bottom_.store (bottom + 1, std::memory_order_release);
+      }
+
+    return element;
+  }
+
+  /**
+   * @details
+   * The element is read before claiming it; if the compare-and-swap
+   * fails, another thief (or the owner) took it, and the steal is
+   * retried as long as the deque is not empty.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  typename work_stealing_deque<T, N, MP, InitialCapacity>::pointer
+  work_stealing_deque<T, N, MP, InitialCapacity>::steal (void)
+  {
+    index_type top = top_.load (std::memory_order_acquire);
+    while (true)
+      {
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        const index_type bottom = bottom_.load (std::memory_order_acquire);
+        if (top >= bottom)
+          {
+            return nullptr;
+          }
+
+        ring_type* ring = ring_.load (std::memory_order_acquire);
+        pointer element
+            = ring->slots[static_cast<size_type> (top) & ring->mask].load (
+                std::memory_order_relaxed);
+        if (top_.compare_exchange_strong (top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_acquire))
+          {
+            return element;
+          }
+        // The failed compare-and-swap reloaded top.
+      }
+  }
+
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  template <class L>
+  typename work_stealing_deque<T, N, MP, InitialCapacity>::size_type
+  work_stealing_deque<T, N, MP, InitialCapacity>::drain_into (L& list)
+  {
+    size_type count = 0;
+    pointer element;
+    while ((element = steal ()) != nullptr)
+      {
+        list.link_tail (*element);
+        ++count;
+      }
+
+    return count;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  inline bool
+  work_stealing_deque<T, N, MP, InitialCapacity>::empty (void) const
+  {
+    const index_type top = top_.load (std::memory_order_acquire);
+    return bottom_.load (std::memory_order_acquire) <= top;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  inline typename work_stealing_deque<T, N, MP, InitialCapacity>::size_type
+  work_stealing_deque<T, N, MP, InitialCapacity>::size (void) const
+  {
+    const index_type top = top_.load (std::memory_order_acquire);
+    const index_type bottom = bottom_.load (std::memory_order_acquire);
+    return (bottom > top) ? static_cast<size_type> (bottom - top) : 0;
+  }
+
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  inline typename work_stealing_deque<T, N, MP, InitialCapacity>::size_type
+  work_stealing_deque<T, N, MP, InitialCapacity>::capacity (void) const
+  {
+    return ring_.load (std::memory_order_acquire)->mask + 1;
+  }
+
+  /**
+   * @details
+   * The ring header and its slots are allocated as a single block.
+   * The elements keep their indices, only the mask changes.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity>
+  typename work_stealing_deque<T, N, MP, InitialCapacity>::ring_type*
+  work_stealing_deque<T, N, MP, InitialCapacity>::grow_ (ring_type* ring,
+                                                         index_type top,
+                                                         index_type bottom)
+  {
+    const size_type capacity = (ring->mask + 1) * 2;
+    void* storage = ::operator new (
+        sizeof (ring_type) + capacity * sizeof (std::atomic<pointer>),
+        std::nothrow);
+    if (storage == nullptr)
+      {
+        return nullptr;
+      }
+
+    ring_type* new_ring = static_cast<ring_type*> (storage);
+    auto* slots = reinterpret_cast<std::atomic<pointer>*> (new_ring + 1);
+    for (size_type i = 0; i < capacity; ++i)
+      {
+        ::new (static_cast<void*> (&slots[i])) std::atomic<pointer>{ nullptr };
+      }
+    ::new (storage) ring_type{ capacity - 1, ring, slots };
+
+    for (index_type i = top; i < bottom; ++i)
+      {
+        const auto index = static_cast<size_type> (i);
+        slots[index & new_ring->mask].store (
+            ring->slots[index & ring->mask].load (std::memory_order_relaxed),
+            std::memory_order_relaxed);
+      }
+
+    return new_ring;
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_INLINES_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,311 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+/*
+ * Work-stealing deques (Chase-Lev), for task runtimes.
+ *
+ * Each worker owns a deque; it pushes and pops tasks at the bottom,
+ * like a stack, without read-modify-write operations except when
+ * racing for the last task; other workers steal from the top with
+ * a compare-and-swap.
+ *
+ * The deque is a ring of pointers to the tasks, which grows when
+ * full. The first ring is part of the deque object; the larger
+ * rings are allocated from the heap, and the old rings are kept
+ * until the deque is destroyed, since thieves may still read them.
+ */
+
+#ifndef MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_H_
+#define MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_H_
+
+// ----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/utils/lists.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @ingroup micro-os-plus-utils-lists-intrusive-lists
+   * @brief A class template for a work-stealing deque of intrusive
+   * elements.
+   * @headerfile work-stealing-deque.h
+   * <micro-os-plus/utils/work-stealing-deque.h>
+   * @ingroup micro-os-plus-utils
+   * @tparam T Type of object that includes the intrusive node.
+   * @tparam N Type of intrusive node with the next & previous links.
+   * @tparam MP Name of the intrusive node member in object T.
+   * @tparam InitialCapacity The capacity of the embedded ring;
+   *  must be a power of 2.
+   *
+   * @par Examples
+   *
+   * @code{.cpp}
+   * utils::work_stealing_deque<task, utils::double_list_links,
+   *     &task::links_> deque;
+   *
+   * // In the owner.
+   * deque.push (*t);
+   * task* next = deque.pop ();
+   *
+   * // In the other workers.
+   * task* stolen = deque.steal ();
+   * @endcode
+   *
+   * @details
+   * `push()` and `pop()` must be called only by the owner thread,
+   * `steal()` and `drain_into()` may be called by any thread.
+   *
+   * The deque stores only pointers to the elements; their links
+   * are not used while in the deque, and are used by `drain_into()`
+   * to link the remaining elements to a list.
+   */
+  template <class T, class N, N T::*MP, std::size_t InitialCapacity = 64>
+  class work_stealing_deque
+  {
+  public:
+    static_assert (std::is_base_of<double_list_links_base, N>::value == true,
+                   "N must be derived from double_list_links_base!");
+    static_assert (InitialCapacity > 0
+                       && (InitialCapacity & (InitialCapacity - 1)) == 0,
+                   "InitialCapacity must be a power of 2!");
+
+    /**
+     * @brief Type of value "pointed to" by the iterator.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Type of pointer to object "pointed to" by the iterator.
+     */
+    using pointer = value_type*;
+
+    /**
+     * @brief Type of reference to object "pointed to" by the iterator.
+     */
+    using reference = value_type&;
+
+    /**
+     * @brief Type of the sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of the top and bottom indices.
+     */
+    using index_type = std::ptrdiff_t;
+
+    /**
+     * @brief Construct an empty deque.
+     */
+    work_stealing_deque ();
+
+    /**
+     * @cond ignore
+     */
+
+    // The rule of five.
+    work_stealing_deque (const work_stealing_deque&) = delete;
+    work_stealing_deque (work_stealing_deque&&) = delete;
+    work_stealing_deque&
+    operator= (const work_stealing_deque&)
+        = delete;
+    work_stealing_deque&
+    operator= (work_stealing_deque&&)
+        = delete;
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Destruct the deque and free the allocated rings.
+     */
+    ~work_stealing_deque ();
+
+    /**
+     * @brief Add an element at the bottom of the deque (owner only).
+     * @param [in] element Reference to the element.
+     * @retval true The element was added.
+     * @retval false The deque was full and a larger ring could
+     *  not be allocated.
+     */
+    bool
+    push (reference element);
+
+    /**
+     * @brief Remove the element at the bottom of the deque
+     * (owner only).
+     * @par Parameters
+     *  None.
+     * @return Pointer to the most recently pushed element, or
+     *  `nullptr` if the deque is empty.
+     */
+    pointer
+    pop (void);
+
+    /**
+     * @brief Remove the element at the top of the deque.
+     * @par Parameters
+     *  None.
+     * @return Pointer to the oldest element, or `nullptr` if the
+     *  deque is empty.
+     */
+    pointer
+    steal (void);
+
+    /**
+     * @brief Move all elements to the tail of a list, oldest first.
+     * @tparam L Type of the intrusive list, using the same T, N, MP.
+     * @param [in] list Reference to the list.
+     * @return The number of moved elements.
+     */
+    template <class L>
+    size_type
+    drain_into (L& list);
+
+    /**
+     * @brief Check if the deque is empty.
+     * @par Parameters
+     *  None.
+     * @retval true The deque has no elements.
+     * @retval false The deque has at least one element.
+     */
+    bool
+    empty (void) const;
+
+    /**
+     * @brief Get the number of elements in the deque.
+     * @par Parameters
+     *  None.
+     * @return The number of elements, approximate while thieves
+     *  are active.
+     */
+    size_type
+    size (void) const;
+
+    /**
+     * @brief Get the capacity of the current ring.
+     * @par Parameters
+     *  None.
+     * @return The number of elements that fit without growing.
+     */
+    size_type
+    capacity (void) const;
+
+    // ------------------------------------------------------------------------
+
+  protected:
+    /**
+     * @brief Type of the rings of pointers.
+     */
+    struct ring_type
+    {
+      /**
+       * @brief Mask to get the slot from an index.
+       */
+      size_type mask;
+
+      /**
+       * @brief The previous (smaller) ring, kept until destruction.
+       */
+      ring_type* retired;
+
+      /**
+       * @brief The array of slots.
+       */
+      std::atomic<pointer>* slots;
+    };
+
+    /**
+     * @brief Allocate a ring twice as large and copy the elements.
+     * @param [in] ring Pointer to the current ring.
+     * @param [in] top The top index.
+     * @param [in] bottom The bottom index.
+     * @return Pointer to the new ring, or `nullptr` if the
+     *  allocation failed.
+     */
+    ring_type*
+    grow_ (ring_type* ring, index_type top, index_type bottom);
+
+    /**
+     * @brief The top index, advanced by the thieves.
+     */
+    alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+        std::atomic<index_type> top_{ 0 };
+
+    /**
+     * @brief The bottom index, written by the owner.
+     */
+    alignas (MICRO_OS_PLUS_UTILS_LISTS_CACHE_LINE_SIZE)
+        std::atomic<index_type> bottom_{ 0 };
+
+    /**
+     * @brief The current ring, replaced by the owner.
+     */
+    std::atomic<ring_type*> ring_;
+
+    /**
+     * @brief The embedded ring.
+     */
+    ring_type initial_ring_;
+
+    /**
+     * @brief The slots of the embedded ring.
+     */
+    std::atomic<pointer> initial_slots_[InitialCapacity];
+  };
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+#endif // __cplusplus
+
+// ===== Inline & template implementations ====================================
+
+#include "work-stealing-deque-inlines.h"
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_UTILS_WORK_STEALING_DEQUE_H_
+
+// ----------------------------------------------------------------------------
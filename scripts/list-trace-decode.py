@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+#
+# This file is part of the µOS++ distribution.
+#   (https://github.com/micro-os-plus/)
+# Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+#
+# Permission to use, copy, modify, and/or distribute this software
+# for any purpose is hereby granted, under the terms of the MIT license.
+#
+# If a copy of the license was not distributed with this file, it can
+# be obtained from https://opensource.org/licenses/MIT/.
+#
+# -----------------------------------------------------------------------------
+
+# -----------------------------------------------------------------------------
+# Decode the binary dumps written by `utils::list_tracer::dump()` and
+# print the timeline of the list operations, merged from all rings.
+#
+# Usage:
+#   list-trace-decode.py [--names FILE] DUMP
+#
+# The optional names file has lines with an address and a name
+# (like `0x7ffd1234 ready_list`), used instead of the raw addresses.
+# -----------------------------------------------------------------------------
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x4352544C
+VERSION = 2
+
+HEADER_SIZE = 16
+RECORD_SIZE = 32
+
+# Must match `list_tracer::operation`.
+OPERATIONS = {
+    1: ("link_next", "after"),
+    2: ("link_previous", "before"),
+    3: ("unlink", "from"),
+    4: ("clear", ""),
+    5: ("relink_moved", "from"),
+    6: ("link_range", "after"),
+    7: ("splice", "from"),
+    8: ("take_all", "into"),
+    9: ("exchange", "with"),
+    10: ("remove_if", ""),
+    11: ("partition", "into"),
+    12: ("reverse", ""),
+}
+
+
+def read_names(path):
+    names = {}
+    with open(path, "r", encoding="utf-8") as f:
+        for line in f:
+            fields = line.split(None, 1)
+            if len(fields) == 2 and not fields[0].startswith("#"):
+                names[int(fields[0], 0)] = fields[1].strip()
+    return names
+
+
+def decode(data):
+    # The magic number also identifies the byte order of the target.
+    for order in "<>":
+        magic, version, count, lost = struct.unpack_from(order + "4I", data, 0)
+        if magic == MAGIC:
+            break
+    else:
+        raise ValueError("not a list trace dump (bad magic)")
+
+    if version != VERSION:
+        raise ValueError(f"unsupported dump version {version}")
+
+    if len(data) < HEADER_SIZE + count * RECORD_SIZE:
+        raise ValueError("truncated dump")
+
+    records = []
+    incomplete = 0
+    for i in range(count):
+        record = struct.unpack_from(
+            order + "3Q2I", data, HEADER_SIZE + i * RECORD_SIZE
+        )
+        # Operation 0 marks records being written during the dump.
+        if record[3] == 0:
+            incomplete += 1
+        else:
+            records.append(record)
+
+    # Merge the rings; each ring is already in chronological order.
+    records.sort(key=lambda r: r[0])
+    return records, lost, incomplete
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Print the list trace timeline.")
+    parser.add_argument("dump", help="the binary dump file")
+    parser.add_argument("--names", help="file with addresses and names")
+    args = parser.parse_args()
+
+    names = read_names(args.names) if args.names else {}
+
+    def name(address):
+        return names.get(address, f"0x{address:x}")
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    try:
+        records, lost, incomplete = decode(data)
+    except (ValueError, struct.error) as e:
+        print(f"{args.dump}: {e}", file=sys.stderr)
+        return 1
+
+    print(f"{len(records)} records, {lost} overwritten, {incomplete} incomplete")
+    if not records:
+        return 0
+
+    start = records[0][0]
+    for timestamp, node, peer, op, ring in records:
+        operation, preposition = OPERATIONS.get(op, (f"op{op}", ""))
+        line = f"{timestamp - start:>12}  T{ring:<3} {operation:<14} {name(node)}"
+        if preposition:
+            line += f" {preposition} {name(peer)}"
+        print(line)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,459 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/utils/indexed-list.h>
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  /**
+   * @details
+   * The node is removed with the usual binary search tree algorithm;
+   * if it has two children, its place is taken by its successor.
+   * The nodes on the path to the root are then updated and
+   * rebalanced.
+   *
+   * Unlinking a node that is not linked has no effect.
+   */
+  void
+  indexed_list_links::unlink (void)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() %p \n", __func__, this);
+#endif
+
+    if (!linked ())
+      {
+        return;
+      }
+
+    indexed_list_links* start;
+    if (left_ == nullptr || right_ == nullptr)
+      {
+        indexed_list_links* child = (left_ != nullptr) ? left_ : right_;
+        if (child != nullptr)
+          {
+            child->parent_ = parent_;
+          }
+        replace_child_ (parent_, this, child);
+        start = parent_;
+      }
+    else
+      {
+        indexed_list_links* successor = right_;
+        while (successor->left_ != nullptr)
+          {
+            successor = successor->left_;
+          }
+
+        if (successor->parent_ != this)
+          {
+            // Detach the successor (it has no left child).
+            start = successor->parent_;
+            start->left_ = successor->right_;
+            if (successor->right_ != nullptr)
+              {
+                successor->right_->parent_ = start;
+              }
+
+            successor->right_ = right_;
+            right_->parent_ = successor;
+          }
+        else
+          {
+            start = successor;
+          }
+
+        // Move the successor in place of this node.
+        successor->left_ = left_;
+        left_->parent_ = successor;
+        successor->parent_ = parent_;
+        replace_child_ (parent_, this, successor);
+      }
+
+    reset_ ();
+    rebalance_ (start);
+  }
+
+  /**
+   * @details
+   * The position is the size of the left subtree, plus, for each
+   * ancestor reached from the right, the size of its left
+   * subtree and one for the ancestor itself.
+   */
+  indexed_list_links::size_type
+  indexed_list_links::index (void) const
+  {
+    assert (linked ());
+
+    size_type result = subtree_size_ (left_);
+    const indexed_list_links* node = this;
+    const indexed_list_links* parent = parent_;
+    while (!parent->is_head_ ())
+      {
+        if (node == parent->right_)
+          {
+            result += subtree_size_ (parent->left_) + 1;
+          }
+        node = parent;
+        parent = parent->parent_;
+      }
+
+    return result;
+  }
+
+  /**
+   * @details
+   * The successor is the leftmost node of the right subtree, or,
+   * if there is no right subtree, the first ancestor reached from
+   * the left. After the last node, this is the list head; after the
+   * list head, the first node.
+   */
+  indexed_list_links*
+  indexed_list_links::next (void) const
+  {
+    const indexed_list_links* node = this;
+    if (is_head_ ())
+      {
+        if (left_ == nullptr)
+          {
+            return const_cast<indexed_list_links*> (this);
+          }
+        node = left_;
+        while (node->left_ != nullptr)
+          {
+            node = node->left_;
+          }
+        return const_cast<indexed_list_links*> (node);
+      }
+
+    if (right_ != nullptr)
+      {
+        node = right_;
+        while (node->left_ != nullptr)
+          {
+            node = node->left_;
+          }
+        return const_cast<indexed_list_links*> (node);
+      }
+
+    const indexed_list_links* parent = parent_;
+    while (node == parent->right_)
+      {
+        node = parent;
+        parent = parent->parent_;
+      }
+    return const_cast<indexed_list_links*> (parent);
+  }
+
+  /**
+   * @details
+   * Symmetric to `next()`; the predecessor of the list head is
+   * the last node.
+   */
+  indexed_list_links*
+  indexed_list_links::previous (void) const
+  {
+    const indexed_list_links* node = this;
+    if (is_head_ () || left_ != nullptr)
+      {
+        if (left_ == nullptr)
+          {
+            return const_cast<indexed_list_links*> (this);
+          }
+        node = left_;
+        while (node->right_ != nullptr)
+          {
+            node = node->right_;
+          }
+        return const_cast<indexed_list_links*> (node);
+      }
+
+    const indexed_list_links* parent = parent_;
+    while (!parent->is_head_ () && node == parent->left_)
+      {
+        node = parent;
+        parent = parent->parent_;
+      }
+    return const_cast<indexed_list_links*> (parent);
+  }
+
+  void
+  indexed_list_links::update_ (indexed_list_links* node)
+  {
+    node->size_
+        = subtree_size_ (node->left_) + subtree_size_ (node->right_) + 1;
+
+    const int left_height = subtree_height_ (node->left_);
+    const int right_height = subtree_height_ (node->right_);
+    node->height_ = static_cast<height_type> (
+        ((left_height > right_height) ? left_height : right_height) + 1);
+  }
+
+  /**
+   * @details
+   * The tree root is the left child of the list head, so the
+   * head needs no special case.
+   */
+  void
+  indexed_list_links::replace_child_ (indexed_list_links* parent,
+                                      indexed_list_links* old_child,
+                                      indexed_list_links* new_child)
+  {
+    if (parent->left_ == old_child)
+      {
+        parent->left_ = new_child;
+      }
+    else
+      {
+        parent->right_ = new_child;
+      }
+  }
+
+  indexed_list_links*
+  indexed_list_links::rotate_left_ (indexed_list_links* node)
+  {
+    indexed_list_links* pivot = node->right_;
+
+    node->right_ = pivot->left_;
+    if (pivot->left_ != nullptr)
+      {
+        pivot->left_->parent_ = node;
+      }
+
+    pivot->parent_ = node->parent_;
+    replace_child_ (node->parent_, node, pivot);
+
+    pivot->left_ = node;
+    node->parent_ = pivot;
+
+    update_ (node);
+    update_ (pivot);
+
+    return pivot;
+  }
+
+  indexed_list_links*
+  indexed_list_links::rotate_right_ (indexed_list_links* node)
+  {
+    indexed_list_links* pivot = node->left_;
+
+    node->left_ = pivot->right_;
+    if (pivot->right_ != nullptr)
+      {
+        pivot->right_->parent_ = node;
+      }
+
+    pivot->parent_ = node->parent_;
+    replace_child_ (node->parent_, node, pivot);
+
+    pivot->right_ = node;
+    node->parent_ = pivot;
+
+    update_ (node);
+    update_ (pivot);
+
+    return pivot;
+  }
+
+  /**
+   * @details
+   * All nodes up to the root are visited, since the subtree sizes
+   * change all the way up; at most O(log n) rotations are performed.
+   */
+  void
+  indexed_list_links::rebalance_ (indexed_list_links* node)
+  {
+    while (!node->is_head_ ())
+      {
+        update_ (node);
+
+        const int balance
+            = subtree_height_ (node->left_) - subtree_height_ (node->right_);
+        if (balance > 1)
+          {
+            if (subtree_height_ (node->left_->left_)
+                < subtree_height_ (node->left_->right_))
+              {
+                rotate_left_ (node->left_);
+              }
+            node = rotate_right_ (node);
+          }
+        else if (balance < -1)
+          {
+            if (subtree_height_ (node->right_->right_)
+                < subtree_height_ (node->right_->left_))
+              {
+                rotate_right_ (node->right_);
+              }
+            node = rotate_left_ (node);
+          }
+
+        node = node->parent_;
+      }
+  }
+
+  // ==========================================================================
+
+  indexed_list_base::indexed_list_base ()
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+
+    head_.is_head_node_ = true;
+  }
+
+  indexed_list_base::~indexed_list_base ()
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+  }
+
+  void
+  indexed_list_base::clear (void)
+  {
+    head_.left_ = nullptr;
+  }
+
+  /**
+   * @details
+   * Descend from the root, using the subtree sizes to decide
+   * which way to go.
+   */
+  indexed_list_links*
+  indexed_list_base::nth_node_ (size_type index) const
+  {
+    indexed_list_links* node = head_.left_;
+    while (node != nullptr)
+      {
+        const size_type left_size
+            = indexed_list_links::subtree_size_ (node->left_);
+        if (index < left_size)
+          {
+            node = node->left_;
+          }
+        else if (index == left_size)
+          {
+            return node;
+          }
+        else
+          {
+            index -= left_size + 1;
+            node = node->right_;
+          }
+      }
+
+    return nullptr;
+  }
+
+  /**
+   * @details
+   * The new node becomes the predecessor of the node currently at
+   * the given position (or the successor of the last node), as a
+   * leaf, then the tree is rebalanced from its parent up.
+   */
+  void
+  indexed_list_base::insert_node_at_ (size_type index,
+                                      indexed_list_links* node)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() link %p at %u\n", __func__, node,
+                   static_cast<unsigned int> (index));
+#endif
+
+    assert (!node->linked ());
+    assert (index <= size ());
+
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->size_ = 1;
+    node->height_ = 1;
+
+    indexed_list_links* parent = &head_;
+    bool as_left = true;
+
+    if (head_.left_ != nullptr)
+      {
+        indexed_list_links* at = nth_node_ (index);
+        if (at == nullptr)
+          {
+            // Append after the last node.
+            parent = head_.left_;
+            while (parent->right_ != nullptr)
+              {
+                parent = parent->right_;
+              }
+            as_left = false;
+          }
+        else if (at->left_ == nullptr)
+          {
+            parent = at;
+          }
+        else
+          {
+            parent = at->left_;
+            while (parent->right_ != nullptr)
+              {
+                parent = parent->right_;
+              }
+            as_left = false;
+          }
+      }
+
+    if (as_left)
+      {
+        parent->left_ = node;
+      }
+    else
+      {
+        parent->right_ = node;
+      }
+    node->parent_ = parent;
+
+    indexed_list_links::rebalance_ (parent);
+  }
+
+  indexed_list_links*
+  indexed_list_base::first_node_ (void) const
+  {
+    return head_.next ();
+  }
+
+  // ==========================================================================
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
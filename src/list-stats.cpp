@@ -0,0 +1,123 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/utils/list-stats.h>
+#include <micro-os-plus/utils/locks.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+  namespace
+  {
+    /**
+     * @brief The registry lock, constant initialised.
+     */
+    spin_lock registry_lock;
+  } // namespace
+#endif
+
+  list_stats::registry_guard::registry_guard ()
+  {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    registry_lock.lock ();
+#endif
+  }
+
+  list_stats::registry_guard::~registry_guard ()
+  {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    registry_lock.unlock ();
+#endif
+  }
+
+  // --------------------------------------------------------------------------
+
+  /**
+   * @details
+   * Statically allocated in the **bss** section, so it can be
+   * used by the constructors of other static lists, regardless
+   * of the order of the static constructors.
+   */
+  list_stats::registry_type list_stats::registry_;
+
+  static_assert (std::atomic_ref<list_stats::counter_type>::required_alignment
+                     <= alignof (list_stats::counter_type),
+                 "The counters must be accessible via atomic references!");
+
+  /**
+   * @details
+   * For statically allocated lists, the counters and the name are
+   * not written, since other static constructors may have already
+   * used the list; otherwise they are cleared before the object
+   * is registered.
+   *
+   * The registration is serialised by the registry lock.
+   */
+  list_stats::list_stats (bool statically_allocated)
+  {
+    if (!statically_allocated)
+      {
+        name_ = nullptr;
+        store_ (links_count_, 0);
+        store_ (unlinks_count_, 0);
+        store_ (iterations_count_, 0);
+        store_ (length_, 0);
+        store_ (max_length_, 0);
+      }
+
+    registry_guard guard;
+    registry_.initialize_once ();
+    registry_.link_tail (*this);
+  }
+
+  list_stats::~list_stats ()
+  {
+    registry_guard guard;
+    registry_links_.unlink ();
+  }
+
+  void
+  list_stats::reset (void)
+  {
+    store_ (links_count_, 0);
+    store_ (unlinks_count_, 0);
+    store_ (iterations_count_, 0);
+    store_ (max_length_, load_ (length_));
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/list-tracer.h>
+
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#include <chrono>
+#endif
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  list_tracer::ring_type list_tracer::rings_[list_tracer::rings];
+
+  namespace
+  {
+    std::atomic<list_tracer::clock_function> clock_{ nullptr };
+
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+
+    // The ring used by the current thread, plus one (0 if not assigned).
+    thread_local std::size_t thread_ring_ = 0;
+
+    // The number of threads assigned so far.
+    std::atomic<std::size_t> threads_{ 0 };
+
+    std::size_t
+    current_ring (void)
+    {
+      if (thread_ring_ == 0)
+        {
+          thread_ring_ = (threads_.fetch_add (1, std::memory_order_relaxed)
+                          % list_tracer::rings)
+                         + 1;
+        }
+      return thread_ring_ - 1;
+    }
+
+    std::uint64_t
+    default_clock (void)
+    {
+      return static_cast<std::uint64_t> (
+          std::chrono::duration_cast<std::chrono::nanoseconds> (
+              std::chrono::steady_clock::now ().time_since_epoch ())
+              .count ());
+    }
+
+#else
+
+    constexpr std::size_t
+    current_ring (void)
+    {
+      return 0;
+    }
+
+    // 32-bits, to be lock free on all cores.
+    std::atomic<std::uint32_t> sequence_{ 0 };
+
+    std::uint64_t
+    default_clock (void)
+    {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+      return sequence_.fetch_add (1, std::memory_order_relaxed);
+#else
+      const std::uint32_t value = sequence_.load (std::memory_order_relaxed);
+      sequence_.store (value + 1, std::memory_order_relaxed);
+      return value;
+#endif
+    }
+
+#endif
+  } // namespace
+
+  /**
+   * @details
+   * The slot is reserved with an atomic increment, so records from
+   * threads sharing a ring (or from interrupts) do not overwrite
+   * each other. On cores without atomic read-modify-write
+   * instructions, the increment is a plain load and store, and a
+   * record written by an interrupt at the same moment may be lost.
+   *
+   * The sequence word is cleared before the fields are written,
+   * and set to the record number plus one after them, with release
+   * semantics, so that the dump can detect incomplete records.
+   */
+  void
+  list_tracer::record (operation op, const void* node, const void* peer)
+  {
+    ring_type& ring = rings_[current_ring ()];
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    const std::size_t n = ring.head.fetch_add (1, std::memory_order_relaxed);
+#else
+    const std::size_t n = ring.head.load (std::memory_order_relaxed);
+    ring.head.store (n + 1, std::memory_order_relaxed);
+#endif
+
+    const clock_function clock = clock_.load (std::memory_order_relaxed);
+    const std::uint64_t timestamp
+        = (clock != nullptr) ? clock () : default_clock ();
+
+    record_type& r = ring.records[n & (ring_size - 1)];
+    r.sequence.store (0, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    r.timestamp_low.store (static_cast<std::uint32_t> (timestamp),
+                           std::memory_order_relaxed);
+    r.timestamp_high.store (static_cast<std::uint32_t> (timestamp >> 32),
+                            std::memory_order_relaxed);
+    r.node.store (node, std::memory_order_relaxed);
+    r.peer.store (peer, std::memory_order_relaxed);
+    r.op.store (op, std::memory_order_relaxed);
+
+    r.sequence.store (n + 1, std::memory_order_release);
+  }
+
+  void
+  list_tracer::set_clock (clock_function clock)
+  {
+    clock_.store (clock, std::memory_order_relaxed);
+  }
+
+  void
+  list_tracer::reset (void)
+  {
+    for (auto& ring : rings_)
+      {
+        // Forget the old sequence numbers, which may match again.
+        for (auto& r : ring.records)
+          {
+            r.sequence.store (0, std::memory_order_relaxed);
+          }
+        ring.head.store (0, std::memory_order_release);
+      }
+  }
+
+  // --------------------------------------------------------------------------
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+// ----------------------------------------------------------------------------
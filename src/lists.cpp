@@ -17,8 +17,12 @@
 #endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
 
 #include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/list-tracer.h>
 #include <micro-os-plus/diag/trace.h>
 
+#include <atomic>
+#include <cstdlib>
+
 // ----------------------------------------------------------------------------
 
 #if defined(__GNUC__)
@@ -41,10 +45,22 @@ namespace micro_os_plus::utils
    *
    * Only statically allocated nodes in the initial state are uninitialized.
    * Regular nodes are always initialised.
+   *
+   * On cores with atomic compare-and-swap, the node may be
+   * initialised concurrently by `initialize_once()`, which sets
+   * **next** last; thus only **next** is checked, with an acquire
+   * load, and a non-null value guarantees that **previous** is
+   * also visible.
    */
   bool
   double_list_links_base::uninitialized (void) const
   {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    std::atomic_ref<double_list_links_base*> next{
+      const_cast<double_list_links_base*&> (next_)
+    };
+    return next.load (std::memory_order_acquire) == nullptr;
+#else
     if (previous_ == nullptr || next_ == nullptr)
       {
         assert (previous_ == nullptr);
@@ -52,6 +68,7 @@ namespace micro_os_plus::utils
         return true;
       }
     return false;
+#endif
   }
 
   /**
@@ -68,14 +85,53 @@ namespace micro_os_plus::utils
    * This method must be manually called for statically
    * allocated list before
    * inserting elements, or performing any other operations.
+   *
+   * The method may be called concurrently, including with
+   * `link_tail_concurrent()`; the slow path takes the
+   * global lock used by the concurrent list operations (see
+   * `concurrent_links_guard`), sets **previous**, then publishes
+   * **next** with a release store, so that a non-null **next**
+   * guarantees that **previous** was also set. The slow path runs
+   * at most a few times per list, thus the lock is not contended.
+   *
+   * The fast path is a single load, without the lock; the concurrent
+   * operations store the head **next** atomically (see
+   * `link_previous_concurrent()`). It uses acquire semantics,
+   * not relaxed, so that a caller that finds the list initialised
+   * also sees **previous** set, even when it then reads the list
+   * without holding a lock (on x86 and Arm64 this costs
+   * the same as a plain load).
+   *
+   * On cores without atomic compare-and-swap, the plain
+   * check-then-write is used, and concurrent calls must be
+   * done from a critical section.
    */
   void
   double_list_links_base::initialize_once (void)
   {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    std::atomic_ref<double_list_links_base*> next{ next_ };
+    if (next.load (std::memory_order_acquire) != nullptr)
+      {
+        return;
+      }
+
+    concurrent_links_guard guard;
+
+    // Another caller may have initialised it while waiting for the lock.
+    if (next.load (std::memory_order_relaxed) != nullptr)
+      {
+        return;
+      }
+
+    previous_ = this;
+    next.store (this, std::memory_order_release);
+#else
     if (uninitialized ())
       {
         initialize ();
       }
+#endif
   }
 
   /**
@@ -88,8 +144,13 @@ namespace micro_os_plus::utils
   void
   double_list_links_base::link_next (double_list_links_base* node)
   {
-#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::link_next, node, this);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
     trace::printf ("%s() link %p after %p\n", __func__, node, this);
+#endif
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+    list_integrity::sample (this);
 #endif
     assert (next_ != nullptr);
     assert (next_->previous_ != nullptr);
@@ -112,8 +173,13 @@ namespace micro_os_plus::utils
   void
   double_list_links_base::link_previous (double_list_links_base* node)
   {
-#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::link_previous, node, this);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
     trace::printf ("%s() link %p before %p\n", __func__, node, this);
+#endif
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+    list_integrity::sample (this);
 #endif
     assert (next_ != nullptr);
     assert (next_->previous_ != nullptr);
@@ -126,6 +192,44 @@ namespace micro_os_plus::utils
     previous_ = node;
   }
 
+  /**
+   * @details
+   * The same as `link_previous()`, but the store to the **next**
+   * pointer of the old previous node, which is the list head when
+   * the list is empty, is atomic, with release semantics, since
+   * the head **next** is read without the lock by `initialize_once()`
+   * and `uninitialized()`.
+   *
+   * Must be called with the lock taken (see `concurrent_links_guard`).
+   */
+  void
+  double_list_links_base::link_previous_concurrent (
+      double_list_links_base* node)
+  {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::link_previous, node, this);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() link %p before %p\n", __func__, node, this);
+#endif
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+    list_integrity::sample (this);
+#endif
+    assert (next_ != nullptr);
+    assert (next_->previous_ != nullptr);
+
+    // Make the new node point to its new neighbours.
+    node->next_ = this;
+    node->previous_ = previous_;
+
+    std::atomic_ref<double_list_links_base*>{ previous_->next_ }.store (
+        node, std::memory_order_release);
+    previous_ = node;
+#else
+    link_previous (node);
+#endif
+  }
+
   /**
    * @details
    * Update both neighbours to
@@ -137,9 +241,14 @@ namespace micro_os_plus::utils
   void
   double_list_links_base::unlink (void)
   {
-#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::unlink, this, previous_);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
     trace::printf ("%s() %p \n", __func__, this);
 #endif
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+    list_integrity::sample (this);
+#endif
 
     // Make neighbours point to each other.
     // This works even if the node is already unlinked,
@@ -169,6 +278,66 @@ namespace micro_os_plus::utils
     return true;
   }
 
+  /**
+   * @details
+   * Unlinked nodes point to themselves, so they are consistent too.
+   */
+  bool
+  double_list_links_base::consistent (void) const
+  {
+    if (next_ == nullptr || previous_ == nullptr)
+      {
+        return false;
+      }
+    return next_->previous_ == this && previous_->next_ == this;
+  }
+
+  /**
+   * @details
+   * Used when the object that contains the node was relocated,
+   * either with a bitwise copy (like `memcpy()`), or by constructing
+   * a new object and leaving the old one in place. The pointers are
+   * taken from the old node, whose neighbours still point to the old
+   * location; make the neighbours point to this node.
+   *
+   * The old node must remain accessible until this call returns;
+   * afterwards it is no longer referred by the list and can be
+   * re-initialised or destroyed.
+   *
+   * An unlinked old node points to itself; reset this node to
+   * point to itself. Uninitialised nodes are copied as they are.
+   */
+  void
+  double_list_links_base::relink_moved (const double_list_links_base* old_node)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+    list_tracer::record (list_tracer::operation::relink_moved, this, old_node);
+#elif defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() %p from %p\n", __func__, this, old_node);
+#endif
+
+    next_ = old_node->next_;
+    previous_ = old_node->previous_;
+
+    if (next_ == nullptr)
+      {
+        // Statically allocated nodes in the initial state.
+        assert (previous_ == nullptr);
+        return;
+      }
+
+    if (next_ == old_node)
+      {
+        // The node was not linked.
+        assert (previous_ == old_node);
+        initialize ();
+        return;
+      }
+
+    previous_->next_ = this;
+    next_->previous_ = this;
+  }
+
   // ==========================================================================
 
   /**
@@ -188,6 +357,192 @@ namespace micro_os_plus::utils
   }
 
   // ==========================================================================
+
+  /**
+   * @details
+   * Link the node as in the base class, then stamp it with the
+   * list head and the current list generation, taken from this node
+   * (which is either the list head or an element of the list).
+   */
+  void
+  generation_double_list_links::link_next (generation_double_list_links* node)
+  {
+    double_list_links_base::link_next (node);
+
+    node->set_head_ (head_);
+    node->generation_ = head_->generation_;
+  }
+
+  /**
+   * @details
+   * Link the node as in the base class, then stamp it with the
+   * list head and the current list generation, taken from this node
+   * (which is either the list head or an element of the list).
+   */
+  void
+  generation_double_list_links::link_previous (
+      generation_double_list_links* node)
+  {
+    double_list_links_base::link_previous (node);
+
+    node->set_head_ (head_);
+    node->generation_ = head_->generation_;
+  }
+
+  /**
+   * @details
+   * If the node belongs to the current list generation, update both
+   * neighbours to point to each other, as in the base class.
+   *
+   * Stale nodes (linked before the list was cleared) still point to
+   * their old neighbours, which may have been reused; they are only
+   * returned to the initial state, without touching the neighbours.
+   */
+  void
+  generation_double_list_links::unlink (void)
+  {
+    if (linked ())
+      {
+        double_list_links_base::unlink ();
+      }
+
+    initialize ();
+  }
+
+  /**
+   * @details
+   * To be _linked_, the node must be stamped with the current
+   * generation of its list, and both pointers must point to
+   * different nodes than itself.
+   *
+   * The list head is read to get its current generation, thus
+   * the list must still exist (checked in debug builds by the list
+   * head destructor).
+   */
+  bool
+  generation_double_list_links::linked (void) const
+  {
+    if (head_ == nullptr || head_->generation_ != generation_)
+      {
+        return false;
+      }
+
+    return double_list_links_base::linked ();
+  }
+
+  /**
+   * @details
+   * Stale nodes are not part of any list anymore, and are
+   * only returned to the initial state.
+   *
+   * The reference to the list head is transferred from the old node,
+   * which no longer refers the list; the old head pointer of this
+   * node, if any, is a copy of it, thus it is not released.
+   */
+  void
+  generation_double_list_links::relink_moved (
+      generation_double_list_links* old_node)
+  {
+    if (old_node->linked ())
+      {
+        head_ = old_node->head_;
+        old_node->head_ = nullptr;
+        generation_ = old_node->generation_;
+        double_list_links_base::relink_moved (old_node);
+      }
+    else
+      {
+        initialize ();
+      }
+  }
+
+  // ==========================================================================
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+  namespace
+  {
+    /**
+     * @brief The lock shared by all concurrent list operations.
+     */
+    std::atomic_flag concurrent_links_lock = ATOMIC_FLAG_INIT;
+  } // namespace
+#endif
+
+  /**
+   * @details
+   * Spin until the lock is acquired; the loop only reads the
+   * flag, to avoid bouncing the cache line while it is taken.
+   */
+  concurrent_links_guard::concurrent_links_guard ()
+  {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    while (concurrent_links_lock.test_and_set (std::memory_order_acquire))
+      {
+        while (concurrent_links_lock.test (std::memory_order_relaxed))
+          {
+            // Spin.
+          }
+      }
+#endif
+  }
+
+  concurrent_links_guard::~concurrent_links_guard ()
+  {
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+    concurrent_links_lock.clear (std::memory_order_release);
+#endif
+  }
+
+  // ==========================================================================
+
+  namespace
+  {
+    std::atomic<list_integrity::handler_function> integrity_handler{
+      nullptr
+    };
+
+    void
+    default_integrity_handler (
+        [[maybe_unused]] const double_list_links_base* node)
+    {
+      trace::printf ("list node %p corrupted\n", node);
+      std::abort ();
+    }
+  } // namespace
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING) \
+    && !(defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+  std::atomic<std::uint32_t> list_integrity::operations_{ 0 };
+#endif
+
+  void
+  list_integrity::set_handler (handler_function handler)
+  {
+    integrity_handler.store (handler, std::memory_order_relaxed);
+  }
+
+  bool
+  list_integrity::check (const double_list_links_base* node)
+  {
+    if (node->consistent ())
+      {
+        return true;
+      }
+
+    const handler_function handler
+        = integrity_handler.load (std::memory_order_relaxed);
+    if (handler != nullptr)
+      {
+        handler (node);
+      }
+    else
+      {
+        default_integrity_handler (node);
+      }
+    return false;
+  }
+
+  // ==========================================================================
 } // namespace micro_os_plus::utils
 
 #if defined(__GNUC__)
@@ -0,0 +1,185 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus/)
+ * Copyright (c) 2016 Liviu Ionescu. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software
+ * for any purpose is hereby granted, under the terms of the MIT license.
+ *
+ * If a copy of the license was not distributed with this file, it can
+ * be obtained from https://opensource.org/licenses/MIT/.
+ */
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_INCLUDE_CONFIG_H)
+#include <micro-os-plus/config.h>
+#endif // MICRO_OS_PLUS_INCLUDE_CONFIG_H
+
+#include <micro-os-plus/utils/rcu.h>
+#include <micro-os-plus/diag/trace.h>
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+// ----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+
+#pragma GCC diagnostic ignored "-Waggregate-return"
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#endif
+
+namespace micro_os_plus::utils
+{
+  // ==========================================================================
+
+  rcu_reader::rcu_reader (rcu_domain& domain) : domain_{ domain }
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+
+    domain_.readers_lock_.lock ();
+    domain_.readers_.link_tail (*this);
+    domain_.readers_lock_.unlock ();
+  }
+
+  rcu_reader::~rcu_reader ()
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+
+    assert (nesting_ == 0);
+
+    domain_.readers_lock_.lock ();
+    registry_links_.unlink ();
+    domain_.readers_lock_.unlock ();
+  }
+
+  /**
+   * @details
+   * The reader publishes the current epoch, then a full fence
+   * orders this store before all the following list reads; either
+   * a concurrent `synchronize()` sees the reader in the critical
+   * section, or the reader sees the list as updated before the
+   * grace period started.
+   */
+  void
+  rcu_reader::lock (void)
+  {
+    if (nesting_++ == 0)
+      {
+        epoch_.store (domain_.epoch_.load (std::memory_order_acquire),
+                      std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+      }
+  }
+
+  void
+  rcu_reader::unlock (void)
+  {
+    assert (nesting_ > 0);
+
+    if (--nesting_ == 0)
+      {
+        epoch_.store (0, std::memory_order_release);
+      }
+  }
+
+  // ==========================================================================
+
+  rcu_domain::rcu_domain ()
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+  }
+
+  rcu_domain::~rcu_domain ()
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+
+    assert (readers_.empty ());
+  }
+
+  /**
+   * @details
+   * Busy waits; it is intended for infrequent updates.
+   */
+  void
+  rcu_domain::synchronize (void)
+  {
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS)
+    trace::printf ("%s() @%p \n", __func__, this);
+#endif
+
+    const epoch_type target = advance ();
+    while (!is_quiescent (target))
+      {
+        // Spin.
+      }
+  }
+
+  /**
+   * @details
+   * The full fence orders the preceding unlinks before the new
+   * epoch; the epochs advance by 2, to remain odd.
+   */
+  rcu_domain::epoch_type
+  rcu_domain::advance (void)
+  {
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    return epoch_.fetch_add (2, std::memory_order_acq_rel) + 2;
+  }
+
+  /**
+   * @details
+   * The epochs are compared as a signed difference, to survive
+   * the wrap-around.
+   */
+  bool
+  rcu_domain::is_quiescent (epoch_type epoch)
+  {
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    bool result = true;
+
+    readers_lock_.lock ();
+    for (auto& reader : readers_)
+      {
+        const epoch_type e = reader.epoch_.load (std::memory_order_acquire);
+        if (e != 0 && static_cast<std::intptr_t> (e - epoch) < 0)
+          {
+            result = false;
+            break;
+          }
+      }
+    readers_lock_.unlock ();
+
+    return result;
+  }
+
+  rcu_domain::epoch_type
+  rcu_domain::epoch (void) const
+  {
+    return epoch_.load (std::memory_order_acquire);
+  }
+
+  // ==========================================================================
+} // namespace micro_os_plus::utils
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+// ----------------------------------------------------------------------------
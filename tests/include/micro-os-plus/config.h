@@ -25,12 +25,16 @@
 
 // #define MICRO_OS_PLUS_TRACE_UTILS_LISTS_CONSTRUCT
 // #define MICRO_OS_PLUS_TRACE_UTILS_LISTS
+// #define MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY
 
 // Propagate TRACE to the library.
 #define MICRO_TEST_PLUS_TRACE
 
 #endif // MICRO_OS_PLUS_TRACE
 
+// Check the neighbours of the nodes on all link and unlink operations.
+// #define MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING (1)
+
 #include <micro-os-plus/platform/config.h>
 
 // ----------------------------------------------------------------------------
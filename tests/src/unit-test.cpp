@@ -19,10 +19,38 @@
 #include <micro-os-plus/platform.h>
 #include <micro-os-plus/micro-test-plus.h>
 #include <micro-os-plus/utils/lists.h>
+#include <micro-os-plus/utils/node-pool.h>
+#include <micro-os-plus/utils/compact.h>
+#include <micro-os-plus/utils/prefetch.h>
+#include <micro-os-plus/utils/views.h>
+#include <micro-os-plus/utils/indexed-list.h>
+#include <micro-os-plus/utils/rcu.h>
+#include <micro-os-plus/utils/retire-list.h>
+#include <micro-os-plus/utils/intrusive-stack.h>
+#include <micro-os-plus/utils/spsc-queue.h>
+#include <micro-os-plus/utils/sharded-list.h>
+#include <micro-os-plus/utils/seqlock-list.h>
+#include <micro-os-plus/utils/work-stealing-deque.h>
+#include <micro-os-plus/utils/ordered-list.h>
+#include <micro-os-plus/utils/coroutines.h>
+#include <micro-os-plus/utils/wait-list.h>
+#include <micro-os-plus/utils/list-tracer.h>
+#include <micro-os-plus/utils/list-stats.h>
 
 #include <cassert>
 #include <cstring>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <string>
 #include <string_view>
+#include <span>
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
 #include <stdio.h>
 
 // #include <iostream>
@@ -575,3 +603,3755 @@ static micro_os_plus::micro_test_plus::test_suite ts_intrusive_list2
     = { "Intrusive list static nodes", check_intrusive_list<kids_list2> };
 
 // ----------------------------------------------------------------------------
+
+void
+check_node_pool (void);
+
+void
+check_node_pool (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+  using namespace std::literals; // For the "sv" literal.
+
+  using pool_type
+      = node_pool<kid, decltype (kid::registry_links_), &kid::registry_links_,
+                  3>;
+
+  static pool_type pool;
+
+  test_case ("Allocate all", [&] {
+    expect (eq (pool.available (), 3u)) << "all available";
+
+    kid* one = pool.create ("One");
+    kid* two = pool.create ("Two");
+    kid* three = pool.create ("Three");
+
+    expect (one != nullptr && two != nullptr && three != nullptr)
+        << "all allocated";
+    expect (pool.owns (one) && pool.owns (two) && pool.owns (three))
+        << "all owned";
+    expect (eq (pool.available (), 0u)) << "none available";
+    expect (pool.create ("Four") == nullptr) << "pool exhausted";
+
+    expect (!one->registry_links_.linked ()) << "new object unlinked";
+    expect (eq (std::string_view{ two->name () }, "Two"sv))
+        << "constructed";
+
+    pool.destroy (two);
+    expect (eq (pool.available (), 1u)) << "one available";
+
+    kid* again = pool.create ("Again");
+    expect (eq (again, two)) << "freed slot reused";
+    expect (eq (std::string_view{ again->name () }, "Again"sv))
+        << "reconstructed";
+
+    pool.destroy (one);
+    pool.destroy (again);
+    pool.destroy (three);
+    expect (eq (pool.available (), 3u)) << "all available again";
+  });
+
+  test_case ("Not owned", [&] {
+    kid stranger{ "Stranger" };
+    expect (!pool.owns (&stranger)) << "stack object not owned";
+  });
+
+  test_case ("Slab", [&] {
+    using slab_type
+        = node_slab<kid, decltype (kid::registry_links_),
+                    &kid::registry_links_, 2>;
+
+    slab_type slab;
+    expect (eq (slab.capacity (), 0u)) << "no chunks";
+
+    kid* objects[5];
+    for (auto& object : objects)
+      {
+        object = slab.create ("Kid");
+      }
+    expect (objects[4] != nullptr) << "allocated";
+    expect (eq (slab.capacity (), 6u)) << "three chunks";
+
+    kids_list list;
+    for (auto object : objects)
+      {
+        list.link_tail (*object);
+      }
+    expect (!list.empty ()) << "objects can be linked";
+    list.clear ();
+
+    slab.destroy (objects[3]);
+    expect (eq (slab.create ("Again"), objects[3])) << "freed slot reused";
+    expect (eq (slab.capacity (), 6u)) << "no new chunk";
+
+    for (auto object : objects)
+      {
+        slab.destroy (object);
+      }
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Shared pool", [] {
+    constexpr int threads_count = 4;
+    constexpr int rounds = 1000;
+
+    static node_pool<kid, decltype (kid::registry_links_),
+                     &kid::registry_links_, 8, spin_lock>
+        shared_pool;
+    static node_slab<kid, decltype (kid::registry_links_),
+                     &kid::registry_links_, 2, spin_lock>
+        shared_slab;
+
+    static const char* names[threads_count] = { "T0", "T1", "T2", "T3" };
+
+    std::atomic<bool> ok{ true };
+    std::thread threads[threads_count];
+    for (int t = 0; t < threads_count; ++t)
+      {
+        threads[t] = std::thread{ [&ok, t] {
+          for (int i = 0; i < rounds; ++i)
+            {
+              // A slot given to two threads gets the other name.
+              kid* a = shared_pool.create (names[t]);
+              kid* b = shared_slab.create (names[t]);
+              std::this_thread::yield ();
+              if (a == nullptr || b == nullptr || a->name () != names[t]
+                  || b->name () != names[t])
+                {
+                  ok.store (false, std::memory_order_relaxed);
+                }
+              if (a != nullptr)
+                {
+                  shared_pool.destroy (a);
+                }
+              if (b != nullptr)
+                {
+                  shared_slab.destroy (b);
+                }
+            }
+        } };
+      }
+    for (auto& t : threads)
+      {
+        t.join ();
+      }
+
+    expect (ok.load ()) << "distinct slots";
+    expect (eq (shared_pool.available (), 8u)) << "all returned";
+    expect (shared_slab.capacity () <= 2u * threads_count)
+        << "slots reused";
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_node_pool
+    = { "Node pool", check_node_pool };
+
+// ----------------------------------------------------------------------------
+
+// An object that belongs to two lists.
+class member
+{
+public:
+  member (int id) : id_{ id }
+  {
+  }
+
+  int id_;
+
+  utils::double_list_links all_links_;
+  utils::double_list_links odd_links_;
+};
+
+// The bitwise copy is fine for members.
+template <>
+struct micro_os_plus::utils::is_trivially_relocatable<member>
+    : std::true_type
+{
+};
+
+// An object with a string, which (with small strings) may point
+// inside itself, thus must be relocated with its move constructor.
+class named_member
+{
+public:
+  named_member (const char* name) : name_{ name }
+  {
+  }
+
+  // The links are not moved, but constructed unlinked.
+  named_member (named_member&& other) : name_{ std::move (other.name_) }
+  {
+  }
+
+  ~named_member ()
+  {
+    ++destructions;
+  }
+
+  std::string name_;
+
+  utils::double_list_links links_;
+
+  static inline int destructions = 0;
+};
+
+void
+check_compact (void);
+
+void
+check_compact (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+  using odd_list = intrusive_list<member, double_list_links,
+                                  &member::odd_links_>;
+
+  test_case ("Compact", [] {
+    node_slab<member, double_list_links, &member::all_links_, 4> slab;
+    node_pool<member, double_list_links, &member::all_links_, 8> pool;
+
+    all_list all;
+    odd_list odd;
+
+    // Scatter the objects with some churn.
+    member* objects[8];
+    for (int i = 0; i < 8; ++i)
+      {
+        objects[i] = slab.create (i);
+      }
+    for (int i = 0; i < 8; i += 2)
+      {
+        slab.destroy (objects[i]);
+      }
+    for (int i = 0; i < 8; i += 2)
+      {
+        objects[i] = slab.create (i);
+      }
+    for (int i = 7; i >= 0; --i)
+      {
+        all.link_tail (*objects[i]);
+        if (i % 2)
+          {
+            odd.link_tail (*objects[i]);
+          }
+      }
+
+    auto moved = compact<&member::odd_links_> (
+        all, pool, [&] (member* m) { slab.deallocate (m); });
+    expect (eq (moved, 8u)) << "all relocated";
+    expect (eq (pool.available (), 0u)) << "arena used";
+
+    int id = 7;
+    member* previous = nullptr;
+    bool in_order = true;
+    for (auto& m : all)
+      {
+        in_order &= (m.id_ == id--);
+        in_order &= pool.owns (&m);
+        in_order &= (previous == nullptr || previous + 1 == &m);
+        previous = &m;
+      }
+    expect (in_order) << "list order kept, contiguous";
+
+    id = 7;
+    bool odd_order = true;
+    for (auto& m : odd)
+      {
+        odd_order &= (m.id_ == id) && pool.owns (&m);
+        id -= 2;
+      }
+    expect (odd_order && id == -1) << "other list fixed";
+
+    member* even = &(*all.begin ());
+    ++even;
+    expect (!even->odd_links_.linked ()) << "unlinked node reset";
+
+    all.clear ();
+    odd.clear ();
+  });
+
+  test_case ("Compact with move", [] {
+    using named_list = intrusive_list<named_member, double_list_links,
+                                      &named_member::links_>;
+
+    node_slab<named_member, double_list_links, &named_member::links_, 2>
+        slab;
+    node_pool<named_member, double_list_links, &named_member::links_, 3>
+        pool;
+
+    named_list list;
+    const char* names[] = { "one", "two", "three" };
+    for (auto name : names)
+      {
+        list.link_tail (*slab.create (name));
+      }
+
+    named_member::destructions = 0;
+    auto moved = compact (list, pool, [&] (named_member* m) {
+      expect (!pool.owns (m)) << "old storage released";
+      slab.deallocate (m);
+    });
+    expect (eq (moved, 3u)) << "all relocated";
+    expect (eq (named_member::destructions, 3)) << "old objects destroyed";
+
+    std::size_t i = 0;
+    bool same = true;
+    for (auto& m : list)
+      {
+        same &= (m.name_ == names[i++]) && pool.owns (&m);
+      }
+    expect (same && i == 3) << "names moved, in order";
+
+    while (!list.empty ())
+      {
+        pool.destroy (list.unlink_head ());
+      }
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_compact
+    = { "Compact", check_compact };
+
+// ----------------------------------------------------------------------------
+
+void
+check_generation_list (void);
+
+void
+check_generation_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+  using namespace std::literals; // For the "sv" literal.
+
+  using gen_kid = child<generation_double_list_links>;
+  using gen_kids_list
+      = intrusive_list<gen_kid, generation_double_list_links,
+                       &gen_kid::registry_links_, generation_double_list_head>;
+
+  test_case ("Generation clear", [] {
+    gen_kids_list kids;
+    gen_kid marry{ "Marry" };
+    gen_kid bob{ "Bob" };
+    gen_kid sally{ "Sally" };
+
+    kids.link_tail (marry);
+    kids.link_tail (bob);
+    expect (marry.registry_links_.linked ()) << "Marry linked";
+    expect (bob.registry_links_.linked ()) << "Bob linked";
+
+    kids.clear ();
+    expect (kids.empty ()) << "list is empty";
+    expect (!marry.registry_links_.linked ()) << "Marry stale";
+    expect (!bob.registry_links_.linked ()) << "Bob stale";
+
+    kids.link_tail (sally);
+
+    // Unlinking a stale node must not touch the list.
+    bob.unlink ();
+    expect (!bob.registry_links_.linked ()) << "Bob unlinked";
+
+    auto it = kids.begin ();
+    expect (eq (std::string_view{ it->name () }, "Sally"sv))
+        << "Sally is first";
+    ++it;
+    expect (it == kids.end ()) << "iterator at end";
+
+    kids.link_tail (marry);
+    expect (marry.registry_links_.linked ()) << "Marry linked again";
+
+    marry.unlink ();
+    sally.unlink ();
+    expect (kids.empty ()) << "list is empty";
+
+    gen_kid* range[]{ &marry, &bob };
+    kids.link_tail_range (range);
+    expect (marry.registry_links_.linked () && bob.registry_links_.linked ())
+        << "range stamped";
+
+    kids.clear ();
+    expect (!marry.registry_links_.linked ()) << "range stale";
+  });
+
+  test_case ("Generation lifetime", [] {
+    gen_kids_list kids;
+    gen_kid tom{ "Tom" };
+    {
+      gen_kids_list other;
+      other.link_tail (tom);
+      other.clear ();
+
+      // The stale node no longer refers the inner list once
+      // relinked, so the inner list may be destroyed first.
+      kids.link_tail (tom);
+    }
+    expect (tom.registry_links_.linked ()) << "Tom in the outer list";
+
+    tom.unlink ();
+    expect (kids.empty ()) << "list is empty";
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_generation_list
+    = { "Generation list", check_generation_list };
+
+// ----------------------------------------------------------------------------
+
+void
+check_link_range (void);
+
+void
+check_link_range (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+  using namespace std::literals; // For the "sv" literal.
+
+  test_case ("Intrusive tail range", [] {
+    kids_list kids;
+    kid first{ "First" };
+    kids.link_tail (first);
+
+    kid array[3]{ { "A" }, { "B" }, { "C" } };
+    kids.link_tail_range (std::span<kid>{ array });
+
+    kid d{ "D" };
+    kid e{ "E" };
+    kid* pointers[2]{ &d, &e };
+    kids.link_tail_range (&pointers[0], &pointers[2]);
+
+    const char* expected[]{ "First", "A", "B", "C", "D", "E" };
+    std::size_t i = 0;
+    bool ok = true;
+    for (auto& k : kids)
+      {
+        ok &= (i < 6) && (std::string_view{ k.name () } == expected[i++]);
+      }
+    expect (ok && i == 6) << "forward order";
+
+    const kid* nodes[]{ &first, &array[0], &array[1], &array[2], &d, &e };
+    i = 6;
+    ok = true;
+    for (auto* node = kids.tail (); node != kids.links_pointer ();
+         node = static_cast<double_list_links*> (node->previous ()))
+      {
+        ok &= (i > 0) && (node == &nodes[--i]->registry_links_);
+      }
+    expect (ok && i == 0) << "backward links";
+
+    kids.link_tail_range (std::span<kid>{});
+    expect (eq (array[2].registry_links_.next (), &d.registry_links_))
+        << "empty range ignored";
+
+    kids.clear ();
+  });
+
+  test_case ("Intrusive head range", [] {
+    kids_list kids;
+    kid last{ "Last" };
+    kids.link_tail (last);
+
+    kid array[3]{ { "A" }, { "B" }, { "C" } };
+    kids.link_head_range (array);
+
+    const char* expected[]{ "A", "B", "C", "Last" };
+    std::size_t i = 0;
+    bool ok = true;
+    for (auto& k : kids)
+      {
+        ok &= (i < 4) && (std::string_view{ k.name () } == expected[i++]);
+      }
+    expect (ok && i == 4) << "order kept";
+
+    for (auto& k : array)
+      {
+        k.unlink ();
+      }
+    last.unlink ();
+    expect (kids.empty ()) << "list is empty";
+  });
+
+  test_case ("Double list range", [] {
+    double_list<double_list_links> list;
+    double_list_links nodes[4];
+    list.link_tail_range (nodes);
+
+    std::size_t i = 0;
+    bool ok = true;
+    for (auto& node : list)
+      {
+        ok &= (&node == &nodes[i++]);
+      }
+    expect (ok && i == 4) << "all linked in order";
+    expect (eq (list.tail (), &nodes[3])) << "tail is last";
+
+    list.clear ();
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_link_range
+    = { "Link range", check_link_range };
+
+// ----------------------------------------------------------------------------
+
+void
+check_prefetch (void);
+
+void
+check_prefetch (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+
+  test_case ("For each prefetch", [] {
+    all_list list;
+    member members[10]{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    list.link_tail_range (members);
+
+    int id = 0;
+    bool ok = true;
+    for_each_prefetch (list, [&] (member& m) { ok &= (m.id_ == id++); });
+    expect (ok && id == 10) << "all visited in order";
+
+    int sum = 0;
+    for_each_prefetch<true> (list, [&] (member& m) { sum += m.id_; });
+    expect (eq (sum, 45)) << "objects prefetched";
+
+    using iterator = prefetch_iterator<all_list::iterator>;
+    int count = 0;
+    for (iterator it{ list.begin (), list.end () },
+         end{ list.end (), list.end () };
+         it != end; it++)
+      {
+        count += (it->id_ == count) ? 1 : 100;
+      }
+    expect (eq (count, 10)) << "iterator adaptor";
+
+    all_list empty;
+    for_each_prefetch (empty, [&] (member&) { ++count; });
+    expect (eq (count, 10)) << "empty list";
+
+    list.clear ();
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_prefetch
+    = { "Prefetch", check_prefetch };
+
+// ----------------------------------------------------------------------------
+
+void
+check_bidirectional_iterators (void);
+
+void
+check_bidirectional_iterators (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+  using links_list = double_list<double_list_links>;
+
+  static_assert (std::bidirectional_iterator<all_list::iterator>);
+  static_assert (std::bidirectional_iterator<all_list::const_iterator>);
+  static_assert (std::bidirectional_iterator<links_list::iterator>);
+  static_assert (std::bidirectional_iterator<links_list::const_iterator>);
+  static_assert (std::ranges::bidirectional_range<all_list>);
+  static_assert (std::ranges::bidirectional_range<links_list>);
+  static_assert (
+      std::is_same_v<std::iter_reference_t<all_list::const_iterator>,
+                     const member&>);
+
+  test_case ("Intrusive list", [] {
+    all_list list;
+    member members[5]{ 0, 1, 2, 3, 4 };
+    list.link_tail_range (members);
+
+    int id = 4;
+    bool ok = true;
+    for (auto it = list.rbegin (); it != list.rend (); ++it)
+      {
+        ok &= (it->id_ == id--);
+      }
+    expect (ok && id == -1) << "reverse iterator";
+
+    id = 4;
+    ok = true;
+    for (const member& m : list | std::views::reverse)
+      {
+        ok &= (m.id_ == id--);
+      }
+    expect (ok && id == -1) << "reverse view";
+
+    all_list::const_iterator cit = list.begin ();
+    expect (cit == list.cbegin ()) << "converted to const";
+    expect (eq (std::ranges::distance (list.cbegin (), list.cend ()), 5))
+        << "const distance";
+
+    auto it = list.end ();
+    --it;
+    expect (eq (it->id_, 4)) << "pre-decrement";
+    it--;
+    expect (eq (it->id_, 3)) << "post-decrement";
+    it++;
+    expect (eq (it->id_, 4)) << "post-increment";
+
+    expect (eq (std::prev (list.crend ())->id_, 0)) << "const reverse";
+
+    list.clear ();
+  });
+
+  test_case ("Double list", [] {
+    links_list list;
+    double_list_links links[3];
+    for (auto& l : links)
+      {
+        list.link_tail (l);
+      }
+
+    auto it = list.end ();
+    it--;
+    expect (&*it == &links[2]) << "post-decrement";
+    it--;
+    expect (&*it == &links[1]) << "post-decrement again";
+    it++;
+    expect (&*it == &links[2]) << "post-increment";
+
+    expect (&*list.rbegin () == &links[2]) << "reverse begin";
+    expect (eq (std::ranges::distance (list.crbegin (), list.crend ()), 3))
+        << "const reverse distance";
+
+    list.clear ();
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_bidirectional_iterators
+    = { "Bidirectional iterators", check_bidirectional_iterators };
+
+// ----------------------------------------------------------------------------
+
+void
+check_views (void);
+
+void
+check_views (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+
+  test_case ("Filter, transform, take while", [] {
+    all_list list;
+    member members[10]{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    list.link_tail_range (members);
+
+    auto odd = list | views::filter ([] (const member& m) {
+                 return (m.id_ % 2) != 0;
+               });
+    int sum = 0;
+    bool same = true;
+    for (member& m : odd)
+      {
+        sum += m.id_;
+        same &= (&m == &members[m.id_]);
+      }
+    expect (eq (sum, 25)) << "filter";
+    expect (same) << "references to the original objects";
+
+    auto ids = list | views::take_while ([] (const member& m) {
+                 return m.id_ < 4;
+               })
+               | views::transform ([] (const member& m) { return m.id_; });
+    sum = 0;
+    for (int id : ids)
+      {
+        sum += id;
+      }
+    expect (eq (sum, 6)) << "take while and transform";
+
+    // The views are lazy, changes in the list are visible (but
+    // filter views cache the first element, do not unlink it).
+    members[3].all_links_.unlink ();
+    sum = 0;
+    for (member& m : odd)
+      {
+        sum += m.id_;
+      }
+    expect (eq (sum, 22)) << "lazy evaluation";
+
+    list.clear ();
+  });
+
+  test_case ("Chunk", [] {
+    all_list list;
+    member members[7]{ 0, 1, 2, 3, 4, 5, 6 };
+    list.link_tail_range (members);
+
+    static_assert (std::ranges::forward_range<decltype (list
+                                                        | views::chunk (3))>);
+
+    int chunks = 0;
+    int sum = 0;
+    std::size_t last_size = 0;
+    for (auto batch : list | views::chunk (3))
+      {
+        ++chunks;
+        last_size = 0;
+        for (member& m : batch)
+          {
+            sum += m.id_ * chunks;
+            ++last_size;
+          }
+      }
+    expect (eq (chunks, 3)) << "chunk count";
+    expect (eq (last_size, 1u)) << "last chunk shorter";
+    expect (eq (sum, (0 + 1 + 2) + 2 * (3 + 4 + 5) + 3 * 6))
+        << "chunk contents";
+
+    auto even = list | views::filter ([] (const member& m) {
+                  return (m.id_ % 2) == 0;
+                });
+    chunks = 0;
+    for (auto batch : views::chunk (even, 2))
+      {
+        expect (eq (batch.begin ()->id_, chunks * 4)) << "filtered chunk";
+        ++chunks;
+      }
+    expect (eq (chunks, 2)) << "chunk over a filter view";
+
+    all_list empty;
+    expect ((empty | views::chunk (2)).empty ()) << "empty list";
+
+    list.clear ();
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_views
+    = { "Views", check_views };
+
+// ----------------------------------------------------------------------------
+
+void
+check_list_algorithms (void);
+
+void
+check_list_algorithms (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+
+  auto ids = [] (const all_list& list) {
+    int value = 0;
+    for (const member& m : list)
+      {
+        value = value * 10 + m.id_;
+      }
+    return value;
+  };
+
+  test_case ("Remove if", [&] {
+    all_list list;
+    member members[8]{ 1, 2, 3, 4, 5, 6, 7, 8 };
+    list.link_tail_range (members);
+
+    int disposed = 0;
+    std::size_t count = list.remove_if (
+        [] (const member& m) { return m.id_ != 4 && m.id_ != 5; },
+        [&] (member& m) {
+          disposed += m.id_;
+          expect (!m.all_links_.linked ()) << "unlinked before disposer";
+        });
+    expect (eq (count, 6u)) << "count";
+    expect (eq (disposed, 1 + 2 + 3 + 6 + 7 + 8)) << "disposed";
+    expect (eq (ids (list), 45)) << "remaining";
+    expect (eq (std::ranges::distance (list.rbegin (), list.rend ()), 2))
+        << "backward links";
+
+    count = list.remove_if ([] (const member&) { return true; });
+    expect (eq (count, 2u) && list.empty ()) << "all removed";
+  });
+
+  test_case ("Unique", [&] {
+    all_list list;
+    member members[7]{ 1, 1, 2, 3, 3, 3, 1 };
+    list.link_tail_range (members);
+
+    int disposed = 0;
+    std::size_t count = list.unique (
+        [] (const member& a, const member& b) { return a.id_ == b.id_; },
+        [&] (member&) { ++disposed; });
+    expect (eq (count, 3u) && eq (disposed, 3)) << "count";
+    expect (eq (ids (list), 1231)) << "remaining";
+    expect (&*list.begin () == &members[0]) << "first kept";
+
+    list.clear ();
+  });
+
+  test_case ("Reverse", [&] {
+    all_list list;
+    list.reverse ();
+    expect (list.empty ()) << "empty list";
+
+    member members[4]{ 1, 2, 3, 4 };
+    list.link_tail_range (members);
+    list.reverse ();
+    expect (eq (ids (list), 4321)) << "reversed";
+    expect (eq (list.rbegin ()->id_, 1)) << "tail";
+
+    list.clear ();
+  });
+
+  test_case ("Partition", [&] {
+    all_list list;
+    all_list out;
+    member members[8]{ 1, 2, 4, 3, 6, 8, 5, 7 };
+    list.link_tail_range (members);
+
+    member extra{ 9 };
+    out.link_tail (extra);
+
+    std::size_t count = list.stable_partition (
+        [] (const member& m) { return (m.id_ % 2) == 0; }, out);
+    expect (eq (count, 4u)) << "count";
+    expect (eq (ids (list), 1357)) << "odd kept in order";
+    expect (eq (ids (out), 92468)) << "even moved in order";
+    expect (eq (out.rbegin ()->id_, 8)) << "destination tail";
+
+    count = list.partition ([] (const member&) { return false; }, out);
+    expect (eq (count, 0u) && eq (ids (list), 1357)) << "nothing moved";
+
+    list.clear ();
+    out.clear ();
+  });
+
+  test_case ("Double list", [&] {
+    double_list<double_list_links> list;
+    double_list<double_list_links> out;
+    double_list_links links[4];
+    list.link_tail_range (links);
+
+    list.reverse ();
+    expect (list.head () == &links[3]) << "reversed";
+
+    std::size_t count = list.partition (
+        [&] (double_list_links& l) { return &l == &links[0]; }, out);
+    expect (eq (count, 1u) && out.head () == &links[0]) << "partition";
+
+    count = list.remove_if (
+        [&] (double_list_links& l) { return &l == &links[2]; });
+    expect (eq (count, 1u) && !links[2].linked ()) << "remove if";
+    expect (list.head () == &links[3] && list.tail () == &links[1])
+        << "remaining";
+
+    list.clear ();
+    out.clear ();
+  });
+
+  test_case ("Splice", [&] {
+    all_list list;
+    all_list other;
+    member members[6]{ 1, 2, 3, 4, 5, 6 };
+    list.link_tail (members[0]);
+    list.link_tail (members[1]);
+    other.link_tail_range (std::span{ members + 2, 4 });
+
+    // Move 4, 5 between 1 and 2.
+    auto first = std::next (other.begin ());
+    list.splice (std::next (list.begin ()), other, first,
+                 std::next (first, 2));
+    expect (eq (ids (list), 1452)) << "range moved";
+    expect (eq (ids (other), 36)) << "range removed";
+
+    // Move all to the tail.
+    list.splice (list.end (), other, other.begin (), other.end ());
+    expect (eq (ids (list), 145236)) << "all moved";
+    expect (other.empty ()) << "source empty";
+    expect (eq (list.rbegin ()->id_, 6)) << "backward links";
+
+    // Empty range.
+    list.splice (list.begin (), other, other.begin (), other.end ());
+    expect (eq (ids (list), 145236)) << "nothing moved";
+
+    // Rotate within the same list.
+    list.splice (list.begin (), list, std::next (list.begin (), 4),
+                 list.end ());
+    expect (eq (ids (list), 361452)) << "rotated";
+    expect (eq (std::ranges::distance (list.rbegin (), list.rend ()), 6))
+        << "consistent";
+  });
+
+  test_case ("Take all and exchange", [&] {
+    all_list list;
+    all_list batch;
+    member members[5]{ 1, 2, 3, 4, 5 };
+    list.link_tail_range (std::span{ members, 3 });
+
+    list.take_all (batch);
+    expect (list.empty ()) << "source empty";
+    expect (eq (ids (batch), 123)) << "all taken";
+    expect (eq (batch.rbegin ()->id_, 3)) << "backward links";
+
+    // Nothing to take.
+    list.take_all (batch);
+    expect (eq (ids (batch), 123)) << "nothing taken";
+
+    list.link_tail (members[3]);
+    list.link_tail (members[4]);
+    null_lock lock;
+    list.exchange (batch, lock);
+    expect (eq (ids (list), 123)) << "exchanged";
+    expect (eq (ids (batch), 45)) << "exchanged back";
+    expect (eq (list.rbegin ()->id_, 3) && eq (batch.rbegin ()->id_, 5))
+        << "backward links exchanged";
+
+    // Exchange with an empty list, both ways.
+    all_list empty;
+    batch.exchange (empty);
+    expect (batch.empty () && eq (ids (empty), 45)) << "to empty";
+    batch.exchange (empty);
+    expect (empty.empty () && eq (ids (batch), 45)) << "from empty";
+
+    list.take_all (batch, lock);
+    expect (list.empty ()) << "source empty";
+    expect (eq (ids (batch), 45123)) << "appended";
+    expect (eq (std::ranges::distance (batch.rbegin (), batch.rend ()), 5))
+        << "consistent";
+  });
+
+  test_case ("Generation list", [] {
+    using gen_kid = child<generation_double_list_links>;
+    using gen_kids_list = intrusive_list<gen_kid, generation_double_list_links,
+                                         &gen_kid::registry_links_,
+                                         generation_double_list_head>;
+
+    gen_kids_list kids;
+    gen_kids_list out;
+    gen_kid marry{ "Marry" };
+    gen_kid bob{ "Bob" };
+    gen_kid sally{ "Sally" };
+    kids.link_tail (marry);
+    kids.link_tail (bob);
+    kids.link_tail (sally);
+
+    std::size_t count = kids.partition (
+        [&] (gen_kid& k) { return &k == &bob; }, out);
+    expect (eq (count, 1u) && &*out.begin () == &bob) << "partition";
+
+    out.clear ();
+    expect (!bob.registry_links_.linked ()) << "moved node stamped";
+
+    count = kids.remove_if ([&] (gen_kid& k) { return &k == &marry; });
+    expect (eq (count, 1u) && &*kids.begin () == &sally) << "remove if";
+
+    out.link_tail (bob);
+    kids.splice (kids.begin (), out, out.begin (), out.end ());
+    expect (&*kids.begin () == &bob && out.empty ()) << "splice";
+
+    kids.take_all (out);
+    expect (kids.empty () && &*out.begin () == &bob) << "take all";
+    out.exchange (kids);
+    expect (out.empty () && &*kids.begin () == &bob) << "exchange";
+
+    kids.clear ();
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent batches", [] {
+    constexpr int items = 4000;
+    all_list shared;
+    spin_lock lock;
+
+    auto producer = [&] (int first) {
+      for (int i = first; i < items; i += 2)
+        {
+          member* m = new member{ i };
+          lock.lock ();
+          shared.link_tail (*m);
+          lock.unlock ();
+        }
+    };
+
+    std::thread threads[] = { std::thread{ producer, 0 },
+                              std::thread{ producer, 1 } };
+
+    // The consumer takes whole batches, and processes them
+    // without holding the lock.
+    int consumed = 0;
+    int batches = 0;
+    bool ordered = true;
+    int last_even = -2;
+    int last_odd = -1;
+    while (consumed < items)
+      {
+        all_list batch;
+        shared.take_all (batch, lock);
+        if (batch.empty ())
+          {
+            std::this_thread::yield ();
+            continue;
+          }
+
+        ++batches;
+        while (!batch.empty ())
+          {
+            member* m = batch.unlink_head ();
+            int& last = ((m->id_ % 2) == 0) ? last_even : last_odd;
+            ordered = ordered && (m->id_ == last + 2);
+            last = m->id_;
+            ++consumed;
+            delete m;
+          }
+      }
+
+    for (auto& thread : threads)
+      {
+        thread.join ();
+      }
+
+    expect (eq (consumed, items)) << "all consumed";
+    expect (ordered) << "per producer order kept";
+    expect (gt (batches, 0)) << "batches taken";
+    expect (shared.empty ()) << "shared list empty";
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_list_algorithms
+    = { "List algorithms", check_list_algorithms };
+
+// ----------------------------------------------------------------------------
+
+void
+check_safe_iteration (void);
+
+void
+check_safe_iteration (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using all_list = intrusive_list<member, double_list_links,
+                                  &member::all_links_>;
+
+  test_case ("For each safe", [] {
+    all_list list;
+    member members[6]{ 0, 1, 2, 3, 4, 5 };
+    list.link_tail_range (members);
+
+    int visited = 0;
+    list.for_each_safe ([&] (member& m) {
+      ++visited;
+      if (m.id_ != 3)
+        {
+          m.all_links_.unlink ();
+        }
+    });
+    expect (eq (visited, 6)) << "all visited";
+    expect (&*list.begin () == &members[3]
+            && std::next (list.begin ()) == list.end ())
+        << "one left";
+
+    list.clear ();
+  });
+
+  test_case ("Drain if", [] {
+    all_list list;
+    all_list out;
+    member members[6]{ 0, 1, 2, 3, 4, 5 };
+    list.link_tail_range (members);
+
+    std::size_t count
+        = list.drain_if ([] (const member& m) { return m.id_ >= 2; },
+                         [&] (member& m) { out.link_head (m); });
+    expect (eq (count, 4u)) << "count";
+    expect (eq (std::ranges::distance (list), 2)) << "kept";
+    expect (eq (out.begin ()->id_, 5)) << "moved to another list";
+
+    list.clear ();
+    out.clear ();
+  });
+
+  test_case ("Safe iterator", [] {
+    all_list list;
+    member members[4]{ 0, 1, 2, 3 };
+    list.link_tail_range (members);
+
+    static_assert (std::forward_iterator<all_list::safe_iterator>);
+
+    int sum = 0;
+    for (auto it = list.safe_begin (); it != list.safe_end (); ++it)
+      {
+        sum += it->id_;
+        it->all_links_.unlink ();
+      }
+    expect (eq (sum, 6) && list.empty ()) << "unlinked while iterating";
+
+    all_list empty;
+    expect (empty.safe_begin () == empty.safe_end ()) << "empty list";
+  });
+
+  test_case ("Double list", [] {
+    double_list<double_list_links> list;
+    double_list_links links[3];
+    list.link_tail_range (links);
+
+    int visited = 0;
+    list.for_each_safe ([&] (double_list_links&) { ++visited; });
+    expect (eq (visited, 3)) << "all visited";
+
+    std::size_t count = list.drain_if (
+        [&] (double_list_links& l) { return &l != &links[1]; },
+        [] (double_list_links& l) { expect (!l.linked ()) << "unlinked"; });
+    expect (eq (count, 2u) && list.head () == &links[1]) << "drained";
+
+    list.clear ();
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_safe_iteration
+    = { "Safe iteration", check_safe_iteration };
+
+// ----------------------------------------------------------------------------
+
+class ranked
+{
+public:
+  int id_ = 0;
+
+  utils::indexed_list_links links_;
+};
+
+void
+check_indexed_list (void);
+
+void
+check_indexed_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  using ranked_list
+      = indexed_list<ranked, indexed_list_links, &ranked::links_>;
+
+  static_assert (std::bidirectional_iterator<ranked_list::iterator>);
+
+  test_case ("Basic", [] {
+    ranked_list list;
+    expect (list.empty () && eq (list.size (), 0u)) << "empty";
+    expect (list.begin () == list.end ()) << "empty iteration";
+    expect (list.nth (0) == nullptr) << "no nth";
+
+    ranked items[3];
+    for (int i = 0; i < 3; ++i)
+      {
+        items[i].id_ = i;
+      }
+    list.link_tail (items[1]);
+    list.link_head (items[0]);
+    list.link_tail (items[2]);
+
+    expect (eq (list.size (), 3u)) << "size";
+    expect (list.nth (0) == &items[0] && list.nth (2) == &items[2])
+        << "nth";
+    expect (eq (ranked_list::rank (items[1]), 1u)) << "rank";
+    expect (eq (std::prev (list.end ())->id_, 2)) << "last";
+
+    ranked_list::erase (items[1]);
+    expect (!items[1].links_.linked ()) << "erased";
+    expect (eq (list.size (), 2u) && list.nth (1) == &items[2]) << "after";
+
+    expect (list.erase_at (0) == &items[0]) << "erase at";
+    expect (list.erase_at (5) == nullptr) << "erase out of range";
+
+    list.clear ();
+    expect (list.empty ()) << "cleared";
+  });
+
+  test_case ("Random operations", [] {
+    constexpr int count = 100;
+    ranked items[count];
+    ranked* model[count];
+    int model_size = 0;
+
+    ranked_list list;
+    std::uint32_t seed = 12345;
+    auto random = [&seed] (int limit) {
+      seed = seed * 1103515245u + 12345u;
+      return static_cast<int> ((seed >> 8)
+                               % static_cast<std::uint32_t> (limit));
+    };
+
+    auto check = [&] () {
+      bool ok = eq (list.size (), static_cast<std::size_t> (model_size));
+      int i = 0;
+      for (ranked& r : list)
+        {
+          ok = ok && (i < model_size) && (&r == model[i]);
+          ++i;
+        }
+      ok = ok && (i == model_size);
+      for (i = 0; i < model_size; ++i)
+        {
+          ok = ok && (list.nth (static_cast<std::size_t> (i)) == model[i])
+               && (ranked_list::rank (*model[i])
+                   == static_cast<std::size_t> (i));
+        }
+      i = model_size;
+      for (auto it = list.rbegin (); it != list.rend (); ++it)
+        {
+          --i;
+          ok = ok && (i >= 0) && (&*it == model[i]);
+        }
+      return ok && (i == 0);
+    };
+
+    bool ok = true;
+    for (int i = 0; i < count; ++i)
+      {
+        items[i].id_ = i;
+        const int at = random (model_size + 1);
+        list.insert_at (static_cast<std::size_t> (at), items[i]);
+        std::memmove (&model[at + 1], &model[at],
+                      static_cast<std::size_t> (model_size - at)
+                          * sizeof (model[0]));
+        model[at] = &items[i];
+        ++model_size;
+        ok = ok && check ();
+      }
+    expect (ok) << "inserted in random positions";
+
+    ok = true;
+    while (model_size > 0)
+      {
+        const int at = random (model_size);
+        if ((model_size % 2) == 0)
+          {
+            ranked_list::erase (*model[at]);
+          }
+        else
+          {
+            list.erase_at (static_cast<std::size_t> (at));
+          }
+        std::memmove (&model[at], &model[at + 1],
+                      static_cast<std::size_t> (model_size - at - 1)
+                          * sizeof (model[0]));
+        --model_size;
+        ok = ok && check ();
+      }
+    expect (ok && list.empty ()) << "erased from random positions";
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_indexed_list
+    = { "Indexed list", check_indexed_list };
+
+// ----------------------------------------------------------------------------
+
+using member_queue = utils::spsc_queue<member, utils::double_list_links,
+                                       &member::all_links_, 4>;
+
+void
+check_spsc_queue (void);
+
+void
+check_spsc_queue (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Push and pop", [] {
+    member_queue queue;
+    expect (queue.empty ()) << "queue empty";
+    expect (queue.pop () == nullptr) << "nothing to pop";
+
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    member m4{ 4 };
+    member m5{ 5 };
+    expect (queue.push (m1) && queue.push (m2) && queue.push (m3)
+            && queue.push (m4))
+        << "4 pushed";
+    expect (!queue.push (m5)) << "queue full";
+    expect (eq (queue.size (), member_queue::capacity ())) << "size 4";
+
+    expect (eq (queue.pop ()->id_, 1)) << "FIFO";
+    expect (eq (queue.pop ()->id_, 2)) << "FIFO";
+    expect (queue.push (m5)) << "m5 pushed";
+  });
+
+  test_case ("Drain into list", [] {
+    member_queue queue;
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    member m4{ 4 };
+
+    // Move the indices, so that the elements wrap around the ring.
+    queue.push (m1);
+    queue.push (m2);
+    queue.pop ();
+    queue.pop ();
+
+    queue.push (m1);
+    queue.push (m2);
+    queue.push (m3);
+
+    intrusive_list<member, double_list_links, &member::all_links_> list;
+    list.link_tail (m4);
+    expect (eq (queue.drain_into (list), 3u)) << "3 drained";
+    expect (queue.empty ()) << "queue empty";
+
+    int ids[4] = {};
+    int count = 0;
+    for (auto& m : list)
+      {
+        ids[count++] = m.id_;
+      }
+    expect (eq (count, 4)) << "4 in list";
+    expect (ids[0] == 4 && ids[1] == 1 && ids[2] == 2 && ids[3] == 3)
+        << "in queue order";
+    expect (eq (list.rbegin ()->id_, 3)) << "links consistent";
+    expect (eq (queue.drain_into (list), 0u)) << "nothing drained";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Producer and consumer threads", [] {
+    constexpr int members_count = 64;
+    constexpr int items_count = 200000;
+
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ -1 };
+      }
+
+    static spsc_queue<member, double_list_links, &member::all_links_, 16>
+        queue;
+
+    std::thread producer{ [] {
+      for (int i = 0; i < items_count; ++i)
+        {
+          member* m = members[i % members_count];
+          m->id_ = i;
+          while (!queue.push (*m))
+            {
+            }
+        }
+    } };
+
+    int expected = 0;
+    bool ordered = true;
+    intrusive_list<member, double_list_links, &member::all_links_> list;
+    while (expected < items_count)
+      {
+        if (expected % 2)
+          {
+            member* m = queue.pop ();
+            if (m != nullptr)
+              {
+                ordered = ordered && (m->id_ == expected);
+                ++expected;
+              }
+          }
+        else
+          {
+            queue.drain_into (list);
+            for (auto& m : list)
+              {
+                ordered = ordered && (m.id_ == expected);
+                ++expected;
+              }
+            list.clear ();
+          }
+      }
+    producer.join ();
+
+    expect (ordered) << "all received, in order";
+    expect (queue.empty ()) << "queue empty";
+
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_spsc_queue
+    = { "SPSC queues", check_spsc_queue };
+
+// ----------------------------------------------------------------------------
+
+void
+check_sharded_list (void);
+
+void
+check_sharded_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Push, pop and steal", [] {
+    sharded_intrusive_list<member, double_list_links, &member::all_links_, 3,
+                           null_lock>
+        list;
+    expect (eq (list.size (), 0u)) << "empty";
+    expect (list.pop (0) == nullptr) << "nothing to pop";
+
+    member members[5]{ 1, 2, 3, 4, 5 };
+    for (auto& m : members)
+      {
+        list.push (0, m);
+      }
+    expect (eq (list.size (), 5u)) << "5 elements";
+    expect (eq (list.pop (0)->id_, 1)) << "local FIFO";
+
+    // Shard 2 is empty, steal the newest half (2 of 4) of shard 0.
+    expect (eq (list.pop (2)->id_, 4)) << "stolen";
+    expect (eq (list.size (2), 1u)) << "rest moved to local";
+    expect (eq (list.size (0), 2u)) << "half left";
+    expect (eq (list.pop (2)->id_, 5)) << "local";
+
+    expect (eq (list.steal (1, 0), 1u)) << "explicit steal";
+    expect (eq (list.pop (1)->id_, 3)) << "stolen element";
+    expect (eq (list.pop (1)->id_, 2)) << "last element";
+    expect (eq (list.size (), 0u)) << "empty again";
+  });
+
+  test_case ("Bounded steal", [] {
+    using list_type
+        = sharded_intrusive_list<member, double_list_links,
+                                 &member::all_links_, 2, null_lock>;
+    constexpr std::size_t count = 4 * list_type::max_steal;
+
+    list_type list;
+    static member* members[count];
+    for (std::size_t i = 0; i < count; ++i)
+      {
+        members[i] = new member{ static_cast<int> (i) };
+        list.push (0, *members[i]);
+      }
+
+    expect (eq (list.steal (1, 0), list_type::max_steal)) << "limited";
+    expect (eq (list.size (0), count - list_type::max_steal))
+        << "rest left";
+    expect (eq (list.pop (1)->id_,
+                static_cast<int> (count - list_type::max_steal)))
+        << "newest stolen, in order";
+
+    while (list.pop (0) != nullptr)
+      {
+      }
+    for (auto m : members)
+      {
+        delete m;
+      }
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent workers", [] {
+    constexpr int workers_count = 4;
+    constexpr int members_count = 256;
+
+    static sharded_intrusive_list<member, double_list_links,
+                                  &member::all_links_, workers_count>
+        list;
+
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        // Unbalanced, all in the first shard.
+        list.push (0, *members[i]);
+      }
+
+    std::atomic<bool> go{ false };
+    std::atomic<int> processed{ 0 };
+
+    std::thread workers[workers_count];
+    for (int w = 0; w < workers_count; ++w)
+      {
+        workers[w] = std::thread{ [&go, &processed, w] {
+          const auto shard = static_cast<std::size_t> (w);
+          while (!go.load (std::memory_order_acquire))
+            {
+            }
+          for (int round = 0; round < 20000; ++round)
+            {
+              member* m = list.pop (shard);
+              if (m != nullptr)
+                {
+                  processed.fetch_add (1, std::memory_order_relaxed);
+                  list.push (shard, *m);
+                }
+            }
+        } };
+      }
+    go.store (true, std::memory_order_release);
+    for (auto& t : workers)
+      {
+        t.join ();
+      }
+
+    int count = 0;
+    int sum = 0;
+    for (std::size_t shard = 0; shard < list.shards (); ++shard)
+      {
+        member* m;
+        while ((m = list.pop (shard)) != nullptr)
+          {
+            ++count;
+            sum += m->id_;
+          }
+      }
+
+    expect (processed.load () > 0) << "work done";
+    expect (eq (count, members_count)) << "all elements kept";
+    expect (eq (sum, members_count * (members_count - 1) / 2))
+        << "each element once";
+    expect (eq (list.size (), 0u)) << "empty";
+
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_sharded_list
+    = { "Sharded lists", check_sharded_list };
+
+// ----------------------------------------------------------------------------
+
+void
+check_seqlock_list (void);
+
+void
+check_seqlock_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Snapshots", [] {
+    seqlock_intrusive_list<member, double_list_links, &member::all_links_,
+                           null_lock>
+        list;
+    member* copy[4] = {};
+    expect (list.empty ()) << "list empty";
+    expect (eq (list.snapshot (copy), 0u)) << "empty snapshot";
+    expect (eq (list.sequence (), 0u)) << "no updates";
+
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    list.link_tail (m2);
+    list.link_tail (m3);
+    list.link_head (m1);
+    expect (eq (list.sequence (), 6u)) << "3 updates";
+
+    expect (eq (list.snapshot (copy), 3u)) << "3 copied";
+    expect (copy[0] == &m1 && copy[1] == &m2 && copy[2] == &m3) << "ordered";
+    expect (eq (list.snapshot (std::span{ copy, 2 }), 2u)) << "truncated";
+
+    list.unlink (m2);
+    expect (eq (list.snapshot (copy), 2u)) << "2 copied";
+    expect (copy[1] == &m3) << "m2 unlinked";
+
+    expect (list.unlink_tail () == &m3) << "tail unlinked";
+    expect (list.unlink_head () == &m1) << "head unlinked";
+    expect (list.unlink_head () == nullptr) << "nothing to unlink";
+    expect (list.empty ()) << "list empty again";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent snapshots", [] {
+    constexpr int readers_count = 3;
+    constexpr int members_count = 8;
+
+    static seqlock_intrusive_list<member, double_list_links,
+                                  &member::all_links_>
+        list;
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        list.link_tail (*members[i]);
+      }
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> snapshots{ 0 };
+    std::atomic<int> torn{ 0 };
+
+    std::thread readers[readers_count];
+    for (auto& t : readers)
+      {
+        t = std::thread{ [&] {
+          member* copy[members_count * 2];
+          while (!done.load (std::memory_order_acquire))
+            {
+              // Any consistent copy is a rotation of all elements.
+              const std::size_t count = list.snapshot (copy);
+              bool ok = (count == members_count);
+              for (std::size_t i = 1; ok && i < count; ++i)
+                {
+                  ok = (copy[i]->id_
+                        == (copy[i - 1]->id_ + 1) % members_count);
+                }
+              if (!ok)
+                {
+                  torn.fetch_add (1, std::memory_order_relaxed);
+                }
+              snapshots.fetch_add (1, std::memory_order_relaxed);
+            }
+        } };
+      }
+
+    for (int round = 0; round < 20000; ++round)
+      {
+        list.link_tail (*list.unlink_head ());
+        if (round % 64 == 0)
+          {
+            // Pause until a reader completes, to avoid starving them.
+            const int seen = snapshots.load (std::memory_order_relaxed);
+            while (snapshots.load (std::memory_order_relaxed) == seen)
+              {
+                std::this_thread::yield ();
+              }
+          }
+      }
+    done.store (true, std::memory_order_release);
+    for (auto& t : readers)
+      {
+        t.join ();
+      }
+
+    expect (snapshots.load () > 0) << "snapshots taken";
+    expect (eq (torn.load (), 0)) << "all snapshots consistent";
+
+    while (list.unlink_head () != nullptr)
+      {
+      }
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_seqlock_list
+    = { "Seqlock lists", check_seqlock_list };
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cpp_impl_coroutine)
+
+// A minimal coroutine type, started immediately, never awaited.
+class detached_task
+{
+public:
+  class promise_type
+  {
+  public:
+    detached_task
+    get_return_object (void)
+    {
+      return {};
+    }
+
+    std::suspend_never
+    initial_suspend (void)
+    {
+      return {};
+    }
+
+    std::suspend_never
+    final_suspend (void) noexcept
+    {
+      return {};
+    }
+
+    void
+    return_void (void)
+    {
+    }
+
+    void
+    unhandled_exception (void)
+    {
+      std::terminate ();
+    }
+  };
+};
+
+static detached_task
+wait_event (utils::async_event<>& event, int& log, int id)
+{
+  co_await event;
+  log = log * 10 + id;
+}
+
+static detached_task
+acquire_semaphore (utils::async_semaphore<>& semaphore, int& log, int id)
+{
+  co_await semaphore.acquire ();
+  log = log * 10 + id;
+}
+
+static detached_task
+hold_mutex (utils::async_mutex<>& mutex, utils::async_event<>& event,
+            int& log, int id)
+{
+  co_await mutex.lock ();
+  log = log * 10 + id;
+  co_await event;
+  mutex.unlock ();
+}
+
+static detached_task
+produce (utils::async_channel<int, 2>& channel, int count)
+{
+  for (int i = 1; i <= count; ++i)
+    {
+      co_await channel.send (i);
+    }
+}
+
+static detached_task
+consume (utils::async_channel<int, 2>& channel, int count, int& log)
+{
+  for (int i = 0; i < count; ++i)
+    {
+      const int value = co_await channel.receive ();
+      log = log * 10 + value;
+    }
+}
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+static detached_task
+wait_event_locked (utils::async_event<utils::spin_lock>& event,
+                   std::atomic<std::thread::id>& resumed_by)
+{
+  co_await event;
+  resumed_by.store (std::this_thread::get_id ());
+}
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+
+void
+check_coroutines (void);
+
+void
+check_coroutines (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Event", [] {
+    async_event<> event;
+    int log = 0;
+    wait_event (event, log, 1);
+    wait_event (event, log, 2);
+    wait_event (event, log, 3);
+    expect (eq (log, 0)) << "all parked";
+
+    event.set ();
+    expect (eq (log, 123)) << "resumed in FIFO order";
+    expect (event.is_set ()) << "event set";
+
+    wait_event (event, log, 4);
+    expect (eq (log, 1234)) << "not parked when set";
+
+    event.reset ();
+    wait_event (event, log, 5);
+    expect (eq (log, 1234)) << "parked after reset";
+    event.set ();
+    expect (eq (log, 12345)) << "resumed";
+  });
+
+  test_case ("Semaphore and mutex", [] {
+    async_semaphore<> semaphore{ 1 };
+    int log = 0;
+    acquire_semaphore (semaphore, log, 1);
+    acquire_semaphore (semaphore, log, 2);
+    acquire_semaphore (semaphore, log, 3);
+    expect (eq (log, 1)) << "one unit";
+    expect (!semaphore.try_acquire ()) << "no units left";
+
+    semaphore.release ();
+    expect (eq (log, 12)) << "handed to the oldest";
+    semaphore.release ();
+    semaphore.release ();
+    expect (eq (log, 123)) << "all resumed";
+    expect (eq (semaphore.count (), 1u)) << "one unit left";
+
+    async_mutex<> mutex;
+    async_event<> event;
+    log = 0;
+    hold_mutex (mutex, event, log, 1);
+    hold_mutex (mutex, event, log, 2);
+    expect (eq (log, 1)) << "first owner";
+    expect (!mutex.try_lock ()) << "mutex locked";
+
+    event.set ();
+    expect (eq (log, 12)) << "ownership passed";
+    expect (mutex.try_lock ()) << "mutex free";
+    mutex.unlock ();
+  });
+
+  test_case ("Channel", [] {
+    async_channel<int, 2> channel;
+    int log = 0;
+
+    // Senders park while the buffer is full.
+    produce (channel, 5);
+    expect (eq (channel.size (), 2u)) << "buffer full";
+    consume (channel, 5, log);
+    expect (eq (log, 12345)) << "all received in order";
+    expect (eq (channel.size (), 0u)) << "buffer empty";
+
+    // Receivers park while the buffer is empty.
+    log = 0;
+    consume (channel, 3, log);
+    expect (eq (log, 0)) << "receiver parked";
+    produce (channel, 3);
+    expect (eq (log, 123)) << "values handed over";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Wakeup from another thread", [] {
+    async_event<spin_lock> event;
+    std::atomic<std::thread::id> resumed_by{};
+    wait_event_locked (event, resumed_by);
+
+    std::thread setter{ [&] { event.set (); } };
+    const auto setter_id = setter.get_id ();
+    setter.join ();
+
+    expect (resumed_by.load () == setter_id) << "resumed by the setter";
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_coroutines
+    = { "Coroutines", check_coroutines };
+
+#endif // defined(__cpp_impl_coroutine)
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE) && defined(__linux__)
+
+void
+check_wait_list (void);
+
+void
+check_wait_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Notify one in FIFO order", [] {
+    std::mutex mx;
+    wait_list<> list;
+    int waiting = 0;
+    int tokens = 0;
+    int order[3] = {};
+    int done = 0;
+
+    std::thread threads[3];
+    for (int i = 0; i < 3; ++i)
+      {
+        threads[i] = std::thread{ [&, i] {
+          std::unique_lock lock{ mx };
+          ++waiting;
+          list.wait (lock, [&] { return tokens > 0; });
+          --tokens;
+          order[done++] = i + 1;
+        } };
+
+        // Wait until linked, to make the order predictable.
+        while (true)
+          {
+            {
+              std::lock_guard guard{ mx };
+              if (waiting == i + 1)
+                {
+                  break;
+                }
+            }
+            std::this_thread::yield ();
+          }
+      }
+
+    for (int i = 0; i < 3; ++i)
+      {
+        {
+          std::lock_guard guard{ mx };
+          ++tokens;
+        }
+        list.notify_one ();
+
+        while (true)
+          {
+            {
+              std::lock_guard guard{ mx };
+              if (done == i + 1)
+                {
+                  break;
+                }
+            }
+            std::this_thread::yield ();
+          }
+      }
+
+    for (auto& thread : threads)
+      {
+        thread.join ();
+      }
+
+    expect (eq (order[0], 1)) << "first waiter";
+    expect (eq (order[1], 2)) << "second waiter";
+    expect (eq (order[2], 3)) << "third waiter";
+    expect (list.empty ()) << "no waiters";
+  });
+
+  test_case ("Notify all", [] {
+    std::mutex mx;
+    wait_list<> list;
+    int waiting = 0;
+    bool ready = false;
+    std::atomic<int> awakened{ 0 };
+
+    std::thread threads[4];
+    for (auto& thread : threads)
+      {
+        thread = std::thread{ [&] {
+          std::unique_lock lock{ mx };
+          ++waiting;
+          list.wait (lock, [&] { return ready; });
+          awakened.fetch_add (1);
+        } };
+      }
+
+    while (true)
+      {
+        {
+          std::lock_guard guard{ mx };
+          if (waiting == 4)
+            {
+              ready = true;
+              break;
+            }
+        }
+        std::this_thread::yield ();
+      }
+    list.notify_all ();
+
+    for (auto& thread : threads)
+      {
+        thread.join ();
+      }
+
+    expect (eq (awakened.load (), 4)) << "all awakened";
+    expect (list.empty ()) << "no waiters";
+  });
+
+  test_case ("Timeouts", [] {
+    std::mutex mx;
+    wait_list<> list;
+    std::unique_lock lock{ mx };
+
+    const auto start = std::chrono::steady_clock::now ();
+    expect (!list.wait_for (lock, std::chrono::milliseconds (10)))
+        << "timed out";
+    expect (std::chrono::steady_clock::now () - start
+            >= std::chrono::milliseconds (10))
+        << "waited";
+    expect (lock.owns_lock ()) << "lock reacquired";
+    expect (list.empty ()) << "waiter unlinked";
+
+    expect (list.wait_for (lock, std::chrono::milliseconds (10),
+                           [] { return true; }))
+        << "predicate already true";
+  });
+
+  test_case ("Concurrent producers and consumers", [] {
+    constexpr int items = 20000;
+    std::mutex mx;
+    wait_list<> not_empty;
+    int available = 0;
+    int produced = 0;
+    int consumed = 0;
+    std::atomic<int> timeouts{ 0 };
+
+    auto producer = [&] {
+      while (true)
+        {
+          {
+            std::lock_guard guard{ mx };
+            if (produced == items)
+              {
+                break;
+              }
+            ++produced;
+            ++available;
+          }
+          not_empty.notify_one ();
+        }
+    };
+
+    auto consumer = [&] {
+      std::unique_lock lock{ mx };
+      while (consumed < items)
+        {
+          // Short timeouts, racing with the notifiers.
+          if (!not_empty.wait_for (lock, std::chrono::microseconds (50),
+                                   [&] {
+                                     return available > 0 || consumed == items;
+                                   }))
+            {
+              timeouts.fetch_add (1);
+              continue;
+            }
+          if (available > 0)
+            {
+              --available;
+              ++consumed;
+            }
+        }
+      lock.unlock ();
+      not_empty.notify_all ();
+    };
+
+    std::thread threads[]
+        = { std::thread{ consumer }, std::thread{ consumer },
+            std::thread{ consumer }, std::thread{ producer },
+            std::thread{ producer } };
+    for (auto& thread : threads)
+      {
+        thread.join ();
+      }
+
+    expect (eq (consumed, items)) << "all consumed";
+    expect (eq (available, 0)) << "none left";
+    expect (not_empty.empty ()) << "no waiters";
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_wait_list
+    = { "Wait lists", check_wait_list };
+
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE) && defined(__linux__)
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+// Large enough for all the rings.
+static unsigned char trace_buffer[sizeof (utils::list_tracer::dump_header)
+                                  + utils::list_tracer::rings
+                                        * utils::list_tracer::ring_size
+                                        * sizeof (
+                                            utils::list_tracer::dump_record)];
+
+static std::size_t
+dump_trace (void)
+{
+  std::size_t used = 0;
+  utils::list_tracer::dump ([&] (const void* data, std::size_t size) {
+    std::memcpy (trace_buffer + used, data, size);
+    used += size;
+  });
+  return used;
+}
+
+static utils::list_tracer::dump_record
+trace_record (std::size_t index)
+{
+  utils::list_tracer::dump_record r;
+  std::memcpy (&r,
+               trace_buffer + sizeof (utils::list_tracer::dump_header)
+                   + index * sizeof (r),
+               sizeof (r));
+  return r;
+}
+
+void
+check_list_tracer (void);
+
+void
+check_list_tracer (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Records", [] {
+    list_tracer::reset ();
+
+    double_list<double_list_links> list;
+    double_list_links a;
+    double_list_links b;
+    list.link_tail (a);
+    list.link_head (b);
+    a.unlink ();
+
+    const std::size_t used = dump_trace ();
+
+    list_tracer::dump_header header;
+    std::memcpy (&header, trace_buffer, sizeof (header));
+    expect (eq (header.magic, list_tracer::magic)) << "magic";
+    expect (eq (header.version, list_tracer::version)) << "version";
+    expect (eq (header.records, 4u)) << "4 records";
+    expect (eq (header.lost, 0u)) << "none lost";
+    expect (eq (used, sizeof (header) + 4 * sizeof (list_tracer::dump_record)))
+        << "dump size";
+
+    const auto head
+        = reinterpret_cast<std::uintptr_t> (list.links_pointer ());
+    const auto addr_a = reinterpret_cast<std::uintptr_t> (&a);
+    const auto addr_b = reinterpret_cast<std::uintptr_t> (&b);
+
+    const auto r0 = trace_record (0);
+    expect (eq (r0.op,
+                static_cast<std::uint32_t> (list_tracer::operation::clear))
+            && eq (r0.node, head))
+        << "clear";
+    const auto r1 = trace_record (1);
+    expect (eq (r1.op,
+                static_cast<std::uint32_t> (list_tracer::operation::link_next))
+            && eq (r1.node, addr_a) && eq (r1.peer, head))
+        << "link tail";
+    const auto r2 = trace_record (2);
+    expect (eq (r2.op, static_cast<std::uint32_t> (
+                           list_tracer::operation::link_previous))
+            && eq (r2.node, addr_b) && eq (r2.peer, addr_a))
+        << "link head";
+    const auto r3 = trace_record (3);
+    expect (eq (r3.op,
+                static_cast<std::uint32_t> (list_tracer::operation::unlink))
+            && eq (r3.node, addr_a) && eq (r3.peer, addr_b))
+        << "unlink";
+    expect (r0.timestamp <= r1.timestamp && r1.timestamp <= r2.timestamp
+            && r2.timestamp <= r3.timestamp)
+        << "timestamps in order";
+  });
+
+  test_case ("Ring overflow", [] {
+    list_tracer::reset ();
+
+    double_list_links head;
+    double_list_links node;
+    for (std::size_t i = 0; i < list_tracer::ring_size + 10; ++i)
+      {
+        head.link_next (&node);
+        node.unlink ();
+      }
+    dump_trace ();
+
+    list_tracer::dump_header header;
+    std::memcpy (&header, trace_buffer, sizeof (header));
+    expect (eq (header.records, list_tracer::ring_size)) << "ring full";
+    expect (eq (header.lost, list_tracer::ring_size + 20u)) << "oldest lost";
+    expect (eq (trace_record (header.records - 1).op,
+                static_cast<std::uint32_t> (list_tracer::operation::unlink)))
+        << "newest kept";
+  });
+
+  test_case ("Bulk operations", [] {
+    using list_type = double_list<double_list_links>;
+    list_type list;
+    list_type other;
+    double_list_links nodes[3];
+
+    list_tracer::reset ();
+    list.link_tail_range (nodes);
+    list.reverse ();
+    list.take_all (other);
+    list.exchange (other);
+    list.remove_if ([] (double_list_links&) { return false; });
+    list.partition ([] (double_list_links&) { return true; }, other);
+    list.splice (list.begin (), other, other.begin (), other.end ());
+    dump_trace ();
+
+    list_tracer::dump_header header;
+    std::memcpy (&header, trace_buffer, sizeof (header));
+    expect (eq (header.records, 7u)) << "one record per operation";
+
+    const auto self
+        = reinterpret_cast<std::uintptr_t> (list.links_pointer ());
+    const auto peer
+        = reinterpret_cast<std::uintptr_t> (other.links_pointer ());
+    const struct
+    {
+      list_tracer::operation op;
+      std::uintptr_t peer;
+    } expected[] = { { list_tracer::operation::link_range, self },
+                     { list_tracer::operation::reverse, 0 },
+                     { list_tracer::operation::take_all, peer },
+                     { list_tracer::operation::exchange, peer },
+                     { list_tracer::operation::remove_if, 0 },
+                     { list_tracer::operation::partition, peer },
+                     { list_tracer::operation::splice, peer } };
+    bool ok = true;
+    for (std::size_t i = 0; i < std::size (expected); ++i)
+      {
+        const auto r = trace_record (i);
+        ok = ok && (r.op == static_cast<std::uint32_t> (expected[i].op))
+             && (r.node == self) && (r.peer == expected[i].peer);
+      }
+    expect (ok) << "operations, lists";
+
+    list.clear ();
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Dump while writing", [] {
+    list_tracer::reset ();
+
+    double_list_links head;
+    double_list_links node;
+    std::atomic<bool> done{ false };
+    std::thread writer{ [&] {
+      for (std::size_t i = 0; i < 20 * list_tracer::ring_size; ++i)
+        {
+          head.link_next (&node);
+          node.unlink ();
+        }
+      done.store (true, std::memory_order_release);
+    } };
+
+    const auto addr = reinterpret_cast<std::uintptr_t> (&node);
+    bool ok = true;
+    while (!done.load (std::memory_order_acquire))
+      {
+        dump_trace ();
+
+        list_tracer::dump_header header;
+        std::memcpy (&header, trace_buffer, sizeof (header));
+        for (std::size_t i = 0; i < header.records; ++i)
+          {
+            // Complete records, or marked as incomplete.
+            const auto r = trace_record (i);
+            ok = ok && ((r.op == 0 && r.node == 0) || r.node == addr);
+          }
+      }
+    writer.join ();
+    expect (ok) << "no torn records";
+  });
+
+  test_case ("Per thread rings", [] {
+    list_tracer::reset ();
+
+    double_list_links nodes[2];
+    auto worker = [&] (std::size_t index) {
+      double_list_links head;
+      for (int i = 0; i < 10; ++i)
+        {
+          head.link_next (&nodes[index]);
+          nodes[index].unlink ();
+        }
+    };
+
+    std::thread threads[] = { std::thread{ worker, 0 },
+                              std::thread{ worker, 1 } };
+    for (auto& thread : threads)
+      {
+        thread.join ();
+      }
+    dump_trace ();
+
+    list_tracer::dump_header header;
+    std::memcpy (&header, trace_buffer, sizeof (header));
+    expect (eq (header.records, 40u)) << "all recorded";
+
+    // The records of each thread are in a single ring.
+    std::uint32_t rings[2] = { ~0u, ~0u };
+    bool consistent = true;
+    for (std::size_t i = 0; i < header.records; ++i)
+      {
+        const auto r = trace_record (i);
+        for (std::size_t t = 0; t < 2; ++t)
+          {
+            if (r.node == reinterpret_cast<std::uintptr_t> (&nodes[t]))
+              {
+                consistent = consistent
+                             && (rings[t] == ~0u || rings[t] == r.ring);
+                rings[t] = r.ring;
+              }
+          }
+      }
+    expect (consistent) << "one ring per thread";
+    expect (rings[0] != rings[1]) << "different rings";
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_list_tracer
+    = { "List tracer", check_list_tracer };
+
+#endif // defined(MICRO_OS_PLUS_TRACE_UTILS_LISTS_BINARY)
+
+// ----------------------------------------------------------------------------
+
+class stats_item
+{
+public:
+  stats_item (int id) : id_{ id }
+  {
+  }
+
+  int id_;
+
+  utils::timestamped_double_list_links links_;
+};
+
+template <>
+struct micro_os_plus::utils::is_trivially_relocatable<stats_item>
+    : std::true_type
+{
+};
+
+// A clock advanced manually by the tests.
+struct manual_clock
+{
+  using rep = std::int64_t;
+  using period = std::ratio<1>;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<manual_clock>;
+  static constexpr bool is_steady = true;
+
+  static time_point
+  now (void)
+  {
+    return time_point{ duration{ ticks } };
+  }
+
+  static inline rep ticks = 0;
+};
+
+using stats_list
+    = utils::intrusive_list<stats_item, utils::timestamped_double_list_links,
+                            &stats_item::links_, utils::double_list_links,
+                            stats_item, utils::list_stats>;
+
+using residency_list = utils::intrusive_list<
+    stats_item, utils::timestamped_double_list_links, &stats_item::links_,
+    utils::double_list_links, stats_item,
+    utils::list_residency_stats<manual_clock, 8>>;
+
+using static_stats_list
+    = utils::intrusive_list<stats_item, utils::timestamped_double_list_links,
+                            &stats_item::links_,
+                            utils::static_double_list_links, stats_item,
+                            utils::list_stats>;
+
+extern static_stats_list early_stats_list;
+
+// Defined before the list, so its constructor runs first, like
+// the static constructors in other translation units.
+struct early_stats_user
+{
+  early_stats_user ()
+  {
+    early_stats_list.initialize_once ();
+    early_stats_list.link_tail (item_);
+  }
+
+  stats_item item_{ 1 };
+};
+
+static early_stats_user early_user;
+
+static_stats_list early_stats_list;
+
+void
+check_list_stats (void);
+
+void
+check_list_stats (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Disabled", [] {
+    expect (eq (sizeof (double_list<double_list_links>),
+                sizeof (double_list_links)))
+        << "no extra space in double lists";
+    expect (eq (sizeof (utils::intrusive_list<member, double_list_links,
+                                              &member::all_links_>),
+                sizeof (double_list_links)))
+        << "no extra space in intrusive lists";
+  });
+
+  test_case ("Counters", [] {
+    stats_item a{ 1 }, b{ 2 }, c{ 3 }, d{ 4 };
+    stats_list list;
+
+    list.link_tail (a);
+    list.link_tail (b);
+    list.link_tail (c);
+    list.link_head (d);
+    expect (eq (list.stats ().links (), 4u)) << "4 links";
+    expect (eq (list.stats ().length (), 4u)) << "length 4";
+
+    list.unlink (b);
+    list.unlink_head ();
+    expect (eq (list.stats ().unlinks (), 2u)) << "2 unlinks";
+    expect (eq (list.stats ().length (), 2u)) << "length 2";
+
+    list.unlink (b);
+    expect (eq (list.stats ().unlinks (), 2u)) << "second unlink ignored";
+    expect (eq (list.stats ().length (), 2u)) << "length still 2";
+
+    int sum = 0;
+    for (auto& item : list)
+      {
+        sum += item.id_;
+      }
+    expect (eq (sum, 4)) << "a and c left";
+    expect (eq (list.stats ().iterations (), 1u)) << "1 iteration";
+
+    expect (eq (list.remove_if ([] (stats_item& item) {
+                  return item.id_ == 1;
+                }),
+                1u))
+        << "a removed";
+    expect (eq (list.stats ().length (), 1u)) << "length 1";
+
+    list.clear ();
+    expect (eq (list.stats ().length (), 0u)) << "cleared";
+    expect (eq (list.stats ().max_length (), 4u)) << "max length 4";
+
+    list.stats ().reset ();
+    expect (eq (list.stats ().links (), 0u)) << "no links after reset";
+    expect (eq (list.stats ().max_length (), 0u)) << "max length restarted";
+
+    c.links_.initialize ();
+  });
+
+  test_case ("Moves between lists", [] {
+    stats_item items[] = { 1, 2, 3, 4, 5 };
+    stats_list source;
+    stats_list destination;
+
+    for (auto& item : items)
+      {
+        source.link_tail (item);
+      }
+
+    source.take_all (destination);
+    expect (eq (source.stats ().length (), 0u)) << "source empty";
+    expect (eq (destination.stats ().length (), 5u)) << "all moved";
+
+    expect (eq (destination.partition (
+                    [] (stats_item& item) { return item.id_ % 2 == 0; },
+                    source),
+                2u))
+        << "2 even";
+    expect (eq (source.stats ().length (), 2u)) << "2 in source";
+    expect (eq (destination.stats ().length (), 3u)) << "3 in destination";
+
+    null_lock lock;
+    destination.take_all (source, lock);
+    expect (eq (destination.stats ().length (), 0u)) << "taken with lock";
+    expect (eq (destination.stats ().unlinks (), 5u)) << "unlinks from length";
+    expect (eq (source.stats ().length (), 5u)) << "counted after unlock";
+    source.partition ([] (stats_item& item) { return item.id_ % 2 != 0; },
+                      destination);
+
+    source.stats ().reset ();
+    source.exchange (destination);
+    expect (eq (source.stats ().length (), 3u)) << "exchanged source";
+    expect (eq (destination.stats ().length (), 2u))
+        << "exchanged destination";
+    expect (eq (source.stats ().max_length (), 3u))
+        << "exchange does not inflate the maximum";
+
+    destination.splice (destination.end (), source, source.begin (),
+                        source.end ());
+    expect (eq (source.stats ().length (), 0u)) << "spliced out";
+    expect (eq (destination.stats ().length (), 5u)) << "spliced in";
+
+    std::size_t count = 0;
+    destination.drain_if ([] (stats_item&) { return true; },
+                          [&count] (stats_item&) { ++count; });
+    expect (eq (count, 5u)) << "all drained";
+    expect (eq (destination.stats ().length (), 0u)) << "drained";
+    expect (eq (destination.stats ().unlinks (), 13u)) << "unlinks counted";
+  });
+
+  test_case ("Registry", [] {
+    auto find = [] (const char* name) {
+      bool found = false;
+      list_stats::for_each ([&] (const list_stats& stats) {
+        found = found
+                || (stats.name () != nullptr
+                    && std::strcmp (stats.name (), name) == 0);
+      });
+      return found;
+    };
+
+    {
+      stats_item a{ 1 };
+      stats_list list;
+      list.stats ().name ("registered");
+      list.link_tail (a);
+
+      expect (find ("registered")) << "registered while alive";
+
+      std::size_t length = 0;
+      list_stats::for_each ([&] (const list_stats& stats) {
+        if (&stats == &list.stats ())
+          {
+            length = stats.length ();
+          }
+      });
+      expect (eq (length, 1u)) << "exported length";
+
+      // The registry lock is not the lock of the concurrent operations.
+      stats_item b{ 2 };
+      stats_list other;
+      list_stats::for_each ([&] (const list_stats& stats) {
+        if (&stats == &list.stats ())
+          {
+            other.link_tail_concurrent (b);
+          }
+      });
+      expect (eq (other.stats ().length (), 1u)) << "linked by the function";
+
+      other.unlink (b);
+      list.unlink (a);
+    }
+
+    expect (!find ("registered")) << "unregistered when destroyed";
+  });
+
+  test_case ("Residency", [] {
+    stats_item a{ 1 }, b{ 2 }, c{ 3 };
+    residency_list list;
+
+    manual_clock::ticks = 100;
+    list.link_tail (a);
+    list.link_tail (b);
+    list.link_tail (c);
+
+    manual_clock::ticks = 105;
+    list.unlink (a);
+    expect (eq (list.stats ().residency (3), 1u)) << "5 ticks in bucket 3";
+
+    manual_clock::ticks = 105 + (1 << 20);
+    list.unlink (b);
+    expect (eq (list.stats ().residency (7), 1u)) << "long in last bucket";
+
+    list.unlink (c);
+    list.link_tail (c);
+    list.unlink (c);
+    expect (eq (list.stats ().residency (0), 1u)) << "same tick in bucket 0";
+
+    list.stats ().reset ();
+    expect (eq (list.stats ().residency (7), 0u)) << "histogram reset";
+  });
+
+  test_case ("Compact", [] {
+    stats_item items[] = { 1, 2, 3 };
+    node_pool<stats_item, timestamped_double_list_links, &stats_item::links_,
+              3>
+        pool;
+    stats_list list;
+
+    for (auto& item : items)
+      {
+        list.link_tail (item);
+      }
+
+    expect (eq (compact (list, pool, [] (stats_item*) {}), 3u))
+        << "all relocated";
+    expect (eq (list.stats ().length (), 3u)) << "length unchanged";
+    expect (eq (list.stats ().unlinks (), 0u)) << "nothing unlinked";
+    expect (pool.owns (&(*list.begin ()))) << "moved to the pool";
+
+    list.clear ();
+  });
+
+  test_case ("Static lists", [] {
+    expect (eq (early_stats_list.stats ().links (), 1u))
+        << "link before the constructor counted";
+    expect (eq (early_stats_list.stats ().length (), 1u))
+        << "length kept by the constructor";
+
+    early_stats_list.unlink (early_user.item_);
+    expect (eq (early_stats_list.stats ().length (), 0u)) << "length 0";
+    expect (eq (early_stats_list.stats ().unlinks (), 1u)) << "1 unlink";
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_list_stats
+    = { "List statistics", check_list_stats };
+
+// ----------------------------------------------------------------------------
+
+static const utils::double_list_links_base* corrupted_node;
+static std::size_t corrupted_count;
+
+void
+check_list_integrity (void);
+
+void
+check_list_integrity (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Consistent nodes", [] {
+    double_list_links a;
+    expect (a.consistent ()) << "unlinked node";
+
+    double_list<double_list_links> list;
+    double_list_links b, c;
+    list.link_tail (a);
+    list.link_tail (b);
+    list.link_tail (c);
+    expect (a.consistent () && b.consistent () && c.consistent ())
+        << "linked nodes";
+
+    b.previous (&c);
+    expect (!b.consistent ()) << "corrupted previous";
+    expect (!a.consistent ()) << "neighbour of the corrupted node";
+    b.previous (&a);
+    expect (b.consistent ()) << "restored";
+
+    list.clear ();
+  });
+
+  test_case ("Validate", [] {
+    double_list<double_list_links> list;
+    expect (list.validate (0)) << "empty";
+
+    double_list_links a, b, c;
+    list.link_tail (a);
+    list.link_tail (b);
+    list.link_tail (c);
+    expect (list.validate ()) << "valid";
+    expect (list.validate (3)) << "expected size";
+    expect (!list.validate (2)) << "different size";
+
+    b.previous (&c);
+    expect (!list.validate ()) << "asymmetric links";
+    b.previous (&a);
+
+    // A cycle not passing through the list links.
+    double_list_links_base* saved = c.next ();
+    c.next (&a);
+    expect (!list.validate ()) << "cycle detected";
+    c.next (saved);
+    expect (list.validate (3)) << "restored";
+
+    list.clear ();
+
+    static double_list<double_list_links, static_double_list_links> registry;
+    expect (registry.validate (0)) << "uninitialised static list";
+  });
+
+  test_case ("Handler", [] {
+    corrupted_node = nullptr;
+    corrupted_count = 0;
+    list_integrity::set_handler ([] (const double_list_links_base* node) {
+      corrupted_node = node;
+      ++corrupted_count;
+    });
+
+    double_list<double_list_links> list;
+    double_list_links a, b;
+    list.link_tail (a);
+    list.link_tail (b);
+    expect (list_integrity::check (&a)) << "consistent node";
+
+    a.next (&a);
+    expect (!list_integrity::check (&a)) << "corrupted node";
+    expect (corrupted_node == &a) << "handler called with the node";
+    expect (eq (corrupted_count, 1u)) << "handler called once";
+    a.next (&b);
+
+    list.clear ();
+    list_integrity::set_handler (nullptr);
+  });
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+  test_case ("Sampled checks", [] {
+    corrupted_count = 0;
+    list_integrity::set_handler (
+        [] (const double_list_links_base*) { ++corrupted_count; });
+
+    double_list_links x, y;
+    for (std::uint32_t i = 0; i < list_integrity::sampling; ++i)
+      {
+        // The neighbour does not point back to the node.
+        x.next (&y);
+        y.previous (&y);
+        x.unlink ();
+      }
+    expect (eq (corrupted_count, 1u)) << "one of the operations checked";
+
+    x.initialize ();
+    y.initialize ();
+    list_integrity::set_handler (nullptr);
+  });
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_CHECK_SAMPLING)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_list_integrity
+    = { "List integrity", check_list_integrity };
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+
+using static_member_list
+    = utils::intrusive_list<member, utils::double_list_links,
+                            &member::all_links_,
+                            utils::static_double_list_links>;
+
+// Statically allocated, in BSS.
+static static_member_list concurrent_registry;
+
+void
+check_concurrent_registration (void);
+
+void
+check_concurrent_registration (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Concurrent initialize once", [] {
+    constexpr int threads_count = 4;
+    static_double_list_links links;
+
+    bool ok = true;
+    for (int round = 0; round < 200; ++round)
+      {
+        links.nullify ();
+        std::atomic<bool> go{ false };
+
+        std::thread threads[threads_count];
+        for (auto& t : threads)
+          {
+            t = std::thread{ [&] {
+              while (!go.load (std::memory_order_acquire))
+                {
+                }
+              links.initialize_once ();
+            } };
+          }
+        go.store (true, std::memory_order_release);
+        for (auto& t : threads)
+          {
+            t.join ();
+          }
+
+        ok = ok && (links.next () == &links)
+             && (links.previous () == &links);
+      }
+    expect (ok) << "initialised exactly to empty";
+  });
+
+  test_case ("Empty during initialize once", [] {
+    constexpr int threads_count = 4;
+    static double_list<double_list_links, static_double_list_links> list;
+
+    std::atomic<bool> ok{ true };
+    for (int round = 0; round < 200; ++round)
+      {
+        const_cast<static_double_list_links*> (list.links_pointer ())
+            ->nullify ();
+        std::atomic<bool> go{ false };
+
+        std::thread threads[threads_count];
+        for (int t = 0; t < threads_count; ++t)
+          {
+            threads[t] = std::thread{ [&, t] {
+              while (!go.load (std::memory_order_acquire))
+                {
+                }
+              if (t % 2 == 0)
+                {
+                  list.initialize_once ();
+                  return;
+                }
+              for (int i = 0; i < 100; ++i)
+                {
+                  if (!list.empty ())
+                    {
+                      ok.store (false, std::memory_order_relaxed);
+                    }
+                }
+            } };
+          }
+        go.store (true, std::memory_order_release);
+        for (auto& t : threads)
+          {
+            t.join ();
+          }
+      }
+    expect (ok.load ()) << "empty while being initialised";
+  });
+
+  test_case ("Concurrent link tail", [] {
+    constexpr int threads_count = 4;
+    constexpr int members_count = 64;
+
+    static member* members[threads_count][members_count];
+    for (int t = 0; t < threads_count; ++t)
+      {
+        for (int i = 0; i < members_count; ++i)
+          {
+            members[t][i] = new member{ t * members_count + i };
+          }
+      }
+
+    bool ok = true;
+    for (int round = 0; round < 50; ++round)
+      {
+        // Back to the BSS state, as before the static constructors.
+        const_cast<static_double_list_links*> (
+            concurrent_registry.links_pointer ())
+            ->nullify ();
+        for (auto& row : members)
+          {
+            for (member* m : row)
+              {
+                m->all_links_.initialize ();
+              }
+          }
+
+        std::atomic<bool> go{ false };
+        std::thread threads[threads_count];
+        for (int t = 0; t < threads_count; ++t)
+          {
+            threads[t] = std::thread{ [&go, t] {
+              while (!go.load (std::memory_order_acquire))
+                {
+                }
+              for (member* m : members[t])
+                {
+                  concurrent_registry.link_tail_concurrent (*m);
+                }
+            } };
+          }
+        go.store (true, std::memory_order_release);
+        for (auto& t : threads)
+          {
+            t.join ();
+          }
+
+        int sum = 0;
+        int forward = 0;
+        for (member& m : concurrent_registry)
+          {
+            sum += m.id_;
+            ++forward;
+          }
+        const int backward = static_cast<int> (std::ranges::distance (
+            concurrent_registry.rbegin (), concurrent_registry.rend ()));
+
+        constexpr int total = threads_count * members_count;
+        ok = ok && (forward == total) && (backward == total)
+             && (sum == total * (total - 1) / 2);
+      }
+    expect (ok) << "all registered, links consistent";
+
+    for (auto& row : members)
+      {
+        for (member* m : row)
+          {
+            delete m;
+          }
+      }
+  });
+
+  test_case ("Link tail with initialize once", [] {
+    constexpr int threads_count = 4;
+    constexpr int members_count = 64;
+
+    static member* members[threads_count][members_count];
+    for (int t = 0; t < threads_count; ++t)
+      {
+        for (int i = 0; i < members_count; ++i)
+          {
+            members[t][i] = new member{ t * members_count + i };
+          }
+      }
+
+    bool ok = true;
+    for (int round = 0; round < 50; ++round)
+      {
+        const_cast<static_double_list_links*> (
+            concurrent_registry.links_pointer ())
+            ->nullify ();
+        for (auto& row : members)
+          {
+            for (member* m : row)
+              {
+                m->all_links_.initialize ();
+              }
+          }
+
+        // Half of the threads register, half only initialise.
+        std::atomic<bool> go{ false };
+        std::thread threads[threads_count];
+        for (int t = 0; t < threads_count; ++t)
+          {
+            threads[t] = std::thread{ [&go, t] {
+              while (!go.load (std::memory_order_acquire))
+                {
+                }
+              for (member* m : members[t])
+                {
+                  if (t % 2 == 0)
+                    {
+                      concurrent_registry.link_tail_concurrent (*m);
+                    }
+                  else
+                    {
+                      concurrent_registry.initialize_once ();
+                    }
+                }
+            } };
+          }
+        go.store (true, std::memory_order_release);
+        for (auto& t : threads)
+          {
+            t.join ();
+          }
+
+        int forward = 0;
+        for (member& m : concurrent_registry)
+          {
+            ok = ok && (m.id_ / members_count) % 2 == 0;
+            ++forward;
+          }
+        const int backward = static_cast<int> (std::ranges::distance (
+            concurrent_registry.rbegin (), concurrent_registry.rend ()));
+
+        constexpr int total = (threads_count / 2) * members_count;
+        ok = ok && (forward == total) && (backward == total);
+      }
+    expect (ok) << "all registered, links consistent";
+
+    for (auto& row : members)
+      {
+        for (member* m : row)
+          {
+            delete m;
+          }
+      }
+  });
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_concurrent_registration
+    = { "Concurrent registration", check_concurrent_registration };
+
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+using rcu_member_list
+    = utils::rcu_intrusive_list<member, utils::double_list_links,
+                                &member::all_links_>;
+
+void
+check_rcu (void);
+
+void
+check_rcu (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Link and unlink", [] {
+    rcu_domain domain;
+    rcu_member_list list{ domain };
+    expect (list.empty ()) << "list empty";
+
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    list.link_tail (m2);
+    list.link_tail (m3);
+    list.link_head (m1);
+
+    int ids[3] = {};
+    int count = 0;
+    {
+      rcu_reader reader{ domain };
+      reader.lock ();
+      for (auto& m : list)
+        {
+          ids[count++] = m.id_;
+        }
+      reader.unlock ();
+    }
+    expect (eq (count, 3)) << "3 elements";
+    expect (ids[0] == 1 && ids[1] == 2 && ids[2] == 3) << "in order";
+
+    list.unlink_synchronize (m2);
+    expect (!m2.all_links_.linked ()) << "m2 reusable";
+    expect (eq (std::ranges::distance (list.begin (), list.end ()), 2))
+        << "2 elements";
+
+    // A reader positioned on an unlinked element continues.
+    rcu_reader reader{ domain };
+    reader.lock ();
+    auto it = list.begin ();
+    list.unlink (m1);
+    ++it;
+    expect (eq (it->id_, 3)) << "continues after unlinked";
+    reader.unlock ();
+
+    domain.synchronize ();
+    rcu_member_list::reinitialize (m1);
+    list.unlink_synchronize (m3);
+    expect (list.empty ()) << "list empty";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent readers", [] {
+    constexpr int readers_count = 3;
+    constexpr int members_count = 16;
+
+    rcu_domain domain;
+    rcu_member_list list{ domain };
+
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        list.link_tail (*members[i]);
+      }
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> poisoned{ 0 };
+
+    std::thread readers[readers_count];
+    for (auto& t : readers)
+      {
+        t = std::thread{ [&] {
+          rcu_reader reader{ domain };
+          while (!done.load (std::memory_order_acquire))
+            {
+              std::scoped_lock lock{ reader };
+              for (auto& m : list)
+                {
+                  if (std::atomic_ref<int>{ m.id_ }.load (
+                          std::memory_order_relaxed)
+                      < 0)
+                    {
+                      poisoned.fetch_add (1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        } };
+      }
+
+    for (int round = 0; round < 2000; ++round)
+      {
+        member* m = members[round % members_count];
+        list.unlink_synchronize (*m);
+
+        // No reader can see the element now.
+        std::atomic_ref<int>{ m->id_ }.store (-1, std::memory_order_relaxed);
+        std::atomic_ref<int>{ m->id_ }.store (round % members_count,
+                                               std::memory_order_relaxed);
+
+        if (round % 2)
+          {
+            list.link_tail (*m);
+          }
+        else
+          {
+            list.link_head (*m);
+          }
+      }
+
+    done.store (true, std::memory_order_release);
+    for (auto& t : readers)
+      {
+        t.join ();
+      }
+
+    expect (eq (poisoned.load (), 0)) << "no reclaimed element seen";
+    expect (eq (std::ranges::distance (list.begin (), list.end ()),
+                members_count))
+        << "all elements linked";
+
+    for (member* m : members)
+      {
+        list.unlink_synchronize (*m);
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_rcu
+    = { "RCU lists", check_rcu };
+
+// ----------------------------------------------------------------------------
+
+// Poison the reclaimed members and keep them for reuse.
+struct member_recycler
+{
+  void
+  operator() (member& m)
+  {
+    std::atomic_ref<int>{ m.id_ }.store (-1, std::memory_order_relaxed);
+    m.all_links_.initialize ();
+    free_[count_++] = &m;
+  }
+
+  member** free_;
+  std::size_t count_;
+};
+
+using member_retire_list
+    = utils::retire_list<member, utils::double_list_links,
+                         &member::odd_links_, member_recycler&>;
+
+void
+check_retire_list (void);
+
+void
+check_retire_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Batches", [] {
+    rcu_domain domain;
+    rcu_member_list list{ domain };
+
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    list.link_tail (m1);
+    list.link_tail (m2);
+    list.link_tail (m3);
+
+    member* free[3] = {};
+    member_recycler recycler{ free, 0 };
+    member_retire_list retired{ domain, 10, recycler };
+
+    list.unlink (m1);
+    retired.retire (m1);
+    list.unlink (m2);
+    retired.retire (m2);
+    expect (eq (retired.pending (), 2u)) << "2 pending";
+
+    rcu_reader reader{ domain };
+    reader.lock ();
+    expect (eq (retired.reclaim (), 0u)) << "batch sealed";
+    expect (eq (retired.reclaim (), 0u)) << "reader still active";
+    reader.unlock ();
+
+    expect (eq (retired.reclaim (), 2u)) << "batch disposed";
+    expect (eq (recycler.count_, 2u)) << "2 recycled";
+    expect (eq (m1.id_, -1)) << "m1 disposed";
+
+    list.unlink (m3);
+    retired.retire (m3);
+    expect (eq (retired.flush (), 1u)) << "flushed";
+    expect (eq (retired.pending (), 0u)) << "nothing pending";
+    expect (list.empty ()) << "list empty";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Bounded memory", [] {
+    constexpr int readers_count = 3;
+    constexpr int members_count = 32;
+    constexpr std::size_t threshold = 8;
+
+    rcu_domain domain;
+    rcu_member_list list{ domain };
+
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        list.link_tail (*members[i]);
+      }
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> poisoned{ 0 };
+
+    std::thread readers[readers_count];
+    for (auto& t : readers)
+      {
+        t = std::thread{ [&] {
+          rcu_reader reader{ domain };
+          while (!done.load (std::memory_order_acquire))
+            {
+              std::scoped_lock lock{ reader };
+              for (auto& m : list)
+                {
+                  if (std::atomic_ref<int>{ m.id_ }.load (
+                          std::memory_order_relaxed)
+                      < 0)
+                    {
+                      poisoned.fetch_add (1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        } };
+      }
+
+    static member* free[members_count];
+    member_recycler recycler{ free, 0 };
+    bool bounded = true;
+    {
+      member_retire_list retired{ domain, threshold, recycler };
+
+      for (int round = 0; round < 5000; ++round)
+        {
+          if (recycler.count_ > 0)
+            {
+              // Reuse a reclaimed member.
+              member* m = free[--recycler.count_];
+              std::atomic_ref<int>{ m->id_ }.store (
+                  round, std::memory_order_relaxed);
+              list.link_tail (*m);
+            }
+
+          member& m = *list.begin ();
+          list.unlink (m);
+          retired.retire (m);
+          bounded = bounded && (retired.pending () < threshold);
+        }
+    }
+
+    done.store (true, std::memory_order_release);
+    for (auto& t : readers)
+      {
+        t.join ();
+      }
+
+    expect (bounded) << "pending below threshold";
+    expect (eq (poisoned.load (), 0)) << "no disposed element seen";
+    expect (eq (static_cast<int> (recycler.count_)
+                    + static_cast<int> (std::ranges::distance (
+                        list.begin (), list.end ())),
+                members_count))
+        << "all elements accounted";
+
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_retire_list
+    = { "Retire lists", check_retire_list };
+
+// ----------------------------------------------------------------------------
+
+#if defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+using member_stack = utils::intrusive_stack<member, utils::double_list_links,
+                                            &member::all_links_>;
+
+void
+check_intrusive_stack (void);
+
+void
+check_intrusive_stack (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Push and pop", [] {
+    member_stack stack;
+    expect (stack.empty ()) << "stack empty";
+    expect (stack.pop () == nullptr) << "nothing to pop";
+
+    member m1{ 1 };
+    member m2{ 2 };
+    member m3{ 3 };
+    stack.push (m1);
+    stack.push (m2);
+    stack.push (m3);
+    expect (!stack.empty ()) << "stack not empty";
+
+    expect (eq (stack.pop ()->id_, 3)) << "LIFO";
+    stack.push (m3);
+
+    auto chain = stack.pop_all ();
+    expect (stack.empty ()) << "stack empty after pop all";
+    expect (eq (chain.front ()->id_, 3)) << "chain from the top";
+
+    intrusive_list<member, double_list_links, &member::all_links_> list;
+    list.link_tail_range (chain);
+    int ids[3] = {};
+    int count = 0;
+    for (auto& m : list)
+      {
+        ids[count++] = m.id_;
+      }
+    expect (eq (count, 3)) << "3 elements spliced";
+    expect (ids[0] == 3 && ids[1] == 2 && ids[2] == 1) << "in stack order";
+    expect (eq (list.rbegin ()->id_, 1)) << "links consistent";
+
+    list.clear ();
+    expect (member_stack::chain{}.empty ()) << "empty chain";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent push and pop", [] {
+    constexpr int threads_count = 4;
+    constexpr int members_count = 64;
+
+    member_stack stack;
+    static member* members[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        stack.push (*members[i]);
+      }
+
+    std::atomic<bool> go{ false };
+    std::atomic<int> lost{ 0 };
+
+    std::thread threads[threads_count];
+    for (auto& t : threads)
+      {
+        t = std::thread{ [&] {
+          while (!go.load (std::memory_order_acquire))
+            {
+            }
+          member* held[4];
+          for (int round = 0; round < 20000; ++round)
+            {
+              // Pop several, to mix the order and provoke ABA.
+              int count = 0;
+              for (auto& h : held)
+                {
+                  h = stack.pop ();
+                  if (h != nullptr)
+                    {
+                      ++count;
+                    }
+                }
+              if (count == 0)
+                {
+                  lost.fetch_add (1, std::memory_order_relaxed);
+                }
+              for (member* h : held)
+                {
+                  if (h != nullptr)
+                    {
+                      stack.push (*h);
+                    }
+                }
+            }
+        } };
+      }
+    go.store (true, std::memory_order_release);
+    for (auto& t : threads)
+      {
+        t.join ();
+      }
+
+    int count = 0;
+    int sum = 0;
+    for (auto& m : stack.pop_all ())
+      {
+        ++count;
+        sum += m.id_;
+      }
+
+    expect (eq (lost.load (), 0)) << "never found empty";
+    expect (eq (count, members_count)) << "all elements back";
+    expect (eq (sum, members_count * (members_count - 1) / 2))
+        << "each element once";
+
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_intrusive_stack
+    = { "Intrusive stacks", check_intrusive_stack };
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_INTRUSIVE_STACK)
+
+// ----------------------------------------------------------------------------
+
+using member_deque
+    = micro_os_plus::utils::work_stealing_deque<member,
+                                                micro_os_plus::utils::
+                                                    double_list_links,
+                                                &member::all_links_, 4>;
+
+void
+check_work_stealing_deque (void);
+
+void
+check_work_stealing_deque (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Push, pop and steal", [] {
+    member_deque deque;
+    expect (deque.empty ()) << "deque empty";
+    expect (deque.pop () == nullptr) << "nothing to pop";
+    expect (deque.steal () == nullptr) << "nothing to steal";
+    expect (eq (deque.capacity (), 4u)) << "embedded ring";
+
+    member members[10]{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    for (auto& m : members)
+      {
+        expect (deque.push (m)) << "pushed";
+      }
+    expect (eq (deque.size (), 10u)) << "10 elements";
+    expect (eq (deque.capacity (), 16u)) << "grown twice";
+
+    expect (eq (deque.pop ()->id_, 9)) << "owner LIFO";
+    expect (eq (deque.steal ()->id_, 0)) << "thief FIFO";
+    expect (eq (deque.steal ()->id_, 1)) << "thief FIFO";
+
+    intrusive_list<member, double_list_links, &member::all_links_> list;
+    expect (eq (deque.drain_into (list), 7u)) << "7 drained";
+    expect (deque.empty ()) << "deque empty after drain";
+    expect (eq (list.begin ()->id_, 2)) << "oldest first";
+    expect (eq (list.rbegin ()->id_, 8)) << "newest last";
+    list.clear ();
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent owner and thieves", [] {
+    constexpr int thieves_count = 3;
+    constexpr int members_count = 1000;
+
+    member_deque deque;
+    static member* members[members_count];
+    static std::atomic<int> taken[members_count];
+    for (int i = 0; i < members_count; ++i)
+      {
+        members[i] = new member{ i };
+        taken[i].store (0, std::memory_order_relaxed);
+      }
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> stolen{ 0 };
+
+    std::thread thieves[thieves_count];
+    for (auto& t : thieves)
+      {
+        t = std::thread{ [&] {
+          while (!done.load (std::memory_order_acquire) || !deque.empty ())
+            {
+              member* m = deque.steal ();
+              if (m != nullptr)
+                {
+                  taken[m->id_].fetch_add (1, std::memory_order_relaxed);
+                  stolen.fetch_add (1, std::memory_order_relaxed);
+                }
+            }
+        } };
+      }
+
+    // The owner pushes in bursts and pops part of them back,
+    // racing with the thieves for the last elements.
+    bool pushed = true;
+    for (int i = 0; i < members_count; ++i)
+      {
+        pushed = deque.push (*members[i]) && pushed;
+        if (i % 3 == 2)
+          {
+            for (int j = 0; j < 2; ++j)
+              {
+                member* m = deque.pop ();
+                if (m != nullptr)
+                  {
+                    taken[m->id_].fetch_add (1, std::memory_order_relaxed);
+                  }
+              }
+          }
+      }
+    done.store (true, std::memory_order_release);
+    for (auto& t : thieves)
+      {
+        t.join ();
+      }
+
+    int once = 0;
+    for (auto& t : taken)
+      {
+        if (t.load (std::memory_order_relaxed) == 1)
+          {
+            ++once;
+          }
+      }
+
+    expect (pushed) << "all pushed";
+    expect (eq (once, members_count)) << "each element taken once";
+    expect (stolen.load () > 0) << "some stolen";
+
+    for (member* m : members)
+      {
+        delete m;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_work_stealing_deque
+    = { "Work-stealing deques", check_work_stealing_deque };
+
+// ----------------------------------------------------------------------------
+
+class session
+{
+public:
+  session (int key) : key_{ key }
+  {
+  }
+
+  int key_;
+  utils::ordered_list_links table_links_;
+  utils::double_list_links retire_links_;
+  std::atomic<bool> available_{ true };
+};
+
+static bool
+operator< (const session& a, const session& b)
+{
+  return a.key_ < b.key_;
+}
+
+static bool
+operator< (const session& a, int key)
+{
+  return a.key_ < key;
+}
+
+static bool
+operator< (int key, const session& b)
+{
+  return key < b.key_;
+}
+
+using session_table
+    = utils::ordered_intrusive_list<session, utils::ordered_list_links,
+                                    &session::table_links_>;
+
+class session_recycler
+{
+public:
+  void
+  operator() (session& s)
+  {
+    s.table_links_.initialize ();
+    s.available_.store (true, std::memory_order_release);
+  }
+};
+
+using session_retire_list
+    = utils::retire_list<session, utils::double_list_links,
+                         &session::retire_links_, session_recycler>;
+
+void
+check_ordered_list (void);
+
+void
+check_ordered_list (void)
+{
+  using namespace micro_os_plus::micro_test_plus;
+  using namespace micro_os_plus::utils;
+
+  test_case ("Insert, find and erase", [] {
+    session_table table;
+    expect (table.empty ()) << "table empty";
+    expect (!table.contains (1)) << "nothing found";
+    expect (table.erase (1) == nullptr) << "nothing erased";
+
+    session s1{ 1 };
+    session s3{ 3 };
+    session s5{ 5 };
+    session other5{ 5 };
+    expect (table.insert (s3)) << "s3 inserted";
+    expect (table.insert (s1)) << "s1 inserted";
+    expect (table.insert (s5)) << "s5 inserted";
+    expect (!table.insert (other5)) << "duplicate rejected";
+    expect (!table.empty ()) << "table not empty";
+
+    int keys[3] = {};
+    int count = 0;
+    table.for_each ([&] (session& s) { keys[count++] = s.key_; });
+    expect (eq (count, 3)) << "3 elements";
+    expect (keys[0] == 1 && keys[1] == 3 && keys[2] == 5) << "ordered";
+
+    expect (table.find (3) == &s3) << "s3 found";
+    expect (!table.contains (4)) << "4 not found";
+
+    expect (table.erase (3) == &s3) << "s3 erased";
+    expect (s3.table_links_.marked ()) << "s3 marked";
+    expect (!table.contains (3)) << "s3 not found";
+    expect (table.erase (3) == nullptr) << "s3 already erased";
+
+    s3.table_links_.initialize ();
+    expect (table.insert (s3)) << "s3 reinserted";
+    expect (table.contains (3)) << "s3 found again";
+
+    rcu_domain domain;
+    session_retire_list retired{ domain, 10 };
+    expect (table.erase (3, retired)) << "s3 erased and retired";
+    expect (eq (retired.pending (), 1u)) << "s3 pending";
+    expect (eq (retired.flush (), 1u)) << "s3 recycled";
+    expect (s3.available_.load ()) << "s3 available";
+  });
+
+#if defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+  test_case ("Concurrent insert and erase", [] {
+    constexpr int threads_count = 4;
+    constexpr int keys_count = 32;
+
+    rcu_domain domain;
+    session_table table;
+
+    static session* sessions[keys_count];
+    static std::atomic<int> balance[keys_count];
+    for (int i = 0; i < keys_count; ++i)
+      {
+        sessions[i] = new session{ i };
+        balance[i].store (0, std::memory_order_relaxed);
+      }
+
+    std::atomic<bool> go{ false };
+    std::atomic<int> failures{ 0 };
+
+    std::thread threads[threads_count];
+    for (int t = 0; t < threads_count; ++t)
+      {
+        threads[t] = std::thread{ [&, t] {
+          rcu_reader reader{ domain };
+          session_retire_list retired{ domain, 8 };
+          unsigned seed = static_cast<unsigned> (t) * 7919u + 1;
+          session* erased = nullptr;
+
+          while (!go.load (std::memory_order_acquire))
+            {
+            }
+          for (int round = 0; round < 5000; ++round)
+            {
+              seed = seed * 1103515245u + 12345u;
+              const int key = static_cast<int> ((seed >> 16) % keys_count);
+
+              reader.lock ();
+              if ((seed & 0x100) != 0)
+                {
+                  bool expected = true;
+                  if (sessions[key]->available_.compare_exchange_strong (
+                          expected, false, std::memory_order_acq_rel))
+                    {
+                      if (table.insert (*sessions[key]))
+                        {
+                          balance[key].fetch_add (1,
+                                                  std::memory_order_relaxed);
+                        }
+                      else
+                        {
+                          failures.fetch_add (1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+              else
+                {
+                  erased = table.erase (key);
+                  if (erased != nullptr)
+                    {
+                      balance[key].fetch_sub (1, std::memory_order_relaxed);
+                    }
+                }
+              reader.unlock ();
+
+              // Retiring may wait for the readers, including this one.
+              if (erased != nullptr)
+                {
+                  retired.retire (*erased);
+                  erased = nullptr;
+                }
+            }
+        } };
+      }
+    go.store (true, std::memory_order_release);
+    for (auto& t : threads)
+      {
+        t.join ();
+      }
+
+    int previous = -1;
+    bool ordered = true;
+    table.for_each ([&] (session& s) {
+      ordered = ordered && (previous < s.key_);
+      previous = s.key_;
+    });
+
+    int consistent = 0;
+    for (int i = 0; i < keys_count; ++i)
+      {
+        const int b = balance[i].load (std::memory_order_relaxed);
+        const bool present = table.contains (i);
+        if ((b == 1 && present && !sessions[i]->available_.load ())
+            || (b == 0 && !present && sessions[i]->available_.load ()))
+          {
+            ++consistent;
+          }
+      }
+
+    expect (eq (failures.load (), 0)) << "available sessions inserted";
+    expect (ordered) << "strictly ordered";
+    expect (eq (consistent, keys_count)) << "each key in a valid state";
+
+    for (int i = 0; i < keys_count; ++i)
+      {
+        table.erase (i);
+      }
+    expect (table.empty ()) << "table empty";
+
+    for (session* s : sessions)
+      {
+        delete s;
+      }
+  });
+#endif // defined(MICRO_OS_PLUS_PLATFORM_NATIVE)
+}
+
+static micro_os_plus::micro_test_plus::test_suite ts_ordered_list
+    = { "Ordered lists", check_ordered_list };
+
+#endif // defined(MICRO_OS_PLUS_UTILS_LISTS_HAS_ATOMIC_CAS)
+
+// ----------------------------------------------------------------------------